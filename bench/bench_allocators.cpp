@@ -0,0 +1,91 @@
+/**
+\file 
+\brief Benchmark of Vector allocators on a build-and-drop workload.
+ Every round ("request") builds many short-lived small vectors by push_back 
+ and drops them, the arena is reset once per round.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "smart_array.hpp"
+#include "arena_allocator.hpp"
+#include "pool_allocator.hpp"
+
+using tasks::Vector;
+
+///Number of vectors built per round.
+const int vectors_per_round = 10000;
+
+/**
+\brief Builds and drops the vectors of one round.
+\param alloc Allocator for the vectors.
+\return Checksum of the elements so the work is not optimized away.
+*/
+template <typename Alloc>
+long build_and_drop(const Alloc &alloc)
+{
+    long checksum = 0;
+
+    for (int i = 0; i < vectors_per_round; ++i) {
+        Vector<int, Alloc> vec(alloc);
+        int size = (i * 7) % 48;
+
+        for (int j = 0; j < size; ++j) {
+            vec.push_back(j);
+        }
+        checksum += vec.size();
+    }
+    return checksum;
+}
+
+/**
+\brief Returns nanoseconds per built vector for given number of rounds.
+\param rounds Number of rounds.
+\param round Function running one round.
+*/
+template <typename F>
+double ns_per_vector(int rounds, F round)
+{
+    long checksum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int r = 0; r < rounds; ++r) {
+        checksum += round();
+    }
+    std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+    if (checksum == 42) {
+        std::cout << ' ';
+    }
+    return d.count() / (double(rounds) * vectors_per_round);
+}
+
+/**
+\brief Runs the benchmark. Number of rounds may be given as argument.
+*/
+int main(int argc, char **argv)
+{
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 200;
+    tasks::Arena arena;
+
+    double std_ns = ns_per_vector(rounds, [] { 
+        return build_and_drop(std::allocator<int>()); 
+    });
+    double arena_ns = ns_per_vector(rounds, [&arena] { 
+        long checksum = build_and_drop(tasks::Arena_allocator<int>(arena)); 
+        arena.reset();
+        return checksum;
+    });
+    double pool_ns = ns_per_vector(rounds, [] { 
+        return build_and_drop(tasks::Pool_allocator<int>()); 
+    });
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(16) << "allocator" << std::setw(16) << "ns per vector" << std::endl
+              << std::setw(16) << "std::allocator" << std::setw(16) << std_ns << std::endl
+              << std::setw(16) << "Arena" << std::setw(16) << arena_ns << std::endl
+              << std::setw(16) << "Pool" << std::setw(16) << pool_ns << std::endl;
+    return 0;
+}
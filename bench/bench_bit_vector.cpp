@@ -0,0 +1,91 @@
+/**
+\file
+\brief Flag sets stored as Vector<bool> (a byte per flag) and as Bit_vector (a bit per flag).
+ Compares memory held, counting set flags and combining two sets with AND on every
+ instruction set the CPU supports.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "bit_vector.hpp"
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+
+///Sink for results.
+static volatile size_t sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+/**
+\brief Runs the benchmark. Number of flags and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 100000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    tasks::Vector<bool> bytes_left(size, false), bytes_right(size, false);
+    tasks::Bit_vector bits_left(size), bits_right(size);
+    for (size_t i = 0; i < size; ++i) {
+        bool left = i % 3 == 0, right = i % 5 < 2;
+        bytes_left[i] = left;
+        bytes_right[i] = right;
+        bits_left.set(i, left);
+        bits_right.set(i, right);
+    }
+    bool *left_ptr = &bytes_left[0];
+    const bool *right_ptr = &bytes_right[0];
+
+    double byte_count = best_time([&] {
+        size_t total = 0;
+        for (size_t i = 0; i < size; ++i) {
+            total += left_ptr[i];
+        }
+        sink = total;
+    }, repeats);
+    double byte_and = best_time([&] {
+        for (size_t i = 0; i < size; ++i) {
+            left_ptr[i] = left_ptr[i] & right_ptr[i];
+        }
+    }, repeats);
+
+    std::cout << size << " flags, memory MB: Vector<bool> " << bytes_left.capacity() * sizeof(bool) / 1e6
+              << ", Bit_vector " << bits_left.capacity() / 8 / 1e6 << std::endl
+              << std::fixed << std::setprecision(2) << std::setw(14) << "ms" << std::setw(10) << "isa"
+              << std::setw(10) << "count" << std::setw(10) << "and" << std::endl
+              << std::setw(14) << "Vector<bool>" << std::setw(10) << "-" << std::setw(10) << byte_count
+              << std::setw(10) << byte_and << std::endl;
+
+    const char *names[] = { "scalar", "sse2", "avx2" };
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        double bit_count = best_time([&] { sink = bits_left.count(); }, repeats);
+        double bit_and = best_time([&] { bits_left &= bits_right; }, repeats);
+        std::cout << std::setw(14) << "Bit_vector" << std::setw(10) << names[isa] << std::setw(10) << bit_count
+                  << std::setw(10) << bit_and << std::endl;
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+    return 0;
+}
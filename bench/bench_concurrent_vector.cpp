@@ -0,0 +1,97 @@
+/**
+\file
+\brief Append throughput of Concurrent_vector against a Vector guarded by a mutex.
+ Threads share one container and append their share of the elements with push_back,
+ or with grow_by in blocks of 64. Prints millions of appended elements per second.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "smart_array.hpp"
+#include "concurrent_vector.hpp"
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Runs fn(t) on given number of threads and returns millions of elements per second.
+*/
+template <typename Fn>
+double throughput(size_t threads, size_t elements, Fn fn)
+{
+    Clock::time_point start = Clock::now();
+    tasks::Vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(fn, t);
+    }
+    for (size_t t = 0; t < threads; ++t) {
+        workers[t].join();
+    }
+    std::chrono::duration<double> d = Clock::now() - start;
+    return elements / d.count() / 1e6;
+}
+
+/**
+\brief Runs the benchmark. Number of elements and the largest number of threads may be
+ given as arguments, the latter defaults to the hardware concurrency.
+*/
+int main(int argc, char **argv)
+{
+    using namespace tasks;
+
+    size_t elements = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+    size_t max_threads = argc > 2 ? std::strtoul(argv[2], 0, 10)
+                                  : std::max(1u, std::thread::hardware_concurrency());
+    const size_t block = 64;
+
+    std::cout << "Mops/s, " << elements << " ints\n" << std::fixed << std::setprecision(2)
+              << std::setw(9) << "threads" << std::setw(14) << "mutex push" << std::setw(14) << "conc push"
+              << std::setw(14) << "mutex block" << std::setw(14) << "conc grow_by" << std::endl;
+    for (size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        size_t share = elements / threads / block * block;
+        size_t total = share * threads;
+
+        Vector<int> guarded;
+        std::mutex mutex;
+        double mutex_push = throughput(threads, total, [&](size_t t) {
+            for (size_t i = 0; i < share; ++i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                guarded.push_back(int(t));
+            }
+        });
+
+        Concurrent_vector<int> shared;
+        double concurrent_push = throughput(threads, total, [&](size_t t) {
+            for (size_t i = 0; i < share; ++i) {
+                shared.push_back(int(t));
+            }
+        });
+
+        Vector<int> guarded_blocks;
+        double mutex_block = throughput(threads, total, [&](size_t t) {
+            for (size_t i = 0; i < share; i += block) {
+                std::lock_guard<std::mutex> lock(mutex);
+                guarded_blocks.resize(guarded_blocks.size() + block, int(t));
+            }
+        });
+
+        Concurrent_vector<int> shared_blocks;
+        double concurrent_block = throughput(threads, total, [&](size_t t) {
+            for (size_t i = 0; i < share; i += block) {
+                shared_blocks.grow_by(block, int(t));
+            }
+        });
+
+        std::cout << std::setw(9) << threads << std::setw(14) << mutex_push << std::setw(14) << concurrent_push
+                  << std::setw(14) << mutex_block << std::setw(14) << concurrent_block << std::endl;
+        if (threads >= max_threads) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+\file
+\brief Hands one configuration vector of strings to many readers, as Vector copies and
+ as Cow_vector copies. Compares the time of the fan-out, the element bytes it holds and
+ the time of one reader changing its copy afterwards.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "cow_vector.hpp"
+#include "smart_array.hpp"
+
+///Sink for results.
+static volatile size_t sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn,
+ setup runs untimed before each run.
+*/
+template <typename Setup, typename Fn>
+double best_time(Setup setup, Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        setup();
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+///Prints a row of the result table.
+void print_row(const char *name, double fan_out_ms, double megabytes, double write_ms)
+{
+    std::cout << std::setw(14) << name << std::setw(14) << fan_out_ms << std::setw(12) << megabytes << std::setw(14)
+              << write_ms << std::endl;
+}
+
+/**
+\brief Runs the benchmark. Number of settings, readers and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000;
+    size_t reader_count = argc > 2 ? std::strtoul(argv[2], 0, 10) : 256;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    tasks::Vector<std::string> settings;
+    for (size_t i = 0; i < size; ++i) {
+        settings.push_back("option_" + std::to_string(std::rand()) + "_with_a_value_" + std::to_string(i));
+    }
+    size_t element_bytes = 0;
+    for (size_t i = 0; i < size; ++i) {
+        element_bytes += sizeof(std::string) + settings[i].capacity() + 1;
+    }
+    tasks::Cow_vector<std::string> shared(settings);
+
+    tasks::Vector<tasks::Vector<std::string> > copies;
+    tasks::Vector<tasks::Cow_vector<std::string> > views;
+    auto reset_copies = [&] { copies.clear(); };
+    auto reset_views = [&] { views.clear(); };
+
+    double copy_ms = best_time(reset_copies, [&] {
+        for (size_t r = 0; r < reader_count; ++r) {
+            copies.push_back(settings);
+        }
+    }, repeats);
+    double copy_write_ms = best_time([] { }, [&] {
+        copies[0][0] = "changed";
+        sink = copies[0].size();
+    }, repeats);
+    double view_ms = best_time(reset_views, [&] {
+        for (size_t r = 0; r < reader_count; ++r) {
+            views.push_back(shared);
+        }
+    }, repeats);
+    double view_write_ms = best_time([&] { views[0] = shared; }, [&] {
+        views[0][0] = "changed";
+        sink = views[0].size();
+    }, repeats);
+
+    std::cout << size << " settings, " << reader_count << " readers\n" << std::fixed << std::setprecision(3)
+              << std::setw(14) << "container" << std::setw(14) << "fan-out ms" << std::setw(12) << "MB held"
+              << std::setw(14) << "1st write ms" << std::endl;
+    print_row("Vector", copy_ms, reader_count * element_bytes / 1e6, copy_write_ms);
+    print_row("Cow_vector", view_ms, element_bytes / 1e6, view_write_ms);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+\file
+\brief Lookup tables of integer keys built and searched as std::map, std::unordered_map
+ and Flat_map. Flat_map is built once with single inserts and once with one insert_unique
+ batch, lookups search random present and absent keys.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flat_map.hpp"
+
+///Sink for results.
+static volatile long long sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+///Returns sum of values of keys found in table.
+template <typename Table>
+long long lookup(const Table &table, const std::vector<int> &keys)
+{
+    long long total = 0;
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        typename Table::const_iterator iter = table.find(keys[i]);
+        if (iter != table.end()) {
+            total += iter->second;
+        }
+    }
+    return total;
+}
+
+///Prints a row of the result table.
+void print_row(const char *name, double build_ms, double lookup_ms)
+{
+    std::cout << std::setw(26) << name << std::setw(12) << build_ms << std::setw(12) << lookup_ms << std::endl;
+}
+
+/**
+\brief Runs the benchmark for tables of 10^4 and 10^5 entries. Number of lookups
+ and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t lookups = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+    const size_t sizes[] = { 10000, 100000 };
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t size : sizes) {
+        std::vector<std::pair<int, int> > entries;
+        for (size_t i = 0; i < size; ++i) {
+            entries.push_back(std::make_pair(std::rand() % int(4 * size), int(i)));
+        }
+        std::vector<int> keys;
+        for (size_t i = 0; i < lookups; ++i) {
+            keys.push_back(std::rand() % int(4 * size));
+        }
+
+        std::map<int, int> tree;
+        std::unordered_map<int, int> hash;
+        tasks::Flat_map<int, int> flat;
+        double tree_build = best_time([&] {
+            tree.clear();
+            for (size_t i = 0; i < size; ++i) {
+                tree.insert(entries[i]);
+            }
+        }, repeats);
+        double hash_build = best_time([&] {
+            hash.clear();
+            for (size_t i = 0; i < size; ++i) {
+                hash.insert(entries[i]);
+            }
+        }, repeats);
+        double flat_single = best_time([&] {
+            flat.clear();
+            for (size_t i = 0; i < size; ++i) {
+                flat.insert(entries[i]);
+            }
+        }, repeats);
+        double flat_batch = best_time([&] {
+            flat.clear();
+            flat.insert_unique(entries.begin(), entries.end());
+        }, repeats);
+
+        double tree_lookup = best_time([&] { sink = lookup(tree, keys); }, repeats);
+        double hash_lookup = best_time([&] { sink = lookup(hash, keys); }, repeats);
+        double flat_lookup = best_time([&] { sink = lookup(flat, keys); }, repeats);
+
+        std::cout << "\nms, " << flat.size() << " entries, " << lookups << " lookups\n" << std::setw(26) << "table"
+                  << std::setw(12) << "build" << std::setw(12) << "lookup" << std::endl;
+        print_row("std::map", tree_build, tree_lookup);
+        print_row("std::unordered_map", hash_build, hash_lookup);
+        print_row("Flat_map insert", flat_single, flat_lookup);
+        print_row("Flat_map insert_unique", flat_batch, flat_lookup);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+\file
+\brief std::sort, std::copy and std::accumulate over Vector iterators and over the raw
+ pointers returned by data(). The iterators wrap a pointer and should cost nothing.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+#include "smart_array.hpp"
+
+///Sink for results.
+static volatile long long sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn,
+ setup runs untimed before each run.
+*/
+template <typename Setup, typename Fn>
+double best_time(Setup setup, Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        setup();
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+///Prints a row of the result table.
+void print_row(const char *name, double iterator_ms, double pointer_ms)
+{
+    std::cout << std::setw(16) << name << std::setw(12) << iterator_ms << std::setw(12) << pointer_ms
+              << std::setw(11) << iterator_ms / pointer_ms << "x" << std::endl;
+}
+
+/**
+\brief Runs the benchmark. Number of elements and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    tasks::Vector<int> source;
+    source.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        source.push_back(std::rand());
+    }
+    tasks::Vector<int> work(source);
+    tasks::Vector<int> target(size, 0);
+    auto reset = [&] { std::copy(source.data(), source.data() + size, work.data()); };
+    auto nothing = [] { };
+
+    double sort_iterator = best_time(reset, [&] { std::sort(work.begin(), work.end()); }, repeats);
+    double sort_pointer = best_time(reset, [&] { std::sort(work.data(), work.data() + size); }, repeats);
+    double copy_iterator = best_time(nothing, [&] { std::copy(source.begin(), source.end(), target.begin()); },
+                                     repeats);
+    double copy_pointer = best_time(nothing, [&] { std::copy(source.data(), source.data() + size, target.data()); },
+                                    repeats);
+    double sum_iterator = best_time(nothing, [&] {
+        sink = std::accumulate(source.begin(), source.end(), 0LL);
+    }, repeats);
+    double sum_pointer = best_time(nothing, [&] {
+        sink = std::accumulate(source.data(), source.data() + size, 0LL);
+    }, repeats);
+
+    std::cout << "ms, " << size << " ints\n" << std::fixed << std::setprecision(2) << std::setw(16) << "algorithm"
+              << std::setw(12) << "iterator" << std::setw(12) << "pointer" << std::setw(12) << "ratio" << std::endl;
+    print_row("std::sort", sort_iterator, sort_pointer);
+    print_row("std::copy", copy_iterator, copy_pointer);
+    print_row("std::accumulate", sum_iterator, sum_pointer);
+    return 0;
+}
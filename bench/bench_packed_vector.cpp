@@ -0,0 +1,106 @@
+/**
+\file
+\brief Sorted id lists stored as Vector<uint32_t>, as Packed_vector at the width of the
+ largest id and as Block_packed_vector with delta encoding. Compares memory and the
+ time of summing every id, on each instruction set for the block decoder.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "packed_vector.hpp"
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+
+///Sink for results.
+static volatile uint64_t sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+///Prints a row of the result table.
+void print_row(const char *name, const char *isa, double megabytes, double ms)
+{
+    std::cout << std::setw(20) << name << std::setw(8) << isa << std::setw(10) << megabytes << std::setw(10) << ms
+              << std::endl;
+}
+
+/**
+\brief Runs the benchmark. Number of ids, average gap between them and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 20000000;
+    unsigned gap = argc > 2 ? std::atoi(argv[2]) : 16;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    tasks::Vector<uint32_t> ids;
+    ids.reserve(size);
+    uint32_t id = 0;
+    for (size_t i = 0; i < size; ++i) {
+        id += 1 + std::rand() % (2 * gap - 1);
+        ids.push_back(id);
+    }
+    tasks::Packed_vector packed(ids);
+    tasks::Block_packed_vector blocks(ids, tasks::Block_packed_vector::delta);
+    const uint32_t *ids_ptr = &ids[0];
+
+    double plain_ms = best_time([&] {
+        uint64_t total = 0;
+        for (size_t i = 0; i < size; ++i) {
+            total += ids_ptr[i];
+        }
+        sink = total;
+    }, repeats);
+    double packed_ms = best_time([&] {
+        uint64_t total = 0;
+        for (size_t i = 0; i < size; ++i) {
+            total += packed[i];
+        }
+        sink = total;
+    }, repeats);
+
+    std::cout << size << " sorted ids, average gap " << gap << ", packed width " << packed.bits() << " bits\n"
+              << std::fixed << std::setprecision(2) << std::setw(20) << "container" << std::setw(8) << "isa"
+              << std::setw(10) << "MB" << std::setw(10) << "sum ms" << std::endl;
+    print_row("Vector<uint32_t>", "-", size * sizeof(uint32_t) / 1e6, plain_ms);
+    print_row("Packed_vector", "-", packed.word_count() * sizeof(uint64_t) / 1e6, packed_ms);
+
+    const char *names[] = { "scalar", "sse2", "avx2" };
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        double blocks_ms = best_time([&] {
+            uint64_t total = 0;
+            blocks.scan([&total](const uint32_t *values_ptr, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    total += values_ptr[i];
+                }
+            });
+            sink = total;
+        }, repeats);
+        print_row("Block_packed delta", names[isa], blocks.encoded_bytes() / 1e6, blocks_ms);
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+    return 0;
+}
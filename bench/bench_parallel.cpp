@@ -0,0 +1,104 @@
+/**
+\file
+\brief Scaling benchmark of tasks::parallel algorithms. Every algorithm runs on pools
+ of 1, 2, 4, ... threads up to the hardware concurrency, the table prints the time
+ in milliseconds and the speedup over the pool of one thread.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "smart_array.hpp"
+#include "parallel.hpp"
+
+///Sink for results.
+static volatile double sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+/**
+\brief Runs the benchmark. Number of elements, repeats and the largest pool may be given as
+ arguments, the largest pool defaults to the hardware concurrency.
+*/
+int main(int argc, char **argv)
+{
+    using namespace tasks;
+
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+    size_t max_threads = argc > 3 ? std::strtoul(argv[3], 0, 10)
+                                  : std::max(1u, std::thread::hardware_concurrency());
+
+    Vector<double> input(size);
+    Vector<double> output(size);
+    Vector<double> sorted(size);
+    for (size_t i = 0; i < size; ++i) {
+        input[i] = double((i * 2654435761u) % 1000003);
+    }
+
+    const char *names[] = { "for_each", "transform", "reduce", "inclusive_scan", "fill", "sort" };
+    const int algorithms = sizeof(names) / sizeof(names[0]);
+    double base[algorithms];
+
+    std::cout << "ms (speedup), " << size << " doubles\n" << std::fixed << std::setprecision(2)
+              << std::setw(9) << "threads";
+    for (int a = 0; a < algorithms; ++a) {
+        std::cout << std::setw(22) << names[a];
+    }
+    std::cout << std::endl;
+
+    for (size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        parallel::Thread_pool pool(threads);
+        double ms[algorithms];
+
+        ms[0] = best_time([&] {
+            parallel::for_each(output.begin(), output.end(), [](double &v) { v = v * 1.5 + 1; }, pool);
+        }, repeats);
+        ms[1] = best_time([&] {
+            parallel::transform(input.begin(), input.end(), output.begin(), [](double v) { return v * v; }, pool);
+        }, repeats);
+        ms[2] = best_time([&] { sink = parallel::reduce(input.begin(), input.end(), 0.0, pool); }, repeats);
+        ms[3] = best_time([&] { parallel::inclusive_scan(input.begin(), input.end(), output.begin(), pool); },
+                          repeats);
+        ms[4] = best_time([&] { parallel::fill(output.begin(), output.end(), 2.0, pool); }, repeats);
+        ms[5] = best_time([&] {
+            sorted = input;
+            parallel::sort(sorted.begin(), sorted.end(), pool);
+        }, repeats);
+
+        std::cout << std::setw(9) << threads;
+        for (int a = 0; a < algorithms; ++a) {
+            if (1 == threads) {
+                base[a] = ms[a];
+            }
+            std::cout << std::setw(12) << ms[a] << " (" << std::setw(5) << base[a] / ms[a] << "x)";
+        }
+        std::cout << std::endl;
+        if (threads >= max_threads) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+\file
+\brief Reverse scans summing Vector<int> with reverse iterators, with a backward raw pointer
+ loop and with forward iterators for reference. Runs on a cache resident vector, scanned
+ many times, and on a large one.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+#include "smart_array.hpp"
+
+///Sink for results.
+static volatile long long sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+///Sums elements with a loop over reverse iterators.
+long long reverse_sum(const tasks::Vector<int> &vec)
+{
+    long long total = 0;
+
+    for (tasks::Vector<int>::const_reverse_iterator iter = vec.rbegin(); iter != vec.rend(); ++iter) {
+        total += *iter;
+    }
+    return total;
+}
+
+///Sums elements with a backward loop over pointers.
+long long pointer_sum(const int *first_ptr, const int *last_ptr)
+{
+    long long total = 0;
+
+    while (last_ptr != first_ptr) {
+        total += *--last_ptr;
+    }
+    return total;
+}
+
+///Sums elements with a loop over forward iterators.
+long long forward_sum(const tasks::Vector<int> &vec)
+{
+    long long total = 0;
+
+    for (tasks::Vector<int>::const_iterator iter = vec.begin(); iter != vec.end(); ++iter) {
+        total += *iter;
+    }
+    return total;
+}
+
+/**
+\brief Measures the scans of vec, each run scans it passes times, prints GB/s.
+*/
+void run(const tasks::Vector<int> &vec, int passes, int repeats)
+{
+    double bytes = double(vec.size()) * sizeof(int) * passes;
+    double reverse_ms = best_time([&] {
+        for (int p = 0; p < passes; ++p) {
+            sink = reverse_sum(vec);
+        }
+    }, repeats);
+    double accumulate_ms = best_time([&] {
+        for (int p = 0; p < passes; ++p) {
+            sink = std::accumulate(vec.rbegin(), vec.rend(), 0LL);
+        }
+    }, repeats);
+    double pointer_ms = best_time([&] {
+        for (int p = 0; p < passes; ++p) {
+            sink = pointer_sum(vec.data(), vec.data() + vec.size());
+        }
+    }, repeats);
+    double forward_ms = best_time([&] {
+        for (int p = 0; p < passes; ++p) {
+            sink = forward_sum(vec);
+        }
+    }, repeats);
+
+    std::cout << std::setw(12) << vec.size() << std::setw(12) << bytes / reverse_ms / 1e6 << std::setw(12)
+              << bytes / accumulate_ms / 1e6 << std::setw(12) << bytes / pointer_ms / 1e6 << std::setw(12)
+              << bytes / forward_ms / 1e6 << std::endl;
+}
+
+/**
+\brief Runs the benchmark. Size of the large vector and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 50000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    tasks::Vector<int> small;
+    tasks::Vector<int> large;
+    for (size_t i = 0; i < 4096; ++i) {
+        small.push_back(std::rand());
+    }
+    large.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        large.push_back(std::rand());
+    }
+
+    std::cout << "GB/s of summing ints\n" << std::fixed << std::setprecision(2) << std::setw(12) << "size"
+              << std::setw(12) << "reverse" << std::setw(12) << "accumulate" << std::setw(12) << "pointer"
+              << std::setw(12) << "forward" << std::endl;
+    run(small, 20000, repeats);
+    run(large, 1, repeats);
+    return 0;
+}
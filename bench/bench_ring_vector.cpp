@@ -0,0 +1,120 @@
+/**
+\file
+\brief Sliding-window queues of ints: every step drops the oldest element and appends a
+ new one, with Vector erase(begin()) and push_back, with std::deque and with Ring_vector.
+ A second pass grows a queue at the front, with Vector insert(begin()), std::deque and
+ Ring_vector push_front.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+
+#include "ring_vector.hpp"
+#include "smart_array.hpp"
+
+///Sink for results.
+static volatile long long sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+///Slides a window of given size over steps values, pop_front drops the oldest element.
+template <typename Queue, typename Pop>
+void slide(size_t window, size_t steps, Pop pop_front)
+{
+    Queue queue;
+    long long total = 0;
+
+    for (size_t i = 0; i < window; ++i) {
+        queue.push_back(int(i));
+    }
+    for (size_t i = 0; i < steps; ++i) {
+        total += queue.front();
+        pop_front(queue);
+        queue.push_back(int(i));
+    }
+    sink = total;
+}
+
+///Grows a queue to count elements at the front, push_front prepends one.
+template <typename Queue, typename Push>
+void grow_front(size_t count, Push push_front)
+{
+    Queue queue;
+
+    for (size_t i = 0; i < count; ++i) {
+        push_front(queue, int(i));
+    }
+    sink = queue.front();
+}
+
+///Prints a row of the result table, times per operation in nanoseconds.
+void print_row(const char *name, double vector_ns, double deque_ns, double ring_ns)
+{
+    std::cout << std::setw(22) << name << std::setw(12) << vector_ns << std::setw(12) << deque_ns << std::setw(12)
+              << ring_ns << std::endl;
+}
+
+/**
+\brief Runs the benchmark. Number of steps and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t steps = argc > 1 ? std::strtoul(argv[1], 0, 10) : 200000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+    const size_t windows[] = { 64, 4096, 65536 };
+
+    auto vector_pop = [](tasks::Vector<int> &queue) { queue.erase(queue.begin()); };
+    auto deque_pop = [](std::deque<int> &queue) { queue.pop_front(); };
+    auto ring_pop = [](tasks::Ring_vector<int> &queue) { queue.pop_front(); };
+
+    std::cout << "ns per step, " << steps << " steps\n" << std::fixed << std::setprecision(2) << std::setw(22)
+              << "sliding window" << std::setw(12) << "Vector" << std::setw(12) << "std::deque" << std::setw(12)
+              << "Ring_vector" << std::endl;
+    for (size_t window : windows) {
+        double vector_ms = best_time([&] { slide<tasks::Vector<int> >(window, steps, vector_pop); }, repeats);
+        double deque_ms = best_time([&] { slide<std::deque<int> >(window, steps, deque_pop); }, repeats);
+        double ring_ms = best_time([&] { slide<tasks::Ring_vector<int> >(window, steps, ring_pop); }, repeats);
+        std::string name = "window " + std::to_string(window);
+        print_row(name.c_str(), vector_ms * 1e6 / steps, deque_ms * 1e6 / steps, ring_ms * 1e6 / steps);
+    }
+
+    size_t count = steps / 4;
+    double vector_ms = best_time([&] {
+        grow_front<tasks::Vector<int> >(count, [](tasks::Vector<int> &queue, int value) {
+            queue.insert(queue.begin(), value);
+        });
+    }, repeats);
+    double deque_ms = best_time([&] {
+        grow_front<std::deque<int> >(count, [](std::deque<int> &queue, int value) { queue.push_front(value); });
+    }, repeats);
+    double ring_ms = best_time([&] {
+        grow_front<tasks::Ring_vector<int> >(count, [](tasks::Ring_vector<int> &queue, int value) {
+            queue.push_front(value);
+        });
+    }, repeats);
+    std::string name = "push_front to " + std::to_string(count);
+    print_row(name.c_str(), vector_ms * 1e6 / count, deque_ms * 1e6 / count, ring_ms * 1e6 / count);
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+\file
+\brief Compares Segmented_vector with Vector: time to append n elements, memory held
+ afterwards (Vector reserved 3x up front to keep its addresses stable, as callers
+ holding pointers do), and the cost of indexed and sequential reads.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "smart_array.hpp"
+#include "segmented_vector.hpp"
+
+///Sink for results.
+static volatile long long sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Returns milliseconds taken by fn.
+*/
+template <typename Fn>
+double time_ms(Fn fn)
+{
+    Clock::time_point start = Clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> d = Clock::now() - start;
+    return d.count();
+}
+
+/**
+\brief Prints one line of results for container type Vec.
+\param name Name of the container.
+\param size Number of elements.
+\param reserve Number of elements reserved before appending.
+*/
+template <typename Vec>
+void run(const std::string &name, size_t size, size_t reserve)
+{
+    Vec vec;
+    double append = time_ms([&] {
+        vec.reserve(reserve);
+        for (size_t i = 0; i < size; ++i) {
+            vec.push_back(int(i));
+        }
+    });
+    double indexed = time_ms([&] {
+        long long total = 0;
+        for (size_t i = 0, j = 0; i < size; ++i, j = (j + 7919) % size) {
+            total += vec[j];
+        }
+        sink = total;
+    });
+    double sequential = time_ms([&] {
+        long long total = 0;
+        for (typename Vec::iterator it = vec.begin(); it != vec.end(); ++it) {
+            total += *it;
+        }
+        sink = total;
+    });
+
+    std::cout << std::setw(22) << name << std::setw(12) << append << std::setw(12)
+              << vec.capacity() * sizeof(int) / 1048576.0 << std::setw(12) << indexed
+              << std::setw(12) << sequential << std::endl;
+}
+
+/**
+\brief Runs the benchmark. Number of elements may be given as argument.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+
+    std::cout << size << " ints\n" << std::fixed << std::setprecision(2) << std::setw(22) << "container"
+              << std::setw(12) << "append ms" << std::setw(12) << "MiB held" << std::setw(12) << "index ms"
+              << std::setw(12) << "iterate ms" << std::endl;
+    run<tasks::Vector<int> >("Vector", size, 0);
+    run<tasks::Vector<int> >("Vector reserved 3x", size, 3 * size);
+    run<tasks::Segmented_vector<int> >("Segmented_vector", size, 0);
+    return 0;
+}
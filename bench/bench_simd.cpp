@@ -0,0 +1,105 @@
+/**
+\file
+\brief Throughput benchmark of the SIMD kernels on every supported instruction set,
+ compared with std::equal, std::find, std::count, std::min_element, std::max_element
+ and std::accumulate through Vector iterators. Prints GB/s read by each kernel.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+
+///Sink for results.
+static volatile double sink;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+\brief Runs fn given number of times and returns GB/s for bytes read per run.
+*/
+template <typename Fn>
+double throughput(Fn fn, size_t bytes, int repeats)
+{
+    Clock::time_point start = Clock::now();
+
+    for (int r = 0; r < repeats; ++r) {
+        sink = static_cast<double>(fn());
+    }
+    std::chrono::duration<double> d = Clock::now() - start;
+    return bytes * double(repeats) / d.count() / 1e9;
+}
+
+/**
+\brief Prints one line of results for element type T.
+*/
+template <typename T>
+void run(const std::string &type_name, size_t size, int repeats)
+{
+    tasks::Vector<T> left(size);
+    for (size_t i = 0; i < size; ++i) {
+        left[i] = static_cast<T>(i % 97);
+    }
+    tasks::Vector<T> right(left);
+    const T *lp = &left[0];
+    const T *rp = &right[0];
+    const T missing = static_cast<T>(200);
+    const size_t bytes = size * sizeof(T);
+
+    std::cout << std::setw(9) << type_name << std::setw(10) << "std"
+              << std::setw(10) << throughput([&] { return std::equal(left.begin(), left.end(), right.begin()); },
+                                             bytes * 2, repeats)
+              << std::setw(10) << throughput([&] { return std::find(left.begin(), left.end(), missing) == left.end(); },
+                                             bytes, repeats)
+              << std::setw(10) << throughput([&] { return std::count(left.begin(), left.end(), missing); },
+                                             bytes, repeats)
+              << std::setw(10) << throughput([&] { return *std::min_element(left.begin(), left.end()); },
+                                             bytes, repeats)
+              << std::setw(10) << throughput([&] { return *std::max_element(left.begin(), left.end()); },
+                                             bytes, repeats)
+              << std::setw(10) << throughput([&] {
+                     return std::accumulate(left.begin(), left.end(), typename tasks::simd::Sum<T>::type());
+                 }, bytes, repeats)
+              << std::endl;
+
+    const char *names[] = { "scalar", "SSE2", "AVX2" };
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        std::cout << std::setw(9) << type_name << std::setw(10) << names[isa]
+                  << std::setw(10) << throughput([&] { return tasks::simd::equal(lp, rp, size); }, bytes * 2, repeats)
+                  << std::setw(10) << throughput([&] { return tasks::simd::find(lp, size, missing); }, bytes, repeats)
+                  << std::setw(10) << throughput([&] { return tasks::simd::count(lp, size, missing); }, bytes, repeats)
+                  << std::setw(10) << throughput([&] { return tasks::simd::min_value(lp, size); }, bytes, repeats)
+                  << std::setw(10) << throughput([&] { return tasks::simd::max_value(lp, size); }, bytes, repeats)
+                  << std::setw(10) << throughput([&] { return tasks::simd::sum(lp, size); }, bytes, repeats)
+                  << std::endl;
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+}
+
+/**
+\brief Runs the benchmark. Number of elements and repeats may be given as arguments,
+ the default 64K elements stay in cache.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 65536;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    std::cout << "GB/s read, " << size << " elements\n" << std::fixed << std::setprecision(2)
+              << std::setw(9) << "type" << std::setw(10) << "kernels" << std::setw(10) << "equal"
+              << std::setw(10) << "find" << std::setw(10) << "count" << std::setw(10) << "min"
+              << std::setw(10) << "max" << std::setw(10) << "sum" << std::endl;
+    run<int>("int", size, repeats);
+    run<float>("float", size, repeats);
+    run<double>("double", size, repeats);
+    run<uint8_t>("uint8_t", size, repeats);
+    return 0;
+}
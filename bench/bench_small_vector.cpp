@@ -0,0 +1,63 @@
+/**
+\file 
+\brief Benchmark of Small_vector against Vector for sizes 0 to 64.
+ Every iteration builds a vector by push_back, sums it through operator[] and drops it.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "smart_array.hpp"
+#include "small_vector.hpp"
+
+/**
+\brief Returns nanoseconds per build-sum-drop iteration of given container type.
+\param size Number of elements.
+\param iterations Number of iterations.
+*/
+template <typename Container>
+double ns_per_iteration(int size, int iterations)
+{
+    long checksum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int it = 0; it < iterations; ++it) {
+        Container vec;
+
+        for (int i = 0; i < size; ++i) {
+            vec.push_back(i + it);
+        }
+        for (int i = 0; i < size; ++i) {
+            checksum += vec[i];
+        }
+    }
+    std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+    if (checksum == 42) {
+        std::cout << ' ';
+    }
+    return d.count() / iterations;
+}
+
+/**
+\brief Runs the benchmark. Number of iterations may be given as argument.
+*/
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int sizes[] = { 0, 1, 2, 4, 8, 12, 16, 24, 32, 48, 64 };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(8) << "size" << std::setw(16) << "Vector ns" 
+              << std::setw(20) << "Small_vector<16> ns" << std::endl;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        std::cout << std::setw(8) << sizes[i]
+                  << std::setw(16) << ns_per_iteration<tasks::Vector<int> >(sizes[i], iterations)
+                  << std::setw(20) 
+                  << ns_per_iteration<tasks::Small_vector<int, 16> >(sizes[i], iterations) 
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+\file
+\brief Column scans over a table of 10-field records stored as Vector<Record>
+ (array of structures) and as Soa_vector (structure of arrays). Scans read one
+ or two of the fields, the rest of every cache line loaded by the Vector is wasted.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <tuple>
+
+#include "smart_array.hpp"
+#include "soa_vector.hpp"
+
+///Sink for results.
+static volatile double sink;
+
+typedef std::chrono::steady_clock Clock;
+
+///Record of ten 8-byte fields.
+struct Record
+{
+    int64_t id;
+    double price;
+    double quantity;
+    int64_t account;
+    int64_t timestamp;
+    double fee;
+    double tax;
+    int64_t flags;
+    int64_t region;
+    double discount;
+};
+
+typedef tasks::Soa_vector<int64_t, double, double, int64_t, int64_t, double, double, int64_t, int64_t, double> Table;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+/**
+\brief Runs the benchmark. Number of rows and repeats may be given as arguments,
+ 10^8 rows need about 16 GB for both tables.
+*/
+int main(int argc, char **argv)
+{
+    size_t rows = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    tasks::Vector<Record> records;
+    Table table;
+    records.reserve(rows);
+    table.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        Record record = { int64_t(i), i % 100 * 0.25, double(i % 7), int64_t(i % 1000), int64_t(i), 0.1, 0.2,
+                          int64_t(i & 3), int64_t(i % 17), 0.05 };
+        records.push_back(record);
+        table.push_back(std::make_tuple(record.id, record.price, record.quantity, record.account, record.timestamp,
+                                        record.fee, record.tax, record.flags, record.region, record.discount));
+    }
+    const Record *records_ptr = &records[0];
+    const double *price_ptr = table.data<1>();
+    const double *quantity_ptr = table.data<2>();
+
+    double aos_one = best_time([&] {
+        double total = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            total += records_ptr[i].price;
+        }
+        sink = total;
+    }, repeats);
+    double soa_one = best_time([&] {
+        double total = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            total += price_ptr[i];
+        }
+        sink = total;
+    }, repeats);
+    double aos_two = best_time([&] {
+        double total = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            total += records_ptr[i].price * records_ptr[i].quantity;
+        }
+        sink = total;
+    }, repeats);
+    double soa_two = best_time([&] {
+        double total = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            total += price_ptr[i] * quantity_ptr[i];
+        }
+        sink = total;
+    }, repeats);
+
+    std::cout << "ms, " << rows << " rows of 10 fields\n" << std::fixed << std::setprecision(2)
+              << std::setw(16) << "scan" << std::setw(12) << "Vector" << std::setw(12) << "Soa_vector"
+              << std::setw(12) << "speedup" << std::endl
+              << std::setw(16) << "sum(price)" << std::setw(12) << aos_one << std::setw(12) << soa_one
+              << std::setw(11) << aos_one / soa_one << "x" << std::endl
+              << std::setw(16) << "sum(price*qty)" << std::setw(12) << aos_two << std::setw(12) << soa_two
+              << std::setw(11) << aos_two / soa_two << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,449 @@
+/**
+\file
+\brief Non-interactive micro-benchmark suite comparing tasks::Vector with std::vector.
+ Covers push_back, reserve, insert/erase, copy and iteration for int, 64-byte POD
+ and std::string elements. Reports ns/op, allocations and bytes copied per iteration
+ and optionally writes the results as JSON.
+
+ Options:
+ --min-size=N, --max-size=N  Range of sizes, powers of ten (default 10 to 1000000).
+ --min-time=S                Minimal measured time per benchmark in seconds (default 0.1).
+ --filter=TEXT               Runs only benchmarks whose name contains TEXT.
+ --json=PATH                 Writes results to PATH.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "smart_array.hpp"
+
+///Number of allocations made through Counting_allocator.
+static size_t allocation_count = 0;
+///Number of bytes allocated through Counting_allocator.
+static size_t allocated_bytes = 0;
+///Number of element copies and moves made by Tracked elements.
+static size_t copy_count = 0;
+
+/**
+\brief Allocator counting allocations and allocated bytes.
+*/
+template <typename T>
+struct Counting_allocator
+{
+    typedef T value_type;
+
+    Counting_allocator() { }
+    template <typename U>
+    Counting_allocator(const Counting_allocator<U> &) { }
+
+    T *allocate(size_t count)
+    {
+        ++allocation_count;
+        allocated_bytes += count * sizeof(T);
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *ptr, size_t count) { std::allocator<T>().deallocate(ptr, count); }
+
+    template <typename U>
+    bool operator==(const Counting_allocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const Counting_allocator<U> &) const { return false; }
+};
+
+/**
+\brief Trivially copyable 64-byte record.
+*/
+struct Pod64
+{
+    long fields[8];
+};
+
+/**
+\brief Element wrapper counting copies and moves, used in a separate
+ accounting run so the timed run keeps the real element type.
+*/
+template <typename T>
+struct Tracked
+{
+    T value;
+
+    Tracked() : value() { }
+    Tracked(const T &v) : value(v) { }
+    Tracked(const Tracked &other) : value(other.value) { ++copy_count; }
+    Tracked(Tracked &&other) noexcept : value(std::move(other.value)) { ++copy_count; }
+    Tracked &operator=(const Tracked &other) { value = other.value; ++copy_count; return *this; }
+    Tracked &operator=(Tracked &&other) noexcept
+    {
+        value = std::move(other.value);
+        ++copy_count;
+        return *this;
+    }
+};
+
+/**
+\brief Creates the i-th test value of given type.
+*/
+template <typename T>
+T make_value(size_t i);
+
+template <>
+int make_value<int>(size_t i)
+{
+    return static_cast<int>(i);
+}
+
+template <>
+Pod64 make_value<Pod64>(size_t i)
+{
+    Pod64 pod;
+    for (int f = 0; f < 8; ++f) {
+        pod.fields[f] = static_cast<long>(i) + f;
+    }
+    return pod;
+}
+
+template <>
+std::string make_value<std::string>(size_t i)
+{
+    return "element-with-heap-storage-" + std::to_string(i);
+}
+
+/**
+\brief Returns a number derived from the value, keeps the compiler from dropping loops.
+*/
+inline size_t digest(int value) { return value; }
+inline size_t digest(const Pod64 &value) { return value.fields[0]; }
+inline size_t digest(const std::string &value) { return value.size(); }
+template <typename T>
+inline size_t digest(const Tracked<T> &value) { return digest(value.value); }
+
+///Sink for digests.
+static volatile size_t sink;
+
+typedef std::chrono::steady_clock Clock;
+
+///Allocation count when the last timed region started.
+static size_t start_allocation_count = 0;
+///Allocated bytes when the last timed region started.
+static size_t start_allocated_bytes = 0;
+///Copy count when the last timed region started.
+static size_t start_copy_count = 0;
+
+/**
+\brief Starts a timed region, counters are reported relative to its start.
+*/
+inline Clock::time_point start_timing()
+{
+    start_allocation_count = allocation_count;
+    start_allocated_bytes = allocated_bytes;
+    start_copy_count = copy_count;
+    return Clock::now();
+}
+
+/**
+\brief Returns nanoseconds elapsed since given time point.
+*/
+inline double elapsed_ns(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+\brief Benchmarked operations. Every function runs given number of iterations on
+ vectors of given size and returns elapsed nanoseconds, setup is not timed.
+*/
+template <typename Vec>
+struct Operations
+{
+    typedef typename Vec::value_type T;
+
+    ///Builds a vector by push_back from empty. One op is one push_back.
+    static double push_back(const std::vector<T> &src, size_t iterations)
+    {
+        Clock::time_point start = start_timing();
+        for (size_t it = 0; it < iterations; ++it) {
+            Vec vec;
+            for (size_t i = 0; i < src.size(); ++i) {
+                vec.push_back(src[i]);
+            }
+            sink = vec.size();
+        }
+        return elapsed_ns(start);
+    }
+
+    ///Reserves and then fills a vector by push_back. One op is one push_back.
+    static double reserve_push_back(const std::vector<T> &src, size_t iterations)
+    {
+        Clock::time_point start = start_timing();
+        for (size_t it = 0; it < iterations; ++it) {
+            Vec vec;
+            vec.reserve(src.size());
+            for (size_t i = 0; i < src.size(); ++i) {
+                vec.push_back(src[i]);
+            }
+            sink = vec.size();
+        }
+        return elapsed_ns(start);
+    }
+
+    ///Inserts one element in the middle and erases it again. One op is one pair.
+    static double insert_erase_middle(const std::vector<T> &src, size_t iterations)
+    {
+        Vec vec;
+        vec.reserve(src.size() + 1);
+        for (size_t i = 0; i < src.size(); ++i) {
+            vec.push_back(src[i]);
+        }
+        Clock::time_point start = start_timing();
+        for (size_t it = 0; it < iterations; ++it) {
+            typename Vec::iterator pos = vec.begin();
+            pos += src.size() / 2;
+            pos = vec.insert(pos, src[0]);
+            vec.erase(pos);
+        }
+        return elapsed_ns(start);
+    }
+
+    ///Copy constructs a vector. One op is one copy of the vector.
+    static double copy(const std::vector<T> &src, size_t iterations)
+    {
+        Vec vec;
+        for (size_t i = 0; i < src.size(); ++i) {
+            vec.push_back(src[i]);
+        }
+        Clock::time_point start = start_timing();
+        for (size_t it = 0; it < iterations; ++it) {
+            Vec copy(vec);
+            sink = copy.size();
+        }
+        return elapsed_ns(start);
+    }
+
+    ///Reads all elements through iterators. One op is one pass.
+    static double iterate(const std::vector<T> &src, size_t iterations)
+    {
+        Vec vec;
+        for (size_t i = 0; i < src.size(); ++i) {
+            vec.push_back(src[i]);
+        }
+        Clock::time_point start = start_timing();
+        for (size_t it = 0; it < iterations; ++it) {
+            size_t total = 0;
+            for (typename Vec::iterator iter = vec.begin(); iter != vec.end(); ++iter) {
+                total += digest(*iter);
+            }
+            sink = total;
+        }
+        return elapsed_ns(start);
+    }
+
+    ///Reserves double capacity of a full vector, relocating all elements. One op is one reserve.
+    static double reserve(const std::vector<T> &src, size_t iterations)
+    {
+        double total = 0;
+        for (size_t it = 0; it < iterations; ++it) {
+            Vec vec;
+            vec.reserve(src.size());
+            for (size_t i = 0; i < src.size(); ++i) {
+                vec.push_back(src[i]);
+            }
+            Clock::time_point start = start_timing();
+            vec.reserve(src.size() * 2);
+            total += elapsed_ns(start);
+        }
+        return total;
+    }
+};
+
+/**
+\brief Result of one benchmark.
+*/
+struct Result
+{
+    std::string name;
+    size_t size;
+    size_t iterations;
+    double ns_per_op;
+    double allocations;
+    double bytes_allocated;
+    double bytes_copied;
+};
+
+/**
+\brief Options given on the command line.
+*/
+struct Options
+{
+    size_t min_size;
+    size_t max_size;
+    double min_time_ns;
+    std::string filter;
+    std::string json_path;
+};
+
+/**
+\brief Runs one operation with growing iteration count until min time is reached,
+ then an accounting run with Tracked elements counts copies.
+\param name Benchmark name.
+\param ops_per_iteration Number of ops one iteration performs.
+\param timed Operation on the real element type.
+\param tracked Same operation on Tracked elements.
+*/
+template <typename T, typename TrackedT>
+void run_case(const std::string &name, const Options &options, size_t size, size_t ops_per_iteration,
+              double (*timed)(const std::vector<T> &, size_t),
+              double (*tracked)(const std::vector<TrackedT> &, size_t),
+              std::vector<Result> &results)
+{
+    if (std::string::npos == name.find(options.filter)) {
+        return;
+    }
+    std::vector<T> src;
+    src.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        src.push_back(make_value<T>(i));
+    }
+    size_t iterations = 1;
+    double ns = timed(src, iterations);
+
+    while (ns < options.min_time_ns && iterations < 1000000000) {
+        size_t next = ns > 0 ? static_cast<size_t>(iterations * options.min_time_ns / ns * 1.2) : 0;
+        iterations = next > iterations * 10 ? iterations * 10 : (next > iterations ? next : iterations * 2);
+        ns = timed(src, iterations);
+    }
+    std::vector<TrackedT> tracked_src(src.begin(), src.end());
+    tracked(tracked_src, 1);
+
+    Result result;
+    result.name = name;
+    result.size = size;
+    result.iterations = iterations;
+    result.ns_per_op = ns / (double(iterations) * ops_per_iteration);
+    result.allocations = double(allocation_count - start_allocation_count);
+    result.bytes_allocated = double(allocated_bytes - start_allocated_bytes);
+    result.bytes_copied = double(copy_count - start_copy_count) * sizeof(T);
+    results.push_back(result);
+
+    std::cout << std::left << std::setw(52) << name << std::right
+              << std::setw(14) << std::setprecision(3) << result.ns_per_op
+              << std::setw(12) << iterations << std::setw(12) << std::setprecision(0) << result.allocations
+              << std::setw(16) << result.bytes_allocated << std::setw(16) << result.bytes_copied
+              << std::endl;
+}
+
+/**
+\brief Runs all operations of one container and element type for one size.
+*/
+template <typename Vec, typename TrackedVec>
+void run_container(const std::string &prefix, const Options &options, size_t size,
+                   std::vector<Result> &results)
+{
+    typedef typename Vec::value_type T;
+    typedef typename TrackedVec::value_type TrackedT;
+    typedef Operations<Vec> Op;
+    typedef Operations<TrackedVec> Tr;
+    std::string suffix = prefix + "/" + std::to_string(size);
+
+    run_case<T, TrackedT>("push_back/" + suffix, options, size, size,
+                          &Op::push_back, &Tr::push_back, results);
+    run_case<T, TrackedT>("reserve_push_back/" + suffix, options, size, size,
+                          &Op::reserve_push_back, &Tr::reserve_push_back, results);
+    run_case<T, TrackedT>("insert_erase_middle/" + suffix, options, size, 1,
+                          &Op::insert_erase_middle, &Tr::insert_erase_middle, results);
+    run_case<T, TrackedT>("copy/" + suffix, options, size, 1, &Op::copy, &Tr::copy, results);
+    run_case<T, TrackedT>("iterate/" + suffix, options, size, 1, &Op::iterate, &Tr::iterate, results);
+    run_case<T, TrackedT>("reserve/" + suffix, options, size, 1, &Op::reserve, &Tr::reserve, results);
+}
+
+/**
+\brief Runs tasks::Vector and std::vector of given element type for one size.
+*/
+template <typename T>
+void run_type(const std::string &type_name, const Options &options, size_t size,
+              std::vector<Result> &results)
+{
+    run_container<tasks::Vector<T, Counting_allocator<T> >,
+                  tasks::Vector<Tracked<T>, Counting_allocator<Tracked<T> > > >(
+        "tasks::Vector/" + type_name, options, size, results);
+    run_container<std::vector<T, Counting_allocator<T> >,
+                  std::vector<Tracked<T>, Counting_allocator<Tracked<T> > > >(
+        "std::vector/" + type_name, options, size, results);
+}
+
+/**
+\brief Writes results as JSON.
+\param path Output file path.
+\param results Benchmark results.
+*/
+void write_json(const std::string &path, const std::vector<Result> &results)
+{
+    std::ofstream out(path.c_str());
+
+    out << "{\n  \"context\": {\n    \"library\": \"smart_array\",\n"
+        << "    \"units\": {\"time\": \"ns/op\", \"allocations\": \"per iteration\", "
+        << "\"bytes\": \"per iteration\"}\n  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size
+            << ", \"iterations\": " << r.iterations
+            << std::fixed << std::setprecision(3) << ", \"ns_per_op\": " << r.ns_per_op
+            << std::setprecision(0) << ", \"allocations\": " << r.allocations
+            << ", \"bytes_allocated\": " << r.bytes_allocated
+            << ", \"bytes_copied\": " << r.bytes_copied << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+\brief Parses options and runs the suite.
+*/
+int main(int argc, char **argv)
+{
+    Options options;
+    options.min_size = 10;
+    options.max_size = 1000000;
+    options.min_time_ns = 0.1e9;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value = arg.substr(arg.find('=') + 1);
+
+        if (0 == arg.find("--min-size=")) {
+            options.min_size = std::strtoul(value.c_str(), 0, 10);
+        } else if (0 == arg.find("--max-size=")) {
+            options.max_size = std::strtoul(value.c_str(), 0, 10);
+        } else if (0 == arg.find("--min-time=")) {
+            options.min_time_ns = std::atof(value.c_str()) * 1e9;
+        } else if (0 == arg.find("--filter=")) {
+            options.filter = value;
+        } else if (0 == arg.find("--json=")) {
+            options.json_path = value;
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+    std::vector<Result> results;
+
+    std::cout << std::fixed << std::left << std::setw(52) << "benchmark" << std::right
+              << std::setw(14) << "ns/op" << std::setw(12) << "iterations"
+              << std::setw(12) << "allocs" << std::setw(16) << "bytes alloc"
+              << std::setw(16) << "bytes copied" << std::endl;
+    for (size_t size = options.min_size; size <= options.max_size; size *= 10) {
+        run_type<int>("int", options, size, results);
+        run_type<Pod64>("Pod64", options, size, results);
+        run_type<std::string>("string", options, size, results);
+    }
+    if (!options.json_path.empty()) {
+        write_json(options.json_path, results);
+    }
+    return 0;
+}
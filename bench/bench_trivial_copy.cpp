@@ -0,0 +1,82 @@
+/**
+\file 
+\brief Benchmark of bulk memory paths for trivially copyable element types.
+ Times the element by element and the memcpy/memmove variants of the 
+ relocation helpers used by Vector on the same prefaulted buffers.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <type_traits>
+
+#include "smart_array.hpp"
+
+/**
+\brief Returns the best time in milliseconds of several runs of given function.
+\param f Function to measure.
+*/
+template <typename F>
+double best_ms(F f)
+{
+    const int runs = 5;
+    double best = 0;
+
+    for (int i = 0; i < runs; ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::milli> d = std::chrono::steady_clock::now() - start;
+        if (0 == i || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+/**
+\brief Measures copy and one slot shifts of given number of ints with both dispatch tags.
+\param size Number of elements.
+*/
+void run(size_t size)
+{
+    tasks::Vector<int> source(size, 1);
+    tasks::Vector<int> target(size + 1, 0);
+    int *src = &source[0];
+    int *dst = &target[0];
+    std::false_type loop;
+    std::true_type bulk;
+
+    double copy_loop = best_ms([&] { tasks::copy(dst, src, dst + size, loop); });
+    double copy_bulk = best_ms([&] { tasks::copy(dst, src, dst + size, bulk); });
+    double shift_loop = best_ms([&] { tasks::shift_right(dst, dst + size, loop); 
+                                      tasks::shift_left(dst, dst + size + 1, loop); });
+    double shift_bulk = best_ms([&] { tasks::shift_right(dst, dst + size, bulk); 
+                                      tasks::shift_left(dst, dst + size + 1, bulk); });
+    double vec_copy = best_ms([&] { tasks::Vector<int> copy(source); });
+
+    std::cout << std::setw(10) << size 
+              << std::setw(12) << copy_loop << std::setw(12) << copy_bulk 
+              << std::setw(12) << shift_loop << std::setw(12) << shift_bulk 
+              << std::setw(14) << vec_copy << std::endl;
+}
+
+/**
+\brief Runs the benchmark for 1M and 100M elements or for sizes given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t sizes[] = { 1000000, 100000000 };
+    int count = argc > 1 ? argc - 1 : 2;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(10) << "elements" 
+              << std::setw(12) << "copy loop" << std::setw(12) << "copy bulk"
+              << std::setw(12) << "shift loop" << std::setw(12) << "shift bulk" 
+              << std::setw(14) << "Vector(copy)" << "  (ms)" << std::endl;
+
+    for (int i = 0; i < count; ++i) {
+        run(argc > 1 ? std::strtoul(argv[i + 1], 0, 10) : sizes[i]);
+    }
+    return 0;
+}
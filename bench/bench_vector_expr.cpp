@@ -0,0 +1,171 @@
+/**
+\file
+\brief a = b * 2 + c - d and the dot product of b and c over Vector<double>, computed with
+ a vector temporary per operation, with a hand written loop and with the fused expressions
+ of vector_expr.hpp on each instruction set. Runs on cache resident vectors, evaluated
+ many times, and on large ones.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+#include "vector_algorithms.hpp"
+#include "vector_expr.hpp"
+
+///Sink for results.
+static volatile double sink;
+
+typedef std::chrono::steady_clock Clock;
+typedef tasks::Vector<double> Doubles;
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+///Returns a new vector of elements of vec multiplied by factor.
+Doubles naive_scale(const Doubles &vec, double factor)
+{
+    Doubles result(vec.size());
+    for (size_t i = 0; i < vec.size(); ++i) {
+        result[i] = vec[i] * factor;
+    }
+    return result;
+}
+
+///Returns a new vector of sums, or of differences if sign is -1, of elements of left and right.
+Doubles naive_add(const Doubles &left, const Doubles &right, double sign)
+{
+    Doubles result(left.size());
+    for (size_t i = 0; i < left.size(); ++i) {
+        result[i] = left[i] + sign * right[i];
+    }
+    return result;
+}
+
+///Returns a new vector of products of elements of left and right.
+Doubles naive_multiply(const Doubles &left, const Doubles &right)
+{
+    Doubles result(left.size());
+    for (size_t i = 0; i < left.size(); ++i) {
+        result[i] = left[i] * right[i];
+    }
+    return result;
+}
+
+///Prints a row of the result table, times per element in nanoseconds.
+void print_row(const char *name, const char *isa, double small_ns, double large_ns)
+{
+    std::cout << std::setw(22) << name << std::setw(8) << isa << std::setw(12) << small_ns << std::setw(12)
+              << large_ns << std::endl;
+}
+
+/**
+\brief Measures one method on the small and the large vectors.
+ Fn takes the vectors a, b, c, d.
+*/
+struct Runner
+{
+    Doubles small[4];
+    Doubles large[4];
+    int passes;
+    int repeats;
+
+    template <typename Fn>
+    void row(const char *name, const char *isa, Fn fn)
+    {
+        double small_ms = best_time([&] {
+            for (int p = 0; p < passes; ++p) {
+                fn(small[0], small[1], small[2], small[3]);
+            }
+        }, repeats);
+        double large_ms = best_time([&] { fn(large[0], large[1], large[2], large[3]); }, repeats);
+
+        print_row(name, isa, small_ms * 1e6 / (double(small[0].size()) * passes), large_ms * 1e6 / large[0].size());
+    }
+};
+
+/**
+\brief Runs the benchmark. Size of the large vectors and repeats may be given as arguments.
+*/
+int main(int argc, char **argv)
+{
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+    const size_t small_size = 1024;
+
+    Runner runner;
+    runner.passes = 10000;
+    runner.repeats = repeats;
+    for (int v = 0; v < 4; ++v) {
+        runner.small[v].resize(small_size);
+        runner.large[v].resize(size);
+        for (size_t i = 0; i < small_size; ++i) {
+            runner.small[v][i] = std::rand() % 1000 / 10.0;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            runner.large[v][i] = std::rand() % 1000 / 10.0;
+        }
+    }
+
+    std::cout << "ns per element, " << small_size << " and " << size << " doubles\n" << std::fixed
+              << std::setprecision(3) << std::setw(22) << "a = b * 2 + c - d" << std::setw(8) << "isa"
+              << std::setw(12) << "small" << std::setw(12) << "large" << std::endl;
+    runner.row("temporary per op", "-", [](Doubles &a, const Doubles &b, const Doubles &c, const Doubles &d) {
+        a = naive_add(naive_add(naive_scale(b, 2), c, 1), d, -1);
+    });
+    runner.row("hand written loop", "-", [](Doubles &a, const Doubles &b, const Doubles &c, const Doubles &d) {
+        double *a_ptr = a.data();
+        const double *b_ptr = b.data(), *c_ptr = c.data(), *d_ptr = d.data();
+        for (size_t i = 0; i < a.size(); ++i) {
+            a_ptr[i] = b_ptr[i] * 2 + c_ptr[i] - d_ptr[i];
+        }
+    });
+    const char *names[] = { "scalar", "sse2", "avx2" };
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        runner.row("expression", names[isa], [](Doubles &a, const Doubles &b, const Doubles &c, const Doubles &d) {
+            a = b * 2 + c - d;
+        });
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+
+    std::cout << std::setw(22) << "dot(b, c)" << std::endl;
+    runner.row("temporary and sum", "-", [](Doubles &, const Doubles &b, const Doubles &c, const Doubles &) {
+        sink = tasks::sum(naive_multiply(b, c));
+    });
+    runner.row("hand written loop", "-", [](Doubles &, const Doubles &b, const Doubles &c, const Doubles &) {
+        const double *b_ptr = b.data(), *c_ptr = c.data();
+        double total = 0;
+        for (size_t i = 0; i < b.size(); ++i) {
+            total += b_ptr[i] * c_ptr[i];
+        }
+        sink = total;
+    });
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        runner.row("dot", names[isa], [](Doubles &, const Doubles &b, const Doubles &c, const Doubles &) {
+            sink = tasks::expr::dot(b, c);
+        });
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+\file
+\brief Compares static chunking of parallel::for_each with the work-stealing parallel_for
+ on a skewed workload: a Vector<std::string> whose long records are packed into its first
+ eighth, hashing each record. Static chunks holding the long records finish last,
+ stealing spreads them over all threads.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "smart_array.hpp"
+#include "parallel.hpp"
+#include "work_stealing.hpp"
+
+typedef std::chrono::steady_clock Clock;
+
+///Hashes the record a few times, the cost grows with its length.
+static uint64_t work(const std::string &record)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (int round = 0; round < 4; ++round) {
+        for (size_t i = 0; i < record.size(); ++i) {
+            hash = (hash ^ static_cast<unsigned char>(record[i])) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+/**
+\brief Returns the best time in milliseconds of given number of runs of fn.
+*/
+template <typename Fn>
+double best_time(Fn fn, int repeats)
+{
+    double best = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        if (!r || d.count() < best) {
+            best = d.count();
+        }
+    }
+    return best;
+}
+
+/**
+\brief Runs the benchmark. Number of records, repeats and the largest pool may be
+ given as arguments, the largest pool defaults to the hardware concurrency.
+*/
+int main(int argc, char **argv)
+{
+    using namespace tasks;
+
+    size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 200000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+    size_t max_threads = argc > 3 ? std::strtoul(argv[3], 0, 10)
+                                  : std::max(1u, std::thread::hardware_concurrency());
+    const size_t grain = 16;
+
+    Vector<std::string> records;
+    records.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        bool heavy = i < size / 8 && 0 == i % 8;
+        records.push_back(std::string(heavy ? 4096 : 16, char('a' + i % 26)));
+    }
+    Vector<uint64_t> hashes(size);
+    uint64_t *hashes_ptr = &hashes[0];
+    const std::string *records_ptr = &records[0];
+
+    std::cout << "ms, " << size << " records, heavy records in the first eighth\n"
+              << std::fixed << std::setprecision(2) << std::setw(9) << "threads" << std::setw(12) << "static"
+              << std::setw(12) << "stealing" << std::setw(12) << "speedup" << std::endl;
+    for (size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        parallel::Thread_pool pool(threads);
+        parallel::Work_stealing_scheduler scheduler(threads);
+
+        double chunked = best_time([&] {
+            parallel::for_each(records.begin(), records.end(), [&](const std::string &record) {
+                hashes_ptr[&record - records_ptr] = work(record);
+            }, pool);
+        }, repeats);
+        double stealing = best_time([&] {
+            parallel::parallel_for(records, grain, [&](const std::string &record) {
+                hashes_ptr[&record - records_ptr] = work(record);
+            }, scheduler);
+        }, repeats);
+
+        std::cout << std::setw(9) << threads << std::setw(12) << chunked << std::setw(12) << stealing
+                  << std::setw(11) << chunked / stealing << "x" << std::endl;
+        if (threads >= max_threads) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,211 @@
+/**
+\file 
+\brief File contains monotonic Arena and Arena_allocator for Vector.
+*/
+
+#ifndef _ARENA_ALLOCATOR_HPP_
+#define _ARENA_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace tasks {
+
+    /**
+    \brief Monotonic memory arena. 
+     Memory is handed out by bumping a pointer inside chunks obtained from operator new,
+     single deallocations do nothing. All memory is recycled at once by reset(), 
+     which must be called only when no object allocated from the arena is alive.
+    */
+    class Arena
+    {
+    public:
+        explicit Arena(size_t chunk_size = 64 * 1024);
+        ~Arena();
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        void *allocate(size_t bytes, size_t alignment);
+        void reset();
+        size_t capacity() const;
+
+    private:
+        /**
+        \brief Header placed at the start of every chunk.
+        */
+        struct Chunk
+        {
+            ///Previously allocated chunk.
+            Chunk *next;
+            ///Size of the chunk in bytes including the header.
+            size_t size;
+        };
+
+        ///Most recently allocated chunk, the one being bumped.
+        Chunk *m_chunks;
+        ///Next free byte of the current chunk.
+        char *m_cur_ptr;
+        ///End of the current chunk.
+        char *m_end_ptr;
+        ///Size of the next chunk to allocate.
+        size_t m_chunk_size;
+
+        void add_chunk(size_t min_bytes);
+    };
+
+    /**
+    \brief Constructor. No memory is allocated until the first request.
+    \param chunk_size Size of the first chunk in bytes, following chunks double it.
+    */
+    inline Arena::Arena(size_t chunk_size) 
+        : m_chunks(0), m_cur_ptr(0), m_end_ptr(0), m_chunk_size(chunk_size)
+    {
+
+    }
+
+    ///Destructor. Frees all chunks.
+    inline Arena::~Arena()
+    {
+        while (m_chunks) {
+            Chunk *next = m_chunks->next;
+            ::operator delete(m_chunks);
+            m_chunks = next;
+        }
+    }
+
+    /**
+    \brief Allocates memory from the current chunk, adding a new chunk if it does not fit.
+    \param bytes Number of bytes.
+    \param alignment Required alignment, must be a power of two.
+    \return Pointer to allocated memory.
+    */
+    inline void *Arena::allocate(size_t bytes, size_t alignment)
+    {
+        uintptr_t cur = reinterpret_cast<uintptr_t>(m_cur_ptr);
+        uintptr_t aligned = (cur + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+        if (!m_cur_ptr || aligned + bytes > reinterpret_cast<uintptr_t>(m_end_ptr)) {
+            add_chunk(bytes + alignment);
+            cur = reinterpret_cast<uintptr_t>(m_cur_ptr);
+            aligned = (cur + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        }
+        m_cur_ptr = reinterpret_cast<char *>(aligned + bytes);
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    /**
+    \brief Recycles all memory. Keeps only the newest (largest) chunk, 
+     so a steady workload stops allocating after the first rounds.
+    */
+    inline void Arena::reset()
+    {
+        if (!m_chunks) {
+            return;
+        }
+        Chunk *old = m_chunks->next;
+
+        while (old) {
+            Chunk *next = old->next;
+            ::operator delete(old);
+            old = next;
+        }
+        m_chunks->next = 0;
+        m_cur_ptr = reinterpret_cast<char *>(m_chunks + 1);
+        m_end_ptr = reinterpret_cast<char *>(m_chunks) + m_chunks->size;
+    }
+
+    ///Returns total size of chunks owned by the arena in bytes.
+    inline size_t Arena::capacity() const
+    {
+        size_t total = 0;
+
+        for (Chunk *chunk = m_chunks; chunk; chunk = chunk->next) {
+            total += chunk->size;
+        }
+        return total;
+    }
+
+    /**
+    \brief Allocates a new current chunk of at least given size.
+    \param min_bytes Number of usable bytes the chunk must provide.
+    */
+    inline void Arena::add_chunk(size_t min_bytes)
+    {
+        size_t size = m_chunk_size;
+
+        while (size < min_bytes + sizeof(Chunk)) {
+            size *= 2;
+        }
+        Chunk *chunk = static_cast<Chunk *>(::operator new(size));
+        chunk->next = m_chunks;
+        chunk->size = size;
+        m_chunks = chunk;
+        m_cur_ptr = reinterpret_cast<char *>(chunk + 1);
+        m_end_ptr = reinterpret_cast<char *>(chunk) + size;
+        m_chunk_size = size * 2;
+    }
+
+    /**
+    \brief Standard allocator drawing memory from an Arena. 
+     Copies share the arena, deallocate does nothing.
+    */
+    template <typename T>
+    class Arena_allocator
+    {
+        template <typename U>
+        friend class Arena_allocator;
+
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        ///Constructor. The arena must outlive the allocator and all memory taken from it.
+        Arena_allocator(Arena &arena) : m_arena_ptr(&arena) { }
+        ///Converting constructor used for rebinding.
+        template <typename U>
+        Arena_allocator(const Arena_allocator<U> &other) : m_arena_ptr(other.m_arena_ptr) { }
+
+        /**
+        \brief Allocates memory for given number of objects.
+        \param count Number of objects.
+        \return Pointer to allocated memory.
+         Throws std::bad_array_new_length if the size in bytes does not fit in size_t.
+        */
+        T *allocate(size_t count)
+        {
+            if (count > SIZE_MAX / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(m_arena_ptr->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        ///Does nothing, memory is recycled by Arena::reset().
+        void deallocate(T *, size_t) { }
+
+        ///Returns the arena of the allocator.
+        Arena &arena() const { return *m_arena_ptr; }
+
+        ///Allocators are equal if they share the arena.
+        template <typename U>
+        bool operator==(const Arena_allocator<U> &other) const
+        {
+            return m_arena_ptr == other.m_arena_ptr;
+        }
+
+        ///Allocators are not equal if they use different arenas.
+        template <typename U>
+        bool operator!=(const Arena_allocator<U> &other) const
+        {
+            return m_arena_ptr != other.m_arena_ptr;
+        }
+
+    private:
+        ///Arena memory is taken from.
+        Arena *m_arena_ptr;
+    };
+}
+
+#endif
@@ -0,0 +1,305 @@
+/**
+\file
+\brief File contains definition of Bit_vector class, a vector of flags packed 64 per word.
+*/
+
+#ifndef _BIT_VECTOR_HPP_
+#define _BIT_VECTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector of bools storing 64 flags per uint64_t word of a Vector.
+     Bit i is bit i % 64 of word i / 64, bits past the size are kept zero.
+     Elements are accessed through proxy references. count, the bitwise operators
+     and comparison work a word or a SIMD register at a time (see simd_kernels.hpp).
+    */
+    class Bit_vector
+    {
+    public:
+        typedef bool value_type;
+        typedef size_t size_type;
+        typedef uint64_t word_type;
+        ///Number of flags in a word.
+        static const size_type word_bits = 64;
+
+        /**
+        \brief Proxy reference to a flag.
+        */
+        class Reference
+        {
+        public:
+            ///Constructor of reference to the bits of word selected by mask.
+            Reference(word_type *word_ptr, word_type mask) : m_word_ptr(word_ptr), m_mask(mask) { }
+            Reference(const Reference &) = default;
+
+            operator bool() const { return 0 != (*m_word_ptr & m_mask); }
+            bool operator~() const { return !bool(*this); }
+            const Reference &operator=(bool value) const
+            {
+                *m_word_ptr = value ? *m_word_ptr | m_mask : *m_word_ptr & ~m_mask;
+                return *this;
+            }
+            ///Assigns the referred flag.
+            const Reference &operator=(const Reference &other) const { return *this = bool(other); }
+            ///Inverts the flag.
+            void flip() const { *m_word_ptr ^= m_mask; }
+
+            ///Swaps two flags.
+            friend void swap(Reference left, Reference right)
+            {
+                bool value = left;
+                left = bool(right);
+                right = value;
+            }
+
+        private:
+            word_type *m_word_ptr;
+            word_type m_mask;
+        };
+
+        typedef Reference reference;
+        typedef bool const_reference;
+        typedef Indexed_iterator<Bit_vector, Reference> iterator;
+        typedef Indexed_iterator<const Bit_vector, bool> const_iterator;
+
+        ///Default constructor.
+        Bit_vector() : v_size(0) {}
+        ///Constructor of size flags of given value.
+        explicit Bit_vector(size_type size, bool value = false) : v_size(0) { resize(size, value); }
+
+        bool operator==(const Bit_vector &vec) const
+        {
+            return v_size == vec.v_size && (v_words.empty() || simd::equal(&v_words[0], &vec.v_words[0], word_count()));
+        }
+        bool operator!=(const Bit_vector &vec) const { return !(*this == vec); }
+        reference operator[](size_type i) { return reference(&v_words[i / word_bits], mask(i)); }
+        const_reference operator[](size_type i) const { return test(i); }
+        reference at(size_type i);
+        const_reference at(size_type i) const;
+        ///Returns flag i.
+        bool test(size_type i) const { return 0 != (v_words[i / word_bits] & mask(i)); }
+        ///Sets flag i to value.
+        void set(size_type i, bool value = true) { (*this)[i] = value; }
+        ///Clears flag i.
+        void reset(size_type i) { v_words[i / word_bits] &= ~mask(i); }
+        ///Inverts flag i.
+        void flip(size_type i) { v_words[i / word_bits] ^= mask(i); }
+        void flip();
+        reference front() { return (*this)[0]; }
+        reference back() { return (*this)[v_size - 1]; }
+        bool front() const { return test(0); }
+        bool back() const { return test(v_size - 1); }
+
+        void push_back(bool);
+        void pop_back();
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, v_size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, v_size); }
+        bool empty() const { return 0 == v_size; }
+        size_type size() const { return v_size; }
+        ///Returns number of flags the words can hold before reallocating.
+        size_type capacity() const { return v_words.capacity() * word_bits; }
+        void reserve(size_type bits) { v_words.reserve((bits + word_bits - 1) / word_bits); }
+        void resize(size_type, bool = false);
+        void clear() { v_words.clear(); v_size = 0; }
+        void swap(Bit_vector &other) noexcept { v_words.swap(other.v_words); std::swap(v_size, other.v_size); }
+
+        ///Returns number of words holding the flags.
+        size_type word_count() const { return v_words.size(); }
+        ///Returns pointer to the words, null if there are none.
+        const word_type *data() const { return words(); }
+
+        size_type count() const;
+        ///Checks if any flag is set.
+        bool any() const { return find_first() != v_size; }
+        ///Checks if no flag is set.
+        bool none() const { return !any(); }
+        ///Checks if every flag is set.
+        bool all() const { return count() == v_size; }
+        size_type find_first() const { return find_next_from(0); }
+        size_type find_next(size_type i) const { return find_next_from(i + 1); }
+
+        Bit_vector &operator&=(const Bit_vector &);
+        Bit_vector &operator|=(const Bit_vector &);
+        Bit_vector &operator^=(const Bit_vector &);
+        Bit_vector operator~() const;
+
+    private:
+        ///Words holding the flags.
+        Vector<word_type> v_words;
+        ///Number of flags.
+        size_type v_size;
+
+        static word_type mask(size_type i) { return word_type(1) << i % word_bits; }
+        word_type *words() { return v_words.empty() ? 0 : &v_words[0]; }
+        const word_type *words() const { return v_words.empty() ? 0 : &v_words[0]; }
+        void clear_tail();
+        void check_size(const Bit_vector &) const;
+        size_type find_next_from(size_type) const;
+    };
+
+    /**
+    \brief Returns reference to flag i. Throws std::out_of_range if i is not less than size.
+    */
+    inline Bit_vector::reference Bit_vector::at(size_type i)
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Returns flag i. Throws std::out_of_range if i is not less than size.
+    */
+    inline Bit_vector::const_reference Bit_vector::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return test(i);
+    }
+
+    ///Inverts every flag.
+    inline void Bit_vector::flip()
+    {
+        simd::bit_not(words(), word_count());
+        clear_tail();
+    }
+
+    ///Appends a flag, adding a word when the last one is full.
+    inline void Bit_vector::push_back(bool value)
+    {
+        if (v_size == word_count() * word_bits) {
+            v_words.push_back(0);
+        }
+        if (value) {
+            v_words[v_size / word_bits] |= mask(v_size);
+        }
+        ++v_size;
+    }
+
+    ///Removes the last flag.
+    inline void Bit_vector::pop_back()
+    {
+        if (v_size) {
+            --v_size;
+            reset(v_size);
+            if (v_size == (word_count() - 1) * word_bits) {
+                v_words.pop_back();
+            }
+        }
+    }
+
+    /**
+    \brief Changes the number of flags. Works like std::vector::resize().
+    \param new_size Number of flags.
+    \param value Value of appended flags.
+    */
+    inline void Bit_vector::resize(size_type new_size, bool value)
+    {
+        size_type old_size = v_size;
+        size_type old_words = word_count();
+
+        v_words.resize((new_size + word_bits - 1) / word_bits, value ? ~word_type(0) : 0);
+        v_size = new_size;
+        if (value && new_size > old_size && old_size % word_bits) {
+            v_words[old_words - 1] |= ~word_type(0) << old_size % word_bits;
+        }
+        clear_tail();
+    }
+
+    ///Returns number of set flags.
+    inline Bit_vector::size_type Bit_vector::count() const
+    {
+        return simd::popcount(words(), word_count());
+    }
+
+    ///Keeps flags set in both vectors. Throws std::invalid_argument if sizes differ.
+    inline Bit_vector &Bit_vector::operator&=(const Bit_vector &vec)
+    {
+        check_size(vec);
+        simd::bit_and(words(), vec.words(), word_count());
+        return *this;
+    }
+
+    ///Sets flags set in vec. Throws std::invalid_argument if sizes differ.
+    inline Bit_vector &Bit_vector::operator|=(const Bit_vector &vec)
+    {
+        check_size(vec);
+        simd::bit_or(words(), vec.words(), word_count());
+        return *this;
+    }
+
+    ///Inverts flags set in vec. Throws std::invalid_argument if sizes differ.
+    inline Bit_vector &Bit_vector::operator^=(const Bit_vector &vec)
+    {
+        check_size(vec);
+        simd::bit_xor(words(), vec.words(), word_count());
+        return *this;
+    }
+
+    ///Returns copy with every flag inverted.
+    inline Bit_vector Bit_vector::operator~() const
+    {
+        Bit_vector result(*this);
+        result.flip();
+        return result;
+    }
+
+    ///Zeroes bits of the last word past the size.
+    inline void Bit_vector::clear_tail()
+    {
+        if (v_size % word_bits) {
+            v_words[word_count() - 1] &= ~(~word_type(0) << v_size % word_bits);
+        }
+    }
+
+    ///Throws std::invalid_argument if sizes of the vectors differ.
+    inline void Bit_vector::check_size(const Bit_vector &vec) const
+    {
+        if (v_size != vec.v_size) {
+            throw std::invalid_argument("Bit_vector sizes differ.");
+        }
+    }
+
+    /**
+    \brief Returns index of the first set flag not less than i, size if there is none.
+    */
+    inline Bit_vector::size_type Bit_vector::find_next_from(size_type i) const
+    {
+        if (i >= v_size) {
+            return v_size;
+        }
+        size_type w = i / word_bits;
+        word_type word = v_words[w] & (~word_type(0) << i % word_bits);
+
+        while (!word) {
+            if (++w == word_count()) {
+                return v_size;
+            }
+            word = v_words[w];
+        }
+        return w * word_bits + __builtin_ctzll(word);
+    }
+
+    ///Returns flags set in both vectors.
+    inline Bit_vector operator&(Bit_vector left, const Bit_vector &right) { left &= right; return left; }
+    ///Returns flags set in either vector.
+    inline Bit_vector operator|(Bit_vector left, const Bit_vector &right) { left |= right; return left; }
+    ///Returns flags set in exactly one vector.
+    inline Bit_vector operator^(Bit_vector left, const Bit_vector &right) { left ^= right; return left; }
+}
+
+#endif
@@ -0,0 +1,362 @@
+/**
+\file
+\brief File contains definition of template Concurrent_vector class, a vector many
+ threads can append to at once. Elements live in segments of 8, 16, 32, ... elements
+ which are never moved, so appending does not invalidate references.
+*/
+
+#ifndef _CONCURRENT_VECTOR_HPP_
+#define _CONCURRENT_VECTOR_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "smart_array.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector supporting concurrent push_back, emplace_back and grow_by.
+     An append allocates the segments missing for the next indices (the thread losing
+     a race frees its copy), claims the indices with a compare-and-swap of the size
+     counter, retrying if another append claimed them first, and constructs the
+     elements in place. A length or allocation error is thrown before the claim and
+     leaves the size unchanged. An element is published once it is constructed:
+     published() tells whether element i may be read, operator[] reads elements known
+     to be published. Elements whose construction threw stay unpublished.
+     clear and destruction must not run concurrently with other calls, and the
+     allocator must be safe to use from many threads.
+    */
+    template <typename T, typename Allocator = std::allocator<T> >
+    class Concurrent_vector
+    {
+        typedef std::allocator_traits<Allocator> alloc_traits;
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef Allocator allocator_type;
+
+        Concurrent_vector() : m_size(0), m_alloc() { init_segments(); }
+        explicit Concurrent_vector(const Allocator &alloc) : m_size(0), m_alloc(alloc) { init_segments(); }
+        ~Concurrent_vector(void) { clear(); }
+
+        size_type push_back(const T &value) { return emplace_back(value); }
+        size_type push_back(T &&value) { return emplace_back(std::move(value)); }
+        template <typename... Args>
+        size_type emplace_back(Args &&... args);
+        size_type grow_by(size_type count, const T &value = T());
+
+        ///Returns whether element i is constructed and may be read.
+        bool published(size_type i) const
+        {
+            Segment *segment_ptr = i < m_size.load(std::memory_order_acquire) ? segment(i) : 0;
+            return segment_ptr && segment_ptr->ready[offset(i)].load(std::memory_order_acquire);
+        }
+
+        ///Returns element i, which must be published.
+        T &operator[](size_type i) { return segment(i)->items[offset(i)]; }
+        ///Returns element i, which must be published.
+        const T &operator[](size_type i) const { return segment(i)->items[offset(i)]; }
+        T &at(size_type i);
+        const T &at(size_type i) const;
+
+        ///Returns number of claimed indices, elements below it may still be under construction.
+        size_type size() const { return m_size.load(std::memory_order_acquire); }
+        bool empty() const { return 0 == size(); }
+        size_type capacity() const;
+        void reserve(size_type count);
+        void clear();
+
+        template <typename Growth>
+        void to_vector(Vector<T, Allocator, Growth> &vec) const;
+        Vector<T, Allocator> to_vector() const;
+
+        ///Number of elements of the first segment.
+        static const size_type first_segment = 8;
+        ///Number of segments, enough to cover every index.
+        static const size_type max_segments = 8 * sizeof(size_type) - 3;
+
+    private:
+        Concurrent_vector(const Concurrent_vector &);
+        Concurrent_vector &operator=(const Concurrent_vector &);
+
+        ///Elements of a segment and their publication flags.
+        struct Segment
+        {
+            T *items;
+            std::atomic<bool> *ready;
+        };
+
+        void init_segments()
+        {
+            for (size_type k = 0; k < max_segments; ++k) {
+                m_segments[k].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        ///Returns index of the segment holding element i.
+        static size_type segment_index(size_type i)
+        {
+            return 8 * sizeof(unsigned long long) - 1 - __builtin_clzll(i + first_segment) - 3;
+        }
+        ///Returns index of the first element of segment k.
+        static size_type segment_base(size_type k) { return (first_segment << k) - first_segment; }
+        ///Returns number of elements of segment k.
+        static size_type segment_size(size_type k) { return first_segment << k; }
+        ///Returns number of indices the segments cover.
+        static size_type max_index() { return segment_base(max_segments - 1) + segment_size(max_segments - 1); }
+        ///Returns position of element i in its segment.
+        static size_type offset(size_type i) { return i - segment_base(segment_index(i)); }
+
+        Segment *segment(size_type i) const
+        {
+            return m_segments[segment_index(i)].load(std::memory_order_acquire);
+        }
+
+        Segment *ensure_segment(size_type k);
+        void ensure_range(size_type first, size_type count);
+        size_type claim(size_type count);
+        void free_segment(Segment *segment_ptr, size_type k);
+
+        ///Number of claimed indices.
+        std::atomic<size_type> m_size;
+        std::atomic<Segment *> m_segments[max_segments];
+        ///Allocator providing the storage of elements.
+        Allocator m_alloc;
+    };
+
+    template <typename T, typename Allocator>
+    const typename Concurrent_vector<T, Allocator>::size_type Concurrent_vector<T, Allocator>::first_segment;
+
+    template <typename T, typename Allocator>
+    const typename Concurrent_vector<T, Allocator>::size_type Concurrent_vector<T, Allocator>::max_segments;
+
+    /**
+    \brief Appends an element constructed from args. Safe to call from many threads.
+     Throws std::length_error if no index is left.
+    \param args Arguments of the element constructor.
+    \return Index of the new element.
+    */
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    typename Concurrent_vector<T, Allocator>::size_type Concurrent_vector<T, Allocator>::emplace_back(Args &&... args)
+    {
+        size_type i = claim(1);
+        Segment *segment_ptr = segment(i);
+        alloc_traits::construct(m_alloc, segment_ptr->items + offset(i), std::forward<Args>(args)...);
+        segment_ptr->ready[offset(i)].store(true, std::memory_order_release);
+        return i;
+    }
+
+    /**
+    \brief Appends count copies of value as one block of consecutive indices.
+     Safe to call from many threads. Throws std::length_error if no block of count indices is left.
+    \param count Number of elements.
+    \param value Value to copy.
+    \return Index of the first new element.
+    */
+    template <typename T, typename Allocator>
+    typename Concurrent_vector<T, Allocator>::size_type Concurrent_vector<T, Allocator>::grow_by(size_type count,
+                                                                                                 const T &value)
+    {
+        size_type first = claim(count);
+
+        for (size_type i = first; i < first + count; ++i) {
+            Segment *segment_ptr = segment(i);
+            alloc_traits::construct(m_alloc, segment_ptr->items + offset(i), value);
+            segment_ptr->ready[offset(i)].store(true, std::memory_order_release);
+        }
+        return first;
+    }
+
+    /**
+    \brief Returns element i. Throws std::out_of_range if it is not published.
+    */
+    template <typename T, typename Allocator>
+    T &Concurrent_vector<T, Allocator>::at(size_type i)
+    {
+        if (!published(i)) {
+            throw std::out_of_range("Concurrent_vector element is not published.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Returns element i. Throws std::out_of_range if it is not published.
+    */
+    template <typename T, typename Allocator>
+    const T &Concurrent_vector<T, Allocator>::at(size_type i) const
+    {
+        if (!published(i)) {
+            throw std::out_of_range("Concurrent_vector element is not published.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Returns number of elements the allocated segments hold.
+    */
+    template <typename T, typename Allocator>
+    typename Concurrent_vector<T, Allocator>::size_type Concurrent_vector<T, Allocator>::capacity() const
+    {
+        size_type total = 0;
+
+        for (size_type k = 0; k < max_segments; ++k) {
+            if (m_segments[k].load(std::memory_order_acquire)) {
+                total += segment_size(k);
+            }
+        }
+        return total;
+    }
+
+    /**
+    \brief Allocates segments holding the first count elements.
+    */
+    template <typename T, typename Allocator>
+    void Concurrent_vector<T, Allocator>::reserve(size_type count)
+    {
+        if (count) {
+            ensure_range(0, count);
+        }
+    }
+
+    /**
+    \brief Destroys published elements and frees every segment.
+    */
+    template <typename T, typename Allocator>
+    void Concurrent_vector<T, Allocator>::clear()
+    {
+        for (size_type k = 0; k < max_segments; ++k) {
+            Segment *segment_ptr = m_segments[k].load(std::memory_order_acquire);
+            if (segment_ptr) {
+                free_segment(segment_ptr, k);
+                m_segments[k].store(0, std::memory_order_relaxed);
+            }
+        }
+        m_size.store(0, std::memory_order_release);
+    }
+
+    /**
+    \brief Copies published elements in index order into vec, replacing its contents.
+     Meant to run after the appending threads are done, elements still under
+     construction are skipped.
+    \param vec Destination vector.
+    */
+    template <typename T, typename Allocator>
+    template <typename Growth>
+    void Concurrent_vector<T, Allocator>::to_vector(Vector<T, Allocator, Growth> &vec) const
+    {
+        size_type count = size();
+
+        vec.clear();
+        vec.reserve(count);
+        for (size_type k = 0; k < max_segments && segment_base(k) < count; ++k) {
+            Segment *segment_ptr = m_segments[k].load(std::memory_order_acquire);
+            size_type end = std::min(segment_size(k), count - segment_base(k));
+            for (size_type j = 0; segment_ptr && j < end; ++j) {
+                if (segment_ptr->ready[j].load(std::memory_order_acquire)) {
+                    vec.push_back(segment_ptr->items[j]);
+                }
+            }
+        }
+    }
+
+    /**
+    \brief Returns the published elements compacted into a Vector.
+    */
+    template <typename T, typename Allocator>
+    Vector<T, Allocator> Concurrent_vector<T, Allocator>::to_vector() const
+    {
+        Vector<T, Allocator> vec(m_alloc);
+        to_vector(vec);
+        return vec;
+    }
+
+    /**
+    \brief Returns segment k, allocating it if no thread did. A thread losing the race
+     to install the segment frees its own.
+    */
+    template <typename T, typename Allocator>
+    typename Concurrent_vector<T, Allocator>::Segment *Concurrent_vector<T, Allocator>::ensure_segment(size_type k)
+    {
+        Segment *segment_ptr = m_segments[k].load(std::memory_order_acquire);
+
+        if (segment_ptr) {
+            return segment_ptr;
+        }
+        std::unique_ptr<Segment> fresh(new Segment());
+        fresh->items = alloc_traits::allocate(m_alloc, segment_size(k));
+        try {
+            fresh->ready = new std::atomic<bool>[segment_size(k)]();
+        } catch (...) {
+            alloc_traits::deallocate(m_alloc, fresh->items, segment_size(k));
+            throw;
+        }
+        if (m_segments[k].compare_exchange_strong(segment_ptr, fresh.get(), std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+            return fresh.release();
+        }
+        alloc_traits::deallocate(m_alloc, fresh->items, segment_size(k));
+        delete[] fresh->ready;
+        return segment_ptr;
+    }
+
+    /**
+    \brief Makes sure segments holding elements [first, first + count) exist.
+     Throws std::length_error if the range exceeds the largest index.
+    */
+    template <typename T, typename Allocator>
+    void Concurrent_vector<T, Allocator>::ensure_range(size_type first, size_type count)
+    {
+        if (count > max_index() || first > max_index() - count) {
+            throw std::length_error("Concurrent_vector is too long.");
+        }
+        for (size_type k = segment_index(first); k <= segment_index(first + count - 1); ++k) {
+            ensure_segment(k);
+        }
+    }
+
+    /**
+    \brief Claims count consecutive indices after allocating their segments.
+     Throws std::length_error if fewer than count indices are left. The size changes
+     only by the successful compare-and-swap, so a throw leaves it as it was.
+    \param count Number of indices.
+    \return First claimed index.
+    */
+    template <typename T, typename Allocator>
+    typename Concurrent_vector<T, Allocator>::size_type Concurrent_vector<T, Allocator>::claim(size_type count)
+    {
+        size_type first = m_size.load(std::memory_order_acquire);
+
+        do {
+            if (count) {
+                ensure_range(first, count);
+            }
+        } while (!m_size.compare_exchange_weak(first, first + count, std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+        return first;
+    }
+
+    /**
+    \brief Destroys published elements of segment k and frees it.
+    */
+    template <typename T, typename Allocator>
+    void Concurrent_vector<T, Allocator>::free_segment(Segment *segment_ptr, size_type k)
+    {
+        for (size_type j = 0; j < segment_size(k); ++j) {
+            if (segment_ptr->ready[j].load(std::memory_order_relaxed)) {
+                alloc_traits::destroy(m_alloc, segment_ptr->items + j);
+            }
+        }
+        alloc_traits::deallocate(m_alloc, segment_ptr->items, segment_size(k));
+        delete[] segment_ptr->ready;
+        delete segment_ptr;
+    }
+}
+
+#endif
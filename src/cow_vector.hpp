@@ -0,0 +1,316 @@
+/**
+\file
+\brief File contains definition of template Cow_vector class, a copy-on-write Vector.
+ Copies share one buffer counted with an atomic reference count, so handing the same
+ data to many readers costs one allocation in total. A vector copies the shared
+ elements on its first mutating call and from then on owns them alone.
+*/
+
+#ifndef _COW_VECTOR_HPP_
+#define _COW_VECTOR_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "smart_array.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector sharing its elements between copies until one of them mutates.
+     Copy construction, assignment and snapshot() share the elements, incrementing the reference count.
+     Const calls read the shared elements. Non-const calls (operator[], at, front, back,
+     begin, end, data, push_back, emplace_back, pop_back, insert, erase, resize, reserve)
+     first copy the elements unless this vector is their only owner.
+     Non-const calls returning a reference, pointer or iterator to an element mark the
+     elements unshareable, later copies of this vector copy them at once, so writing
+     through such a reference never changes a copy. clear() and assignment make the
+     vector shareable again.
+     Different Cow_vector objects sharing a buffer may be used from different threads,
+     one object must not be used from several threads at once if one of them mutates it.
+    */
+    template <typename T, typename Allocator = std::allocator<T>,
+              typename Growth = Geometric_growth<> >
+    class Cow_vector
+    {
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef Allocator allocator_type;
+        typedef Vector<T, Allocator, Growth> vector_type;
+        typedef typename vector_type::iterator iterator;
+        typedef typename vector_type::const_iterator const_iterator;
+
+        ///Default constructor, an empty vector allocates nothing.
+        Cow_vector() : v_shared(0) { }
+        Cow_vector(const size_type count, const T &value = T(), const Allocator &alloc = Allocator())
+            : v_shared(new Shared(vector_type(count, value, alloc))) { }
+        template <typename In>
+        Cow_vector(In first, In last, const Allocator &alloc = Allocator())
+            : v_shared(new Shared(vector_type(first, last, alloc))) { }
+        ///Constructor taking over the elements of vec.
+        explicit Cow_vector(vector_type vec) : v_shared(new Shared(std::move(vec))) { }
+        ///Copy constructor, shares the elements of other unless they are unshareable.
+        Cow_vector(const Cow_vector &other) : v_shared(other.share()) { }
+        ///Move constructor, leaves other empty.
+        Cow_vector(Cow_vector &&other) noexcept : v_shared(other.v_shared) { other.v_shared = 0; }
+        ~Cow_vector(void) { release(); }
+
+        const Cow_vector &operator=(const Cow_vector &right);
+        const Cow_vector &operator=(Cow_vector &&right) noexcept;
+        bool operator==(const Cow_vector &right) const;
+        bool operator!=(const Cow_vector &right) const { return !(*this == right); }
+
+        /**
+        \brief Returns a vector with the current elements, unaffected by later changes of this one.
+         The elements are shared unless a mutable reference to them was handed out.
+        */
+        Cow_vector snapshot() const { return *this; }
+        ///Returns number of vectors sharing the elements, 0 for an empty vector without buffer.
+        size_type use_count() const { return v_shared ? v_shared->refs.load(std::memory_order_acquire) : 0; }
+        ///Returns the elements as a Vector, valid until this vector changes.
+        const vector_type &items() const { return v_shared ? v_shared->items : empty_items(); }
+
+        const T &operator[](const size_type i) const { return v_shared->items[i]; }
+        const T &at(size_type i) const { return items().at(i); }
+        const T &front() const { return v_shared->items.front(); }
+        const T &back() const { return v_shared->items.back(); }
+        const_iterator begin() const { return items().begin(); }
+        const_iterator end() const { return items().end(); }
+        const_iterator cbegin() const { return items().begin(); }
+        const_iterator cend() const { return items().end(); }
+        const T *data() const { return items().data(); }
+        Span<const T> span() const { return items().span(); }
+        size_type size() const { return v_shared ? v_shared->items.size() : 0; }
+        bool empty() const { return 0 == size(); }
+        size_type capacity() const { return v_shared ? v_shared->items.capacity() : 0; }
+
+        T &operator[](const size_type i) { return leak()[i]; }
+        T &at(size_type i) { return leak().at(i); }
+        T &front() { return leak().front(); }
+        T &back() { return leak().back(); }
+        iterator begin() { return leak().begin(); }
+        iterator end() { return leak().end(); }
+        T *data() { return leak().data(); }
+        void push_back(const T &value) { own().push_back(value); }
+        void push_back(T &&value) { own().push_back(std::move(value)); }
+        template <typename... Args>
+        T &emplace_back(Args &&... args) { return leak().emplace_back(std::forward<Args>(args)...); }
+        void pop_back() { own().pop_back(); }
+        iterator insert(const_iterator position, const T &value);
+        iterator insert(const_iterator position, T &&value);
+        iterator erase(const_iterator position);
+        iterator erase(const_iterator first, const_iterator last);
+        void resize(const size_type count, const T &value = T()) { own().resize(count, value); }
+        void reserve(const size_type count) { own().reserve(count); }
+        void clear();
+        ///Exchanges the elements with other, no element is copied.
+        void swap(Cow_vector &other) noexcept { std::swap(v_shared, other.v_shared); }
+
+    private:
+        ///Elements shared by all copies, their number and whether they may be shared.
+        struct Shared
+        {
+            explicit Shared(vector_type &&vec) : refs(1), items(std::move(vec)), unshareable(false) { }
+
+            std::atomic<size_type> refs;
+            vector_type items;
+            ///Set while the only owner may hold mutable references to the elements.
+            bool unshareable;
+        };
+
+        static const vector_type &empty_items()
+        {
+            static const vector_type empty;
+            return empty;
+        }
+
+        Shared *share() const;
+        void release();
+        vector_type &own();
+
+        ///Returns own() for a call handing out mutable references, copies will not share them.
+        vector_type &leak()
+        {
+            vector_type &vec = own();
+
+            v_shared->unshareable = true;
+            return vec;
+        }
+
+        ///Shared elements, null for an empty vector without buffer.
+        Shared *v_shared;
+    };
+
+    /**
+    \brief Assigns given vector, sharing its elements unless they are unshareable.
+    \param right Given vector.
+    \return Changed Cow_vector object.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    const Cow_vector<T, Allocator, Growth> &Cow_vector<T, Allocator, Growth>::operator=(const Cow_vector &right)
+    {
+        if (v_shared != right.v_shared) {
+            Cow_vector temp(right);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    /**
+    \brief Move assigns given vector, leaving it empty.
+    \param right Given vector.
+    \return Changed Cow_vector object.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    const Cow_vector<T, Allocator, Growth> &Cow_vector<T, Allocator, Growth>::operator=(Cow_vector &&right) noexcept
+    {
+        if (this != &right) {
+            release();
+            v_shared = right.v_shared;
+            right.v_shared = 0;
+        }
+        return *this;
+    }
+
+    /**
+    \brief Compares equality of two vectors, vectors sharing elements are equal without comparing them.
+    \param right Vector to compare with.
+    \return true if equal, false if not.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    bool Cow_vector<T, Allocator, Growth>::operator==(const Cow_vector &right) const
+    {
+        return v_shared == right.v_shared || items() == right.items();
+    }
+
+    /**
+    \brief Inserts value before position.
+    \param position Iterator of this vector, taken before the call.
+    \param value Value to insert.
+    \return Iterator to the inserted element.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Cow_vector<T, Allocator, Growth>::iterator
+    Cow_vector<T, Allocator, Growth>::insert(const_iterator position, const T &value)
+    {
+        size_type index = position - cbegin();
+        vector_type &vec = leak();
+
+        return vec.insert(vec.begin() + index, value);
+    }
+
+    /**
+    \brief Inserts value before position.
+    \param position Iterator of this vector, taken before the call.
+    \param value Value to move in.
+    \return Iterator to the inserted element.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Cow_vector<T, Allocator, Growth>::iterator
+    Cow_vector<T, Allocator, Growth>::insert(const_iterator position, T &&value)
+    {
+        size_type index = position - cbegin();
+        vector_type &vec = leak();
+
+        return vec.insert(vec.begin() + index, std::move(value));
+    }
+
+    /**
+    \brief Removes the element at position.
+    \param position Iterator of this vector, taken before the call.
+    \return Iterator to the element after the removed one.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Cow_vector<T, Allocator, Growth>::iterator
+    Cow_vector<T, Allocator, Growth>::erase(const_iterator position)
+    {
+        size_type index = position - cbegin();
+        vector_type &vec = leak();
+
+        return vec.erase(vec.begin() + index);
+    }
+
+    /**
+    \brief Removes elements of [first, last).
+    \param first, last Iterators of this vector, taken before the call.
+    \return Iterator to the element after the removed ones.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Cow_vector<T, Allocator, Growth>::iterator
+    Cow_vector<T, Allocator, Growth>::erase(const_iterator first, const_iterator last)
+    {
+        size_type index = first - cbegin();
+        size_type count = last - first;
+        vector_type &vec = leak();
+
+        return vec.erase(vec.begin() + index, vec.begin() + index + count);
+    }
+
+    /**
+    \brief Removes all elements. Shared elements are left to the other owners without copying.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Cow_vector<T, Allocator, Growth>::clear()
+    {
+        if (1 == use_count()) {
+            v_shared->items.clear();
+            v_shared->unshareable = false;
+        } else {
+            release();
+            v_shared = 0;
+        }
+    }
+
+    /**
+    \brief Returns the elements for a new copy of this vector: the shared ones with one more
+     owner, or a copy of them if they are unshareable.
+    \return Elements of the copy, null for an empty vector without buffer.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Cow_vector<T, Allocator, Growth>::Shared *Cow_vector<T, Allocator, Growth>::share() const
+    {
+        if (!v_shared) {
+            return 0;
+        }
+        if (v_shared->unshareable) {
+            return new Shared(vector_type(v_shared->items));
+        }
+        v_shared->refs.fetch_add(1, std::memory_order_relaxed);
+        return v_shared;
+    }
+
+    /**
+    \brief Drops this owner of the shared elements, the last owner destroys them.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Cow_vector<T, Allocator, Growth>::release()
+    {
+        if (v_shared && 1 == v_shared->refs.fetch_sub(1, std::memory_order_acq_rel)) {
+            delete v_shared;
+        }
+    }
+
+    /**
+    \brief Makes this vector the only owner of its elements, copying them if they are shared.
+     An empty vector without buffer gets a buffer of its own.
+    \return Elements owned by this vector alone.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Cow_vector<T, Allocator, Growth>::vector_type &Cow_vector<T, Allocator, Growth>::own()
+    {
+        if (!v_shared) {
+            v_shared = new Shared(vector_type());
+        } else if (1 != v_shared->refs.load(std::memory_order_acquire)) {
+            Shared *copy_ptr = new Shared(vector_type(v_shared->items));
+
+            release();
+            v_shared = copy_ptr;
+        }
+        return v_shared->items;
+    }
+}
+
+#endif
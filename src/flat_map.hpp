@@ -0,0 +1,423 @@
+/**
+\file
+\brief File contains definitions of template Flat_set and Flat_map classes, sorted
+ associative containers keeping their elements in a Vector.
+*/
+
+#ifndef _FLAT_MAP_HPP_
+#define _FLAT_MAP_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "smart_array.hpp"
+
+namespace tasks {
+
+    ///Key of a set element, the element itself.
+    template <typename T>
+    struct Identity_key
+    {
+        static const T &key(const T &value) { return value; }
+    };
+
+    ///Key of a map element, the first member of the pair.
+    template <typename Pair>
+    struct First_key
+    {
+        static const typename Pair::first_type &key(const Pair &value) { return value.first; }
+    };
+
+    /**
+    \brief Base template class of the flat containers. Elements are kept sorted by key
+     with unique keys in a Vector, lookups are binary searches over contiguous memory.
+     Single insertion and erasure shift the elements after the position, insert_unique
+     adds a batch at the cost of one sort and one merge. Lookup members taking any key
+     type K are available if Compare defines is_transparent, like std::less<>.
+    */
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    class Base_flat_tree
+    {
+    public:
+        typedef Key key_type;
+        typedef Value value_type;
+        typedef size_t size_type;
+        typedef Compare key_compare;
+        typedef Allocator allocator_type;
+        typedef const Value *const_iterator;
+
+        bool operator==(const Base_flat_tree &tree) const { return v_items == tree.v_items; }
+        bool operator!=(const Base_flat_tree &tree) const { return !(*this == tree); }
+
+        bool empty() const { return v_items.empty(); }
+        size_type size() const { return v_items.size(); }
+        size_type capacity() const { return v_items.capacity(); }
+        void reserve(size_type count) { v_items.reserve(count); }
+        void clear() { v_items.clear(); }
+        ///Returns pointer to the sorted elements, null if there are none.
+        const Value *data() const { return v_items.empty() ? 0 : &v_items[0]; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + size(); }
+        key_compare key_comp() const { return v_comp; }
+
+        ///Returns iterator to the element with given key, end() if there is none.
+        const_iterator find(const key_type &key) const { return begin() + find_index(key); }
+        template <typename K, typename C = Compare, typename = typename C::is_transparent>
+        const_iterator find(const K &key) const { return begin() + find_index(key); }
+        ///Checks if an element has given key.
+        bool contains(const key_type &key) const { return find_index(key) != size(); }
+        template <typename K, typename C = Compare, typename = typename C::is_transparent>
+        bool contains(const K &key) const { return find_index(key) != size(); }
+        ///Returns number of elements with given key, 0 or 1.
+        size_type count(const key_type &key) const { return contains(key); }
+        template <typename K, typename C = Compare, typename = typename C::is_transparent>
+        size_type count(const K &key) const { return contains(key); }
+        ///Returns iterator to the first element not ordered before key.
+        const_iterator lower_bound(const key_type &key) const { return begin() + lower_index(key); }
+        template <typename K, typename C = Compare, typename = typename C::is_transparent>
+        const_iterator lower_bound(const K &key) const { return begin() + lower_index(key); }
+        ///Returns iterator to the first element ordered after key.
+        const_iterator upper_bound(const key_type &key) const { return begin() + upper_index(key); }
+        template <typename K, typename C = Compare, typename = typename C::is_transparent>
+        const_iterator upper_bound(const K &key) const { return begin() + upper_index(key); }
+        ///Returns range of elements with given key.
+        std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+        template <typename K, typename C = Compare, typename = typename C::is_transparent>
+        std::pair<const_iterator, const_iterator> equal_range(const K &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        size_type erase(const key_type &);
+        const_iterator erase(const_iterator);
+        template <typename In>
+        void insert_unique(In, In);
+
+    protected:
+        typedef typename Vector<Value, Allocator>::iterator vector_iterator;
+
+        Base_flat_tree(const Compare &comp, const Allocator &alloc) : v_items(alloc), v_comp(comp) { }
+
+        ///Sorted elements.
+        Vector<Value, Allocator> v_items;
+        ///Key ordering.
+        Compare v_comp;
+
+        Value *items() { return v_items.empty() ? 0 : &v_items[0]; }
+        ///Returns Vector iterator to element i.
+        vector_iterator position(size_type i)
+        {
+            vector_iterator iter = v_items.begin();
+            iter += i;
+            return iter;
+        }
+        template <typename K>
+        size_type lower_index(const K &) const;
+        template <typename K>
+        size_type upper_index(const K &) const;
+        template <typename K>
+        size_type find_index(const K &) const;
+        template <typename... Args>
+        std::pair<size_type, bool> emplace_key(const key_type &, Args &&...);
+    };
+
+    /**
+    \brief Erases the element with given key.
+    \return Number of erased elements, 0 or 1.
+    */
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    typename Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::size_type
+    Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::erase(const key_type &key)
+    {
+        size_type i = find_index(key);
+
+        if (i == size()) {
+            return 0;
+        }
+        v_items.erase(position(i));
+        return 1;
+    }
+
+    /**
+    \brief Erases the element at pos.
+    \return Iterator to the element following the erased one.
+    */
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    typename Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::const_iterator
+    Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::erase(const_iterator pos)
+    {
+        size_type i = pos - begin();
+
+        v_items.erase(position(i));
+        return begin() + i;
+    }
+
+    /**
+    \brief Inserts elements of [first, last) whose keys are not present. The elements are
+     appended, the appended part is sorted and merged with the rest in one pass, so a batch
+     costs O(m log m + n) instead of m insertions shifting n elements each. Of equivalent
+     new elements the first one is kept, present elements are never replaced.
+     If copying or sorting the new elements throws they are removed, if the merge throws
+     the container is cleared.
+    \param first, last Input range of elements.
+    */
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    template <typename In>
+    void Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::insert_unique(In first, In last)
+    {
+        size_type old_size = size();
+        const Compare &comp = v_comp;
+        auto less = [&comp](const Value &a, const Value &b) { return comp(Key_of::key(a), Key_of::key(b)); };
+        auto same = [&comp](const Value &a, const Value &b) { return !comp(Key_of::key(a), Key_of::key(b)); };
+        Value *middle_ptr = 0;
+        Value *last_ptr = 0;
+
+        try {
+            v_items.append(first, last);
+            if (size() == old_size) {
+                return;
+            }
+            middle_ptr = items() + old_size;
+            std::stable_sort(middle_ptr, items() + size(), less);
+            last_ptr = std::unique(middle_ptr, items() + size(), same);
+        } catch (...) {
+            v_items.erase(position(old_size), v_items.end());
+            throw;
+        }
+        try {
+            std::inplace_merge(items(), middle_ptr, last_ptr, less);
+            last_ptr = std::unique(items(), last_ptr, same);
+            v_items.erase(position(last_ptr - items()), v_items.end());
+        } catch (...) {
+            v_items.clear();
+            throw;
+        }
+    }
+
+    /**
+    \brief Returns index of the first element not ordered before key. The search halves
+     the range with a conditional move instead of a branch, so lookups of random keys
+     do not pay a mispredicted branch per step.
+    */
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    template <typename K>
+    typename Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::size_type
+    Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::lower_index(const K &key) const
+    {
+        size_type n = size();
+        const Value *base_ptr = data();
+
+        if (!n) {
+            return 0;
+        }
+        while (n > 1) {
+            size_type half = n / 2;
+            base_ptr = v_comp(Key_of::key(base_ptr[half - 1]), key) ? base_ptr + half : base_ptr;
+            n -= half;
+        }
+        return base_ptr - data() + v_comp(Key_of::key(*base_ptr), key);
+    }
+
+    ///Returns index of the first element ordered after key.
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    template <typename K>
+    typename Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::size_type
+    Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::upper_index(const K &key) const
+    {
+        const Compare &comp = v_comp;
+        return std::upper_bound(begin(), end(), key, [&comp](const K &k, const Value &value) {
+            return comp(k, Key_of::key(value));
+        }) - begin();
+    }
+
+    ///Returns index of the element with given key, size() if there is none.
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    template <typename K>
+    typename Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::size_type
+    Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::find_index(const K &key) const
+    {
+        size_type i = lower_index(key);
+        return i < size() && !v_comp(key, Key_of::key(v_items[i])) ? i : size();
+    }
+
+    /**
+    \brief Constructs an element from args at the position of key unless key is present.
+    \return Index of the element with the key and whether it was inserted.
+    */
+    template <typename Value, typename Key, typename Key_of, typename Compare, typename Allocator>
+    template <typename... Args>
+    std::pair<typename Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::size_type, bool>
+    Base_flat_tree<Value, Key, Key_of, Compare, Allocator>::emplace_key(const key_type &key, Args &&... args)
+    {
+        size_type i = lower_index(key);
+
+        if (i < size() && !v_comp(key, Key_of::key(v_items[i]))) {
+            return std::make_pair(i, false);
+        }
+        v_items.emplace(position(i), std::forward<Args>(args)...);
+        return std::make_pair(i, true);
+    }
+
+    /**
+    \brief Sorted set of unique keys stored in a Vector. Iterators are constant pointers
+     to the elements, which are invalidated by insertion and erasure.
+    */
+    template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T> >
+    class Flat_set : public Base_flat_tree<T, T, Identity_key<T>, Compare, Allocator>
+    {
+        typedef Base_flat_tree<T, T, Identity_key<T>, Compare, Allocator> Base;
+
+    public:
+        typedef typename Base::const_iterator iterator;
+        typedef typename Base::const_iterator const_iterator;
+
+        ///Constructor of an empty set.
+        explicit Flat_set(const Compare &comp = Compare(), const Allocator &alloc = Allocator()) : Base(comp, alloc) { }
+        ///Constructor of set of unique elements of [first, last).
+        template <typename In>
+        Flat_set(In first, In last, const Compare &comp = Compare(), const Allocator &alloc = Allocator())
+            : Base(comp, alloc)
+        {
+            this->insert_unique(first, last);
+        }
+        ///Constructor of set of unique elements of list.
+        Flat_set(std::initializer_list<T> list, const Compare &comp = Compare(), const Allocator &alloc = Allocator())
+            : Base(comp, alloc)
+        {
+            this->insert_unique(list.begin(), list.end());
+        }
+
+        ///Inserts value unless it is present.
+        std::pair<iterator, bool> insert(const T &value) { return inserted(this->emplace_key(value, value)); }
+        ///Inserts value unless it is present.
+        std::pair<iterator, bool> insert(T &&value) { return inserted(this->emplace_key(value, std::move(value))); }
+
+    private:
+        std::pair<iterator, bool> inserted(std::pair<size_t, bool> result) const
+        {
+            return std::make_pair(this->begin() + result.first, result.second);
+        }
+    };
+
+    /**
+    \brief Sorted map of unique keys to values stored as std::pair<Key, T> in a Vector.
+     Iterators are pointers to the pairs, keys must not be modified through them.
+     Iterators and references are invalidated by insertion and erasure.
+    */
+    template <typename Key, typename T, typename Compare = std::less<Key>,
+              typename Allocator = std::allocator<std::pair<Key, T> > >
+    class Flat_map : public Base_flat_tree<std::pair<Key, T>, Key, First_key<std::pair<Key, T> >, Compare, Allocator>
+    {
+        typedef Base_flat_tree<std::pair<Key, T>, Key, First_key<std::pair<Key, T> >, Compare, Allocator> Base;
+
+    public:
+        typedef T mapped_type;
+        typedef std::pair<Key, T> value_type;
+        typedef value_type *iterator;
+        typedef const value_type *const_iterator;
+
+        ///Constructor of an empty map.
+        explicit Flat_map(const Compare &comp = Compare(), const Allocator &alloc = Allocator()) : Base(comp, alloc) { }
+        ///Constructor of map of the pairs of [first, last) with unique keys.
+        template <typename In>
+        Flat_map(In first, In last, const Compare &comp = Compare(), const Allocator &alloc = Allocator())
+            : Base(comp, alloc)
+        {
+            this->insert_unique(first, last);
+        }
+        ///Constructor of map of the pairs of list with unique keys.
+        Flat_map(std::initializer_list<value_type> list, const Compare &comp = Compare(),
+                 const Allocator &alloc = Allocator())
+            : Base(comp, alloc)
+        {
+            this->insert_unique(list.begin(), list.end());
+        }
+
+        using Base::begin;
+        using Base::end;
+        using Base::find;
+        iterator begin() { return this->items(); }
+        iterator end() { return this->items() + this->size(); }
+        ///Returns iterator to the pair with given key, end() if there is none.
+        iterator find(const Key &key) { return begin() + this->find_index(key); }
+        template <typename K, typename C = Compare, typename = typename C::is_transparent>
+        iterator find(const K &key) { return begin() + this->find_index(key); }
+
+        T &at(const Key &);
+        const T &at(const Key &) const;
+        ///Returns value of key, inserting a value-initialized one if key is not present.
+        T &operator[](const Key &key) { return try_emplace(key).first->second; }
+
+        ///Inserts value unless its key is present.
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return inserted(this->emplace_key(value.first, value));
+        }
+        ///Inserts value unless its key is present.
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return inserted(this->emplace_key(value.first, std::move(value)));
+        }
+        ///Inserts pair of key and value constructed from args unless key is present.
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&... args)
+        {
+            return inserted(this->emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                              std::forward_as_tuple(std::forward<Args>(args)...)));
+        }
+        ///Inserts pair of key and value, or assigns value if key is present.
+        template <typename M>
+        std::pair<iterator, bool> insert_or_assign(const Key &key, M &&value)
+        {
+            std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(value));
+            if (!result.second) {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+    private:
+        std::pair<iterator, bool> inserted(std::pair<size_t, bool> result)
+        {
+            return std::make_pair(begin() + result.first, result.second);
+        }
+    };
+
+    /**
+    \brief Returns value of key. Throws std::out_of_range if key is not present.
+    */
+    template <typename Key, typename T, typename Compare, typename Allocator>
+    T &Flat_map<Key, T, Compare, Allocator>::at(const Key &key)
+    {
+        size_t i = this->find_index(key);
+
+        if (i == this->size()) {
+            throw std::out_of_range("Key not found.");
+        }
+        return this->v_items[i].second;
+    }
+
+    /**
+    \brief Returns value of key. Throws std::out_of_range if key is not present.
+    */
+    template <typename Key, typename T, typename Compare, typename Allocator>
+    const T &Flat_map<Key, T, Compare, Allocator>::at(const Key &key) const
+    {
+        size_t i = this->find_index(key);
+
+        if (i == this->size()) {
+            throw std::out_of_range("Key not found.");
+        }
+        return this->v_items[i].second;
+    }
+}
+
+#endif
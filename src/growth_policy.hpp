@@ -0,0 +1,110 @@
+/**
+\file 
+\brief File contains growth policies deciding the capacity of a growing Vector.
+ A policy provides static grow(capacity, required, elem_size) returning the new 
+ capacity, not less than required. It is called only when the elements do not fit, 
+ sized constructors, copies, assign and reserve allocate exactly what they need.
+*/
+
+#ifndef _GROWTH_POLICY_HPP_
+#define _GROWTH_POLICY_HPP_
+
+#include <cstddef>
+
+namespace tasks {
+    ///Number of elements added to the capacity on each geometric growth.
+    const unsigned cap_modifier = 3;
+
+    /**
+    \brief Geometric growth, capacity is multiplied by Num / Den (1.5 by default) and Add
+     elements are added, so a vector growing from empty gets Add elements.
+     The default grows the capacity as 3, 7, 13, 22, 36, 57 ...
+    \tparam Add Number of elements added on each growth.
+    */
+    template <size_t Num = 3, size_t Den = 2, size_t Add = cap_modifier>
+    struct Geometric_growth
+    {
+        static_assert(Num > Den, "Growth factor must be greater than 1.");
+
+        /**
+        \brief Calculates the new capacity.
+        \param capacity Current capacity.
+        \param required Number of elements that must fit.
+        \return New capacity.
+        */
+        static size_t grow(size_t capacity, size_t required, size_t)
+        {
+            size_t cap = capacity / Den * Num + capacity % Den * Num / Den + Add;
+
+            return cap < required ? required : cap;
+        }
+    };
+
+    /**
+    \brief Doubling growth that rounds the buffer size in bytes up to a power of two,
+     so buffers match power-of-two size classes of allocators like Pool.
+    */
+    struct Power_of_two_growth
+    {
+        /**
+        \brief Calculates the new capacity.
+        \param capacity Current capacity.
+        \param required Number of elements that must fit.
+        \param elem_size Size of an element in bytes.
+        \return New capacity.
+        */
+        static size_t grow(size_t capacity, size_t required, size_t elem_size)
+        {
+            size_t count = capacity * 2 < required ? required : capacity * 2;
+            size_t bytes = 1;
+
+            while (bytes < count * elem_size) {
+                bytes *= 2;
+            }
+            return bytes / elem_size;
+        }
+    };
+
+    /**
+    \brief Exact fit, allocates only the required number of elements.
+     Suited for vectors built once, every push_back into a full vector reallocates.
+    */
+    struct Exact_growth
+    {
+        /**
+        \brief Calculates the new capacity.
+        \param required Number of elements that must fit.
+        \return Required value.
+        */
+        static size_t grow(size_t, size_t required, size_t)
+        {
+            return required;
+        }
+    };
+
+    /**
+    \brief Grows by half of the capacity until the step reaches Max_step_bytes, 
+     then by Max_step_bytes, bounding the slack of huge vectors.
+    */
+    template <size_t Max_step_bytes = 64 * 1024 * 1024>
+    struct Capped_linear_growth
+    {
+        /**
+        \brief Calculates the new capacity.
+        \param capacity Current capacity.
+        \param required Number of elements that must fit.
+        \param elem_size Size of an element in bytes.
+        \return New capacity.
+        */
+        static size_t grow(size_t capacity, size_t required, size_t elem_size)
+        {
+            size_t max_step = Max_step_bytes / elem_size ? Max_step_bytes / elem_size : 1;
+            size_t step = capacity / 2 < max_step ? capacity / 2 : max_step;
+            size_t cap = capacity + (step ? step : cap_modifier);
+
+            return cap < required ? required : cap;
+        }
+    };
+}
+
+#endif
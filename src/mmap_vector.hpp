@@ -0,0 +1,490 @@
+/**
+\file
+\brief File contains definition of template Mmap_vector class, a vector of
+ trivially copyable records stored in a memory mapped file (POSIX).
+*/
+
+#ifndef _MMAP_VECTOR_HPP_
+#define _MMAP_VECTOR_HPP_
+
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "smart_array.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector whose elements live in a file mapped with mmap.
+     The file holds the raw records, opening it costs O(1) regardless of its size
+     and the page cache is shared by all processes mapping the file.
+     In read-write mode the file grows with ftruncate when elements do not fit
+     and is truncated to the element count when the vector is destroyed.
+     In read-only mode modifiers throw std::logic_error and the file is mapped
+     privately: elements may be written, but the writes stay in memory of the process
+     and never reach the file.
+     Growing remaps the file, which invalidates iterators and references.
+    */
+    template <typename T, typename Growth = Geometric_growth<> >
+    class Mmap_vector
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Mmap_vector needs trivially copyable elements.");
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+
+        ///Mode the file is opened in.
+        enum Mode { read_only, read_write };
+        ///Expected access pattern, passed to madvise.
+        enum Advice { normal, sequential, random, will_need };
+
+        ///Iterator class, contiguous with signed offsets.
+        typedef R_a_iterator<T> Iterator;
+        ///Reverse iterator class, an adaptor of Iterator.
+        typedef Reverse_r_a_iterator<T> Reverse_iterator;
+
+        typedef Iterator iterator;
+        typedef R_a_iterator<const T> const_iterator;
+        typedef Reverse_iterator reverse_iterator;
+        typedef Reverse_r_a_iterator<const T> const_reverse_iterator;
+
+        explicit Mmap_vector(const std::string &path, Mode mode = read_only);
+        Mmap_vector(Mmap_vector &&vec) noexcept;
+        ~Mmap_vector(void);
+
+        const Mmap_vector &operator=(Mmap_vector &&);
+        bool operator==(const Mmap_vector &right) const
+        {
+            return v_size == right.v_size && simd::equal(v_front_ptr, right.v_front_ptr, v_size);
+        }
+        bool operator!=(const Mmap_vector &vec) const { return !(*this == vec); }
+        T &operator[](const size_type i) { return v_front_ptr[i]; }
+        const T &operator[](const size_type i) const { return v_front_ptr[i]; }
+        T &at(size_type);
+        const T &at(size_type) const;
+        template <typename In>
+        void append(In, In);
+        void push_back(const T &);
+        void pop_back();
+        iterator insert(iterator, const T &);
+        iterator insert(iterator, const size_type, const T &);
+        iterator erase(iterator pos) { iterator next = pos; return erase(pos, ++next); }
+        iterator erase(iterator, iterator);
+        T &front() { return *v_front_ptr; }
+        T &back() { return v_front_ptr[v_size - 1]; }
+        const T &front() const { return *v_front_ptr; }
+        const T &back() const { return v_front_ptr[v_size - 1]; }
+        iterator begin() { return iterator(v_front_ptr); }
+        iterator end() { return iterator(v_front_ptr + v_size); }
+        const_iterator begin() const { return const_iterator(v_front_ptr); }
+        const_iterator end() const { return const_iterator(v_front_ptr + v_size); }
+        reverse_iterator rbegin() { return reverse_iterator(v_front_ptr + v_size); }
+        reverse_iterator rend() { return reverse_iterator(v_front_ptr); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(v_front_ptr + v_size); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(v_front_ptr); }
+        bool empty() const { return 0 == v_size; }
+        size_type capacity() const { return v_capacity; }
+        size_type size() const { return v_size; }
+        size_type max_size() const { return std::numeric_limits<off_t>::max() / sizeof(T); }
+        void reserve(const size_type);
+        void resize(const size_type, const T & = T());
+        void swap(Mmap_vector &) noexcept;
+        void clear();
+        ///Checks if the file is opened read-only.
+        bool is_read_only() const { return read_only == v_mode; }
+        void advise(Advice);
+        void flush();
+
+    private:
+        ///Number of elements in vector.
+        size_type v_size;
+        ///Number of elements the mapping can contain before the file is grown.
+        size_type v_capacity;
+        ///Pointer to the start of the mapping, null if nothing is mapped.
+        T *v_front_ptr;
+        ///File descriptor, -1 after the vector was moved from.
+        int v_fd;
+        ///Mode the file was opened in.
+        Mode v_mode;
+
+        Mmap_vector(const Mmap_vector &);
+        const Mmap_vector &operator=(const Mmap_vector &);
+
+        T *map(const size_type cap) const;
+        void unmap();
+        void close();
+        void check_writable() const;
+        void reallocate(const size_type new_cap);
+        size_type re_capacity(const size_type size) const;
+    };
+
+    /**
+    \brief Constructor. Opens and maps the file, in read-write mode creates it if it does not exist.
+     Throws std::system_error if the file can not be opened or mapped and std::runtime_error
+     if its size is not a multiple of the element size.
+    \param path Path to the file.
+    \param mode Optional mode, read-only by default.
+    */
+    template <typename T, typename Growth>
+    Mmap_vector<T, Growth>::Mmap_vector(const std::string &path, Mode mode)
+        : v_size(0), v_capacity(0), v_front_ptr(0), v_fd(-1), v_mode(mode)
+    {
+        v_fd = ::open(path.c_str(), read_only == mode ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+        if (v_fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        struct stat info;
+
+        if (::fstat(v_fd, &info) < 0) {
+            int error = errno;
+            close();
+            throw std::system_error(error, std::generic_category(), "fstat " + path);
+        }
+        if (info.st_size % sizeof(T)) {
+            close();
+            throw std::runtime_error("File size is not a multiple of the element size: " + path);
+        }
+        try {
+            v_front_ptr = map(info.st_size / sizeof(T));
+        } catch (...) {
+            close();
+            throw;
+        }
+        v_size = v_capacity = info.st_size / sizeof(T);
+    }
+
+    /**
+    \brief Move constructor. Takes over the mapping, given vector is left without file.
+    \param vec Rvalue reference to a Mmap_vector object.
+    */
+    template <typename T, typename Growth>
+    Mmap_vector<T, Growth>::Mmap_vector(Mmap_vector &&vec) noexcept
+        : v_size(vec.v_size), v_capacity(vec.v_capacity), v_front_ptr(vec.v_front_ptr),
+          v_fd(vec.v_fd), v_mode(vec.v_mode)
+    {
+        vec.v_size = 0;
+        vec.v_capacity = 0;
+        vec.v_front_ptr = 0;
+        vec.v_fd = -1;
+    }
+
+    ///Destructor. Unmaps the file and truncates it to the elements in read-write mode.
+    template <typename T, typename Growth>
+    Mmap_vector<T, Growth>::~Mmap_vector(void)
+    {
+        close();
+    }
+
+    /**
+    \brief Move assignment. Closes own file and takes over the mapping of given vector.
+    \param right Given vector.
+    \return Changed Mmap_vector object.
+    */
+    template <typename T, typename Growth>
+    const Mmap_vector<T, Growth> &Mmap_vector<T, Growth>::operator=(Mmap_vector &&right)
+    {
+        if (this != &right) {
+            close();
+            swap(right);
+        }
+        return *this;
+    }
+
+    /**
+    \brief Accessing the vector element. Throws exception if index is out of range.
+    \param i Index.
+    \return Reference to the element.
+    */
+    template <typename T, typename Growth>
+    T &Mmap_vector<T, Growth>::at(size_type i)
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+        return v_front_ptr[i];
+    }
+
+    /**
+    \brief Accessing the vector element. Throws exception if index is out of range.
+    \param i Index.
+    \return Const reference to the element.
+    */
+    template <typename T, typename Growth>
+    const T &Mmap_vector<T, Growth>::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+        return v_front_ptr[i];
+    }
+
+    /**
+    \brief Appends elements of the range [first, last) to the end.
+     The range must not refer to the vector.
+    \param first, last Iterators to the start and end of the range.
+    */
+    template <typename T, typename Growth> template <typename In>
+    void Mmap_vector<T, Growth>::append(In first, In last)
+    {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    /**
+    \brief Adding element to the end of the vector. Grows the file if neccessary.
+    \param value Element to be added, may refer to an element of the vector.
+    */
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::push_back(const T &value)
+    {
+        check_writable();
+        if (v_size == v_capacity) {
+            T value_copy(value);
+            reallocate(re_capacity(v_size + 1));
+            v_front_ptr[v_size++] = value_copy;
+        } else {
+            v_front_ptr[v_size++] = value;
+        }
+    }
+
+    ///Popping the last element of Mmap_vector.
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::pop_back()
+    {
+        check_writable();
+        if (v_size) {
+            --v_size;
+        }
+    }
+
+    /**
+    \brief Inserts value before given position. Does nothing if position is out of range.
+    \param pos Position.
+    \param value Value to be inserted, may refer to an element of the vector.
+    \return Iterator to the inserted element, end if position is out of range.
+    */
+    template <typename T, typename Growth>
+    typename Mmap_vector<T, Growth>::iterator Mmap_vector<T, Growth>::insert(iterator pos, const T &value)
+    {
+        return insert(pos, 1, value);
+    }
+
+    /**
+    \brief Inserts count copies of value before given position. Does nothing if position is out of range.
+    \param pos Position.
+    \param count Number of copies.
+    \param value Value to be inserted, may refer to an element of the vector.
+    \return Iterator to the first inserted element, end if position is out of range.
+    */
+    template <typename T, typename Growth>
+    typename Mmap_vector<T, Growth>::iterator
+    Mmap_vector<T, Growth>::insert(iterator pos, const size_type count, const T &value)
+    {
+        check_writable();
+        if (end() < pos || pos < begin()) {
+            return end();
+        }
+        size_type index = pos - begin();
+        T value_copy(value);
+
+        if (v_size + count > v_capacity) {
+            reallocate(re_capacity(v_size + count));
+        }
+        T *first_ptr = v_front_ptr + index;
+        std::memmove(first_ptr + count, first_ptr, (v_size - index) * sizeof(T));
+        std::fill(first_ptr, first_ptr + count, value_copy);
+        v_size += count;
+        return iterator(first_ptr);
+    }
+
+    /**
+    \brief Erases elements of the range [first, last). Does nothing if the range is invalid.
+    \param first, last Iterators to the start and end of the range.
+    \return Iterator to the element after the erased ones.
+    */
+    template <typename T, typename Growth>
+    typename Mmap_vector<T, Growth>::iterator Mmap_vector<T, Growth>::erase(iterator first, iterator last)
+    {
+        check_writable();
+        if (first < begin() || end() < last || last < first) {
+            return end();
+        }
+        size_type index = first - begin();
+        size_type count = last - first;
+
+        tasks::shift_left(v_front_ptr + index, v_front_ptr + v_size, count);
+        v_size -= count;
+        return iterator(v_front_ptr + index);
+    }
+
+    /**
+    \brief Grows the file so that it holds at least given number of elements.
+    \param new_cap Wanted capacity.
+    */
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::reserve(const size_type new_cap)
+    {
+        check_writable();
+        if (new_cap > v_capacity) {
+            reallocate(new_cap);
+        }
+    }
+
+    /**
+    \brief Changes the number of elements, new elements are copies of given value.
+    \param new_size New number of elements.
+    \param value Optional value of new elements.
+    */
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::resize(const size_type new_size, const T &value)
+    {
+        check_writable();
+        if (new_size > v_size) {
+            insert(end(), new_size - v_size, value);
+        } else {
+            v_size = new_size;
+        }
+    }
+
+    /**
+    \brief Swaps the mappings of two vectors.
+    \param vec Vector to swap with.
+    */
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::swap(Mmap_vector &vec) noexcept
+    {
+        std::swap(v_size, vec.v_size);
+        std::swap(v_capacity, vec.v_capacity);
+        std::swap(v_front_ptr, vec.v_front_ptr);
+        std::swap(v_fd, vec.v_fd);
+        std::swap(v_mode, vec.v_mode);
+    }
+
+    ///Removes all elements, keeps the file size until destruction.
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::clear()
+    {
+        check_writable();
+        v_size = 0;
+    }
+
+    /**
+    \brief Tells the kernel how the elements will be accessed.
+    \param advice Expected access pattern.
+    */
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::advise(Advice advice)
+    {
+        const int flags[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED };
+
+        if (v_front_ptr && ::madvise(v_front_ptr, v_capacity * sizeof(T), flags[advice]) < 0) {
+            throw std::system_error(errno, std::generic_category(), "madvise");
+        }
+    }
+
+    ///Writes modified pages to the file and waits for completion.
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::flush()
+    {
+        if (v_front_ptr && ::msync(v_front_ptr, v_capacity * sizeof(T), MS_SYNC) < 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    /**
+    \brief Maps the first cap elements of the file.
+    \param cap Number of elements, the file must be at least that large.
+    \return Pointer to the mapping, null if cap is 0.
+    */
+    template <typename T, typename Growth>
+    T *Mmap_vector<T, Growth>::map(const size_type cap) const
+    {
+        if (!cap) {
+            return 0;
+        }
+        //A read-only file is mapped copy-on-write, so writes through references never fault nor reach the file.
+        int flags = read_only == v_mode ? MAP_PRIVATE : MAP_SHARED;
+        void *ptr = ::mmap(0, cap * sizeof(T), PROT_READ | PROT_WRITE, flags, v_fd, 0);
+
+        if (MAP_FAILED == ptr) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        return static_cast<T *>(ptr);
+    }
+
+    ///Removes the mapping.
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::unmap()
+    {
+        if (v_front_ptr) {
+            ::munmap(v_front_ptr, v_capacity * sizeof(T));
+            v_front_ptr = 0;
+        }
+    }
+
+    ///Unmaps and closes the file. In read-write mode the file, which is capacity long, is truncated to the elements.
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::close()
+    {
+        unmap();
+        if (v_fd >= 0) {
+            if (read_write == v_mode && v_size != v_capacity) {
+                //Errors can not be reported from the destructor, the file then keeps spare capacity.
+                int result = ::ftruncate(v_fd, v_size * sizeof(T));
+                (void)result;
+            }
+            ::close(v_fd);
+            v_fd = -1;
+        }
+        v_size = 0;
+        v_capacity = 0;
+    }
+
+    ///Throws std::logic_error in read-only mode.
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::check_writable() const
+    {
+        if (read_only == v_mode) {
+            throw std::logic_error("Mmap_vector is read-only.");
+        }
+    }
+
+    /**
+    \brief Grows the file to given capacity and maps it again.
+     The new mapping is created before the old one is removed, so the vector
+     stays valid if growing fails.
+    \param new_cap New capacity, must be greater than the current one.
+    */
+    template <typename T, typename Growth>
+    void Mmap_vector<T, Growth>::reallocate(const size_type new_cap)
+    {
+        if (::ftruncate(v_fd, new_cap * sizeof(T)) < 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+        T *temp_ptr = map(new_cap);
+        unmap();
+        v_front_ptr = temp_ptr;
+        v_capacity = new_cap;
+    }
+
+    /**
+    \brief Calculates the capacity for growing to given number of elements using the growth policy.
+    \param size Number of elements that must fit.
+    \return New capacity value.
+    */
+    template <typename T, typename Growth>
+    typename Mmap_vector<T, Growth>::size_type Mmap_vector<T, Growth>::re_capacity(const size_type size) const
+    {
+        return Growth::grow(v_capacity, size, sizeof(T));
+    }
+}
+
+#endif
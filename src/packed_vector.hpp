@@ -0,0 +1,523 @@
+/**
+\file
+\brief File contains definitions of Packed_vector class, a vector of unsigned integers
+ stored at a fixed bit width, and Block_packed_vector class, a vector of 32-bit integers
+ compressed in blocks with frame of reference or delta encoding.
+*/
+
+#ifndef _PACKED_VECTOR_HPP_
+#define _PACKED_VECTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector of unsigned integers taking bits bits each, 1 to 64, packed back to back
+     into uint64_t words of a Vector. Value i occupies bits [i * bits, (i + 1) * bits) of the
+     word array and is read with a shift and a mask, touching two words when it straddles
+     a word boundary. Bits past the last value are kept zero. Elements are returned by value,
+     set() replaces one.
+    */
+    class Packed_vector
+    {
+    public:
+        typedef uint64_t value_type;
+        typedef size_t size_type;
+        typedef uint64_t word_type;
+        ///Number of bits of a word.
+        static const size_type word_bits = 64;
+
+        typedef Indexed_iterator<const Packed_vector, value_type> iterator;
+        typedef iterator const_iterator;
+
+        explicit Packed_vector(unsigned bits = 32);
+        template <typename T, typename Allocator, typename Growth>
+        explicit Packed_vector(const Vector<T, Allocator, Growth> &, unsigned bits = 0);
+
+        bool operator==(const Packed_vector &vec) const
+        {
+            return v_size == vec.v_size && v_bits == vec.v_bits
+                   && simd::equal(words(), vec.words(), word_count());
+        }
+        bool operator!=(const Packed_vector &vec) const { return !(*this == vec); }
+        value_type operator[](size_type) const;
+        value_type at(size_type) const;
+        void set(size_type, value_type);
+        value_type front() const { return (*this)[0]; }
+        value_type back() const { return (*this)[v_size - 1]; }
+
+        void push_back(value_type);
+        void pop_back();
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, v_size); }
+        bool empty() const { return 0 == v_size; }
+        size_type size() const { return v_size; }
+        ///Returns number of values the allocated words hold.
+        size_type capacity() const { return v_words.capacity() * word_bits / v_bits; }
+        void reserve(size_type count) { v_words.reserve(words_for(count)); }
+        void resize(size_type, value_type = 0);
+        void clear() { v_words.clear(); v_size = 0; }
+        void swap(Packed_vector &other) noexcept
+        {
+            v_words.swap(other.v_words);
+            std::swap(v_size, other.v_size);
+            std::swap(v_bits, other.v_bits);
+            std::swap(v_mask, other.v_mask);
+        }
+
+        ///Returns bit width of the values.
+        unsigned bits() const { return v_bits; }
+        ///Returns the largest value that fits the bit width.
+        value_type max_value() const { return v_mask; }
+        ///Returns number of words holding the values.
+        size_type word_count() const { return v_words.size(); }
+        ///Returns pointer to the words, null if there are none.
+        const word_type *data() const { return words(); }
+
+        template <typename T, typename Allocator, typename Growth>
+        void to_vector(Vector<T, Allocator, Growth> &) const;
+        template <typename T = value_type>
+        Vector<T> to_vector() const;
+
+        ///Returns the smallest bit width holding value, at least 1.
+        static unsigned bits_for(value_type value) { return value ? word_bits - __builtin_clzll(value) : 1; }
+
+    private:
+        ///Words holding the values.
+        Vector<word_type> v_words;
+        ///Number of values.
+        size_type v_size;
+        ///Bit width of a value.
+        unsigned v_bits;
+        ///Mask of the low v_bits bits.
+        word_type v_mask;
+
+        size_type words_for(size_type count) const { return (count * v_bits + word_bits - 1) / word_bits; }
+        word_type *words() { return v_words.empty() ? 0 : &v_words[0]; }
+        const word_type *words() const { return v_words.empty() ? 0 : &v_words[0]; }
+        void init(unsigned);
+        void check_value(value_type) const;
+        void write(size_type, value_type);
+        void clear_tail();
+    };
+
+    /**
+    \brief Constructor of an empty vector of values of given bit width.
+     Throws std::invalid_argument if bits is not 1 to 64.
+    */
+    inline Packed_vector::Packed_vector(unsigned bits) : v_size(0)
+    {
+        init(bits);
+    }
+
+    /**
+    \brief Constructor copying the values of vec, converted to uint64_t.
+    \param vec Vector of integers.
+    \param bits Bit width, 0 picks the smallest width holding every value.
+     Throws std::out_of_range if a value does not fit a given width.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    Packed_vector::Packed_vector(const Vector<T, Allocator, Growth> &vec, unsigned bits) : v_size(0)
+    {
+        if (!bits) {
+            value_type all = 0;
+            for (size_type i = 0; i < vec.size(); ++i) {
+                all |= value_type(vec[i]);
+            }
+            bits = bits_for(all);
+        }
+        init(bits);
+        reserve(vec.size());
+        for (size_type i = 0; i < vec.size(); ++i) {
+            push_back(value_type(vec[i]));
+        }
+    }
+
+    /**
+    \brief Returns value i, read with a shift and a mask from one or two words.
+    */
+    inline Packed_vector::value_type Packed_vector::operator[](size_type i) const
+    {
+        size_type bit = i * v_bits;
+        size_type w = bit / word_bits, shift = bit % word_bits;
+        word_type value = v_words[w] >> shift;
+
+        if (shift + v_bits > word_bits) {
+            value |= v_words[w + 1] << (word_bits - shift);
+        }
+        return value & v_mask;
+    }
+
+    /**
+    \brief Returns value i. Throws std::out_of_range if i is not less than size.
+    */
+    inline Packed_vector::value_type Packed_vector::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Replaces value i. Throws std::out_of_range if value does not fit the bit width.
+    */
+    inline void Packed_vector::set(size_type i, value_type value)
+    {
+        check_value(value);
+        write(i, value);
+    }
+
+    /**
+    \brief Appends a value, adding a word when it does not fit.
+     Throws std::out_of_range if value does not fit the bit width.
+    */
+    inline void Packed_vector::push_back(value_type value)
+    {
+        check_value(value);
+        v_words.resize(words_for(v_size + 1), 0);
+        write(v_size, value);
+        ++v_size;
+    }
+
+    ///Removes the last value.
+    inline void Packed_vector::pop_back()
+    {
+        if (v_size) {
+            --v_size;
+            v_words.resize(words_for(v_size));
+            clear_tail();
+        }
+    }
+
+    /**
+    \brief Changes the number of values. Works like std::vector::resize().
+     Throws std::out_of_range if value does not fit the bit width.
+    \param new_size Number of values.
+    \param value Value of appended elements.
+    */
+    inline void Packed_vector::resize(size_type new_size, value_type value)
+    {
+        check_value(value);
+        size_type old_size = v_size;
+
+        v_words.resize(words_for(new_size), 0);
+        v_size = new_size;
+        clear_tail();
+        for (size_type i = old_size; value && i < new_size; ++i) {
+            write(i, value);
+        }
+    }
+
+    /**
+    \brief Copies the values into vec converted to T, replacing its contents.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Packed_vector::to_vector(Vector<T, Allocator, Growth> &vec) const
+    {
+        vec.clear();
+        vec.reserve(v_size);
+        for (size_type i = 0; i < v_size; ++i) {
+            vec.push_back(T((*this)[i]));
+        }
+    }
+
+    /**
+    \brief Returns the values converted to T in a Vector.
+    */
+    template <typename T>
+    Vector<T> Packed_vector::to_vector() const
+    {
+        Vector<T> vec;
+        to_vector(vec);
+        return vec;
+    }
+
+    ///Sets the bit width. Throws std::invalid_argument if bits is not 1 to 64.
+    inline void Packed_vector::init(unsigned bits)
+    {
+        if (bits < 1 || bits > word_bits) {
+            throw std::invalid_argument("Bit width must be 1 to 64.");
+        }
+        v_bits = bits;
+        v_mask = bits < word_bits ? (word_type(1) << bits) - 1 : ~word_type(0);
+    }
+
+    ///Throws std::out_of_range if value does not fit the bit width.
+    inline void Packed_vector::check_value(value_type value) const
+    {
+        if (value & ~v_mask) {
+            throw std::out_of_range("Value does not fit the bit width.");
+        }
+    }
+
+    ///Stores value fitting the bit width at position i.
+    inline void Packed_vector::write(size_type i, value_type value)
+    {
+        size_type bit = i * v_bits;
+        size_type w = bit / word_bits, shift = bit % word_bits;
+
+        v_words[w] = (v_words[w] & ~(v_mask << shift)) | (value << shift);
+        if (shift + v_bits > word_bits) {
+            v_words[w + 1] = (v_words[w + 1] & ~(v_mask >> (word_bits - shift))) | (value >> (word_bits - shift));
+        }
+    }
+
+    ///Zeroes bits of the last word past the last value.
+    inline void Packed_vector::clear_tail()
+    {
+        size_type used = v_size * v_bits % word_bits;
+
+        if (used) {
+            v_words[word_count() - 1] &= ~(~word_type(0) << used);
+        }
+    }
+
+    /**
+    \brief Vector of 32-bit unsigned integers compressed in blocks of simd::packed_block_size
+     values. Each block stores a base and the differences of its values, bit-packed at the
+     width of the largest difference in the 4-lane layout of simd::packed_block_size.
+     With frame_of_reference encoding the base is the smallest value of the block and
+     differences are taken from it, which suits values clustered in a range. With delta
+     encoding differences are taken from the value 4 positions before, which suits sorted
+     values such as lists of ids. Values are appended to an uncompressed tail block which
+     is encoded when full. Scans decode a block at a time with the SIMD unpacking kernels,
+     random access reads one value in frame_of_reference and sums up to 32 differences
+     in delta encoding.
+    */
+    class Block_packed_vector
+    {
+    public:
+        typedef uint32_t value_type;
+        typedef size_t size_type;
+
+        ///Encodings of the blocks.
+        enum Encoding { frame_of_reference, delta };
+        ///Number of values of a block.
+        static const size_type block_size = simd::packed_block_size;
+
+        ///Constructor of an empty vector.
+        explicit Block_packed_vector(Encoding encoding = frame_of_reference) : v_size(0), v_encoding(encoding) { }
+        template <typename T, typename Allocator, typename Growth>
+        explicit Block_packed_vector(const Vector<T, Allocator, Growth> &, Encoding = frame_of_reference);
+
+        value_type operator[](size_type) const;
+        value_type at(size_type) const;
+        void push_back(value_type);
+        bool empty() const { return 0 == v_size; }
+        size_type size() const { return v_size; }
+        void clear() { v_words.clear(); v_blocks.clear(); v_tail.clear(); v_size = 0; }
+
+        ///Returns encoding of the blocks.
+        Encoding encoding() const { return v_encoding; }
+        ///Returns number of encoded blocks, the tail is not counted.
+        size_type block_count() const { return v_blocks.size(); }
+        ///Returns number of bytes of the packed words, block headers and tail.
+        size_type encoded_bytes() const
+        {
+            return v_words.size() * sizeof(uint32_t) + v_blocks.size() * sizeof(Block) + v_tail.size() * sizeof(uint32_t);
+        }
+
+        template <typename Fn>
+        void scan(Fn) const;
+        template <typename T, typename Allocator, typename Growth>
+        void to_vector(Vector<T, Allocator, Growth> &) const;
+        template <typename T = value_type>
+        Vector<T> to_vector() const;
+
+    private:
+        ///Header of an encoded block.
+        struct Block
+        {
+            ///Index of the first packed word.
+            size_type offset;
+            uint32_t base;
+            ///Bit width of the differences.
+            uint32_t bits;
+        };
+
+        ///Packed words of every block.
+        Vector<uint32_t> v_words;
+        Vector<Block> v_blocks;
+        ///Values not yet encoded, fewer than block_size.
+        Vector<uint32_t> v_tail;
+        ///Number of values.
+        size_type v_size;
+        Encoding v_encoding;
+
+        const uint32_t *block_words(const Block &block) const { return block.bits ? &v_words[block.offset] : 0; }
+        uint32_t difference(const Block &, size_type, size_type) const;
+        void unpack(const Block &, uint32_t *) const;
+        void seal();
+    };
+
+    /**
+    \brief Constructor compressing the values of vec.
+     Throws std::out_of_range if a value does not fit 32 bits.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    Block_packed_vector::Block_packed_vector(const Vector<T, Allocator, Growth> &vec, Encoding encoding)
+        : v_size(0), v_encoding(encoding)
+    {
+        v_tail.reserve(block_size);
+        for (size_type i = 0; i < vec.size(); ++i) {
+            if (uint64_t(vec[i]) > UINT32_MAX) {
+                throw std::out_of_range("Value does not fit 32 bits.");
+            }
+            push_back(value_type(vec[i]));
+        }
+    }
+
+    /**
+    \brief Returns value i, reading at most 32 differences of its lane.
+    */
+    inline Block_packed_vector::value_type Block_packed_vector::operator[](size_type i) const
+    {
+        if (i >= v_blocks.size() * block_size) {
+            return v_tail[i - v_blocks.size() * block_size];
+        }
+        const Block &block = v_blocks[i / block_size];
+        size_type row = i % block_size / 4, lane = i % 4;
+
+        if (frame_of_reference == v_encoding) {
+            return block.base + difference(block, row, lane);
+        }
+        value_type value = block.base;
+        for (size_type r = 0; r <= row; ++r) {
+            value += difference(block, r, lane);
+        }
+        return value;
+    }
+
+    /**
+    \brief Returns value i. Throws std::out_of_range if i is not less than size.
+    */
+    inline Block_packed_vector::value_type Block_packed_vector::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    ///Appends a value, encoding the tail when it holds a full block.
+    inline void Block_packed_vector::push_back(value_type value)
+    {
+        v_tail.push_back(value);
+        ++v_size;
+        if (v_tail.size() == block_size) {
+            seal();
+        }
+    }
+
+    /**
+    \brief Calls fn(values_ptr, count) for consecutive runs of values in index order,
+     a decoded block or the tail at a time.
+    */
+    template <typename Fn>
+    void Block_packed_vector::scan(Fn fn) const
+    {
+        uint32_t values[block_size];
+
+        for (size_type k = 0; k < v_blocks.size(); ++k) {
+            unpack(v_blocks[k], values);
+            fn(static_cast<const uint32_t *>(values), block_size);
+        }
+        if (!v_tail.empty()) {
+            fn(&v_tail[0], v_tail.size());
+        }
+    }
+
+    /**
+    \brief Copies the values into vec converted to T, replacing its contents.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Block_packed_vector::to_vector(Vector<T, Allocator, Growth> &vec) const
+    {
+        vec.clear();
+        vec.reserve(v_size);
+        scan([&vec](const uint32_t *values_ptr, size_type count) { vec.append(values_ptr, values_ptr + count); });
+    }
+
+    /**
+    \brief Returns the values converted to T in a Vector.
+    */
+    template <typename T>
+    Vector<T> Block_packed_vector::to_vector() const
+    {
+        Vector<T> vec;
+        to_vector(vec);
+        return vec;
+    }
+
+    ///Returns the stored difference of given row and lane of block.
+    inline uint32_t Block_packed_vector::difference(const Block &block, size_type row, size_type lane) const
+    {
+        if (!block.bits) {
+            return 0;
+        }
+        const uint32_t *words_ptr = block_words(block);
+        size_type bit = row * block.bits, word = bit / 32 * 4 + lane, shift = bit % 32;
+        uint32_t value = words_ptr[word] >> shift;
+
+        if (shift + block.bits > 32) {
+            value |= words_ptr[word + 4] << (32 - shift);
+        }
+        return block.bits < 32 ? value & ((uint32_t(1) << block.bits) - 1) : value;
+    }
+
+    ///Decodes block_size values of block into values_ptr.
+    inline void Block_packed_vector::unpack(const Block &block, uint32_t *values_ptr) const
+    {
+        if (frame_of_reference == v_encoding) {
+            simd::unpack_for(block_words(block), block.bits, block.base, values_ptr);
+        } else {
+            simd::unpack_delta(block_words(block), block.bits, block.base, values_ptr);
+        }
+    }
+
+    /**
+    \brief Encodes the full tail as a block: computes the base and the differences,
+     and packs them at the width of the largest one.
+    */
+    inline void Block_packed_vector::seal()
+    {
+        uint32_t differences[block_size];
+        uint32_t all = 0;
+        Block block;
+
+        block.offset = v_words.size();
+        block.base = v_tail[0];
+        for (size_type j = 1; frame_of_reference == v_encoding && j < block_size; ++j) {
+            block.base = v_tail[j] < block.base ? v_tail[j] : block.base;
+        }
+        for (size_type j = 0; j < block_size; ++j) {
+            uint32_t previous = delta == v_encoding && j >= 4 ? v_tail[j - 4] : block.base;
+            differences[j] = v_tail[j] - previous;
+            all |= differences[j];
+        }
+        block.bits = all ? 32 - __builtin_clz(all) : 0;
+
+        v_words.resize(block.offset + 4 * block.bits, 0);
+        for (size_type j = 0; block.bits && j < block_size; ++j) {
+            uint32_t *words_ptr = &v_words[block.offset];
+            size_type bit = j / 4 * block.bits, word = bit / 32 * 4 + j % 4, shift = bit % 32;
+            words_ptr[word] |= differences[j] << shift;
+            if (shift + block.bits > 32) {
+                words_ptr[word + 4] |= differences[j] >> (32 - shift);
+            }
+        }
+        v_blocks.push_back(block);
+        v_tail.clear();
+    }
+}
+
+#endif
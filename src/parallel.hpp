@@ -0,0 +1,532 @@
+/**
+\file
+\brief File contains the tasks::parallel module: a fixed thread pool and chunked
+ parallel algorithms over contiguous ranges, Vector iterators or raw pointers.
+ Ranges are split into chunks whose inner boundaries fall on cache line boundaries,
+ so threads never write to the same line. Per chunk results are padded to a line.
+ Algorithms called from inside a pool task run sequentially.
+*/
+
+#ifndef _PARALLEL_HPP_
+#define _PARALLEL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+
+#include "smart_array.hpp"
+
+namespace tasks {
+namespace parallel {
+
+    ///Size of a cache line in bytes.
+    const size_t cache_line = 64;
+    ///Ranges shorter than this many elements per thread are processed sequentially.
+    const size_t min_grain = 4096;
+
+    /**
+    \brief Fixed pool of worker threads running bulk jobs. A job runs a function for
+     every index of [0, count), the calling thread takes part and returns when all
+     indices are done. The first exception thrown by a task is rethrown by run.
+    */
+    class Thread_pool
+    {
+    public:
+        /**
+        \brief Constructor.
+        \param threads Number of threads including the caller, hardware concurrency if 0.
+        */
+        explicit Thread_pool(size_t threads = 0)
+            : m_count(0), m_next(0), m_active(0), m_generation(0), m_stop(false)
+        {
+            if (!threads) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            for (size_t i = 1; i < threads; ++i) {
+                m_workers.emplace_back(&Thread_pool::worker_loop, this);
+            }
+        }
+
+        ///Destructor, joins the workers.
+        ~Thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (size_t i = 0; i < m_workers.size(); ++i) {
+                m_workers[i].join();
+            }
+        }
+
+        ///Returns number of threads running a job, including the caller.
+        size_t size() const { return m_workers.size() + 1; }
+
+        ///Returns whether the calling thread runs a task of some pool.
+        static bool in_task() { return inside_task(); }
+
+        /**
+        \brief Runs fn(i) for every i of [0, count) and waits for completion.
+         Runs sequentially if called from a task of any pool.
+        \param count Number of indices.
+        \param fn Function called with each index.
+        */
+        template <typename Fn>
+        void run(size_t count, Fn fn)
+        {
+            if (count <= 1 || m_workers.empty() || inside_task()) {
+                for (size_t i = 0; i < count; ++i) {
+                    fn(i);
+                }
+                return;
+            }
+            std::lock_guard<std::mutex> run_lock(m_run_mutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task = [&fn](size_t i) { fn(i); };
+                m_count = count;
+                m_next = 0;
+                m_active = m_workers.size();
+                m_error = std::exception_ptr();
+                ++m_generation;
+            }
+            m_wake.notify_all();
+            work();
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return 0 == m_active; });
+            m_task = std::function<void(size_t)>();
+            if (m_error) {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+    private:
+        Thread_pool(const Thread_pool &);
+        Thread_pool &operator=(const Thread_pool &);
+
+        ///Flag of threads currently running a task.
+        static bool &inside_task()
+        {
+            thread_local bool inside = false;
+            return inside;
+        }
+
+        ///Runs indices of the current job until none are left.
+        void work()
+        {
+            inside_task() = true;
+            for (size_t i = m_next++; i < m_count; i = m_next++) {
+                try {
+                    m_task(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_error) {
+                        m_error = std::current_exception();
+                    }
+                    m_next = m_count;
+                }
+            }
+            inside_task() = false;
+        }
+
+        ///Waits for jobs and takes part in them until the pool is destroyed.
+        void worker_loop()
+        {
+            unsigned long seen = 0;
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            for (;;) {
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) {
+                    return;
+                }
+                seen = m_generation;
+                lock.unlock();
+                work();
+                lock.lock();
+                if (0 == --m_active) {
+                    m_done.notify_one();
+                }
+            }
+        }
+
+        Vector<std::thread> m_workers;
+        ///Serializes jobs submitted by different threads.
+        std::mutex m_run_mutex;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        std::function<void(size_t)> m_task;
+        size_t m_count;
+        std::atomic<size_t> m_next;
+        ///Number of workers which have not finished the current job.
+        size_t m_active;
+        unsigned long m_generation;
+        bool m_stop;
+        std::exception_ptr m_error;
+    };
+
+    ///Returns the pool shared by algorithms called without one.
+    inline Thread_pool &default_pool()
+    {
+        static Thread_pool pool;
+        return pool;
+    }
+
+    /**
+    \brief Splits n elements starting at first_ptr into chunks. Inner boundaries
+     are moved forward to the next cache line boundary when T divides a line.
+     Chunks hold at least min_grain elements, so none is empty unless n is 0.
+    */
+    template <typename T>
+    class Chunks
+    {
+    public:
+        /**
+        \brief Constructor.
+        \param first_ptr Start of the range.
+        \param n Number of elements.
+        \param pool Pool the chunks are processed by.
+        \param per_thread Wanted number of chunks per thread.
+        */
+        Chunks(const T *first_ptr, size_t n, const Thread_pool &pool, size_t per_thread = 4)
+            : m_size(n), m_offset(0), m_line(1)
+        {
+            size_t most = n / min_grain;
+            m_count = std::max<size_t>(1, std::min(pool.size() * per_thread, most));
+            if (sizeof(T) <= cache_line && 0 == cache_line % sizeof(T)) {
+                size_t misalignment = reinterpret_cast<uintptr_t>(first_ptr) % cache_line;
+                m_line = cache_line / sizeof(T);
+                m_offset = misalignment % sizeof(T) ? 0 : (cache_line - misalignment) % cache_line / sizeof(T);
+            }
+        }
+
+        ///Returns number of chunks.
+        size_t count() const { return m_count; }
+
+        ///Returns index of the first element of chunk k, k may equal count().
+        size_t begin(size_t k) const
+        {
+            if (0 == k || k >= m_count) {
+                return k ? m_size : 0;
+            }
+            size_t index = m_size / m_count * k + m_size % m_count * k / m_count;
+
+            if (index > m_offset) {
+                index = m_offset + (index - m_offset + m_line - 1) / m_line * m_line;
+            }
+            return std::min(index, m_size);
+        }
+
+        ///Returns index past the last element of chunk k.
+        size_t end(size_t k) const { return begin(k + 1); }
+
+    private:
+        size_t m_size;
+        size_t m_count;
+        ///Index of the first element starting a cache line.
+        size_t m_offset;
+        ///Number of elements in a cache line.
+        size_t m_line;
+    };
+
+    /**
+    \brief Value padded to a cache line, keeps per chunk results of threads apart.
+    */
+    template <typename T>
+    struct alignas(cache_line) Padded
+    {
+        explicit Padded(const T &init) : value(init) { }
+        T value;
+    };
+
+    ///Returns the element pointer of a Vector (or Small_vector, Mmap_vector) iterator.
+    template <typename T>
+    T *raw(R_a_iterator<T> iter) { return iter.operator->(); }
+
+    ///Returns the pointer itself.
+    template <typename T>
+    T *raw(T *ptr) { return ptr; }
+
+    /**
+    \brief Calls fn for every element of [first, last).
+    \param first, last Contiguous range, Vector iterators or pointers.
+    \param fn Function taking an element reference.
+    \param pool Optional pool.
+    */
+    template <typename It, typename Fn>
+    void for_each(It first, It last, Fn fn, Thread_pool &pool = default_pool())
+    {
+        auto first_ptr = parallel::raw(first);
+        Chunks<typename std::remove_const<typename std::remove_pointer<decltype(first_ptr)>::type>::type>
+            chunks(first_ptr, parallel::raw(last) - first_ptr, pool);
+
+        pool.run(chunks.count(), [&](size_t k) {
+            std::for_each(first_ptr + chunks.begin(k), first_ptr + chunks.end(k), fn);
+        });
+    }
+
+    /**
+    \brief Stores fn of every element of [first, last) into the range starting at out.
+     Chunks are aligned to the output range.
+    \param first, last Contiguous input range.
+    \param out Start of contiguous output range, may equal first.
+    \param fn Unary function.
+    \param pool Optional pool.
+    */
+    template <typename In, typename Out, typename Fn>
+    void transform(In first, In last, Out out, Fn fn, Thread_pool &pool = default_pool())
+    {
+        auto first_ptr = parallel::raw(first);
+        auto out_ptr = parallel::raw(out);
+        Chunks<typename std::remove_pointer<decltype(out_ptr)>::type>
+            chunks(out_ptr, parallel::raw(last) - first_ptr, pool);
+
+        pool.run(chunks.count(), [&](size_t k) {
+            std::transform(first_ptr + chunks.begin(k), first_ptr + chunks.end(k), out_ptr + chunks.begin(k), fn);
+        });
+    }
+
+    /**
+    \brief Stores fn of pairs of elements of [first1, last1) and the range starting at first2
+     into the range starting at out.
+    */
+    template <typename In1, typename In2, typename Out, typename Fn>
+    void transform(In1 first1, In1 last1, In2 first2, Out out, Fn fn, Thread_pool &pool = default_pool())
+    {
+        auto first1_ptr = parallel::raw(first1);
+        auto first2_ptr = parallel::raw(first2);
+        auto out_ptr = parallel::raw(out);
+        Chunks<typename std::remove_pointer<decltype(out_ptr)>::type>
+            chunks(out_ptr, parallel::raw(last1) - first1_ptr, pool);
+
+        pool.run(chunks.count(), [&](size_t k) {
+            std::transform(first1_ptr + chunks.begin(k), first1_ptr + chunks.end(k),
+                           first2_ptr + chunks.begin(k), out_ptr + chunks.begin(k), fn);
+        });
+    }
+
+    /**
+    \brief Reduces [first, last) with op starting from init. Chunks are reduced
+     in parallel and their results combined in order, so op must be associative.
+    \param first, last Contiguous range.
+    \param init Initial value.
+    \param op Binary operation.
+    \param pool Optional pool.
+    \return Reduced value.
+    */
+    template <typename It, typename T, typename Op>
+    T reduce(It first, It last, T init, Op op, Thread_pool &pool = default_pool())
+    {
+        auto first_ptr = parallel::raw(first);
+        Chunks<typename std::remove_const<typename std::remove_pointer<decltype(first_ptr)>::type>::type>
+            chunks(first_ptr, parallel::raw(last) - first_ptr, pool, 1);
+        Vector<Padded<T> > partials(chunks.count(), Padded<T>(init));
+
+        pool.run(chunks.count(), [&](size_t k) {
+            size_t b = chunks.begin(k);
+            size_t e = chunks.end(k);
+
+            if (b != e) {
+                partials[k].value = std::accumulate(first_ptr + b + 1, first_ptr + e, T(first_ptr[b]), op);
+            }
+        });
+        for (size_t k = 0; k < chunks.count(); ++k) {
+            if (chunks.begin(k) != chunks.end(k)) {
+                init = op(init, partials[k].value);
+            }
+        }
+        return init;
+    }
+
+    ///Sums [first, last) starting from init.
+    template <typename It, typename T>
+    T reduce(It first, It last, T init, Thread_pool &pool = default_pool())
+    {
+        return parallel::reduce(first, last, init, std::plus<T>(), pool);
+    }
+
+    /**
+    \brief Stores inclusive prefix results of op over [first, last) into the range starting at out.
+     Chunk totals are computed in parallel, combined sequentially into prefixes, then
+     chunks are scanned in parallel starting from the prefix of preceding chunks.
+     op must be associative.
+    \param first, last Contiguous input range.
+    \param out Start of contiguous output range, may equal first.
+    \param op Binary operation.
+    \param pool Optional pool.
+    */
+    template <typename In, typename Out, typename Op>
+    void inclusive_scan(In first, In last, Out out, Op op, Thread_pool &pool = default_pool())
+    {
+        typedef typename std::remove_pointer<decltype(parallel::raw(out))>::type T;
+        auto first_ptr = parallel::raw(first);
+        T *out_ptr = parallel::raw(out);
+        size_t n = parallel::raw(last) - first_ptr;
+
+        if (!n) {
+            return;
+        }
+        Chunks<T> chunks(out_ptr, n, pool, 1);
+        Vector<Padded<T> > totals(chunks.count(), Padded<T>(T(first_ptr[0])));
+
+        pool.run(chunks.count(), [&](size_t k) {
+            size_t b = chunks.begin(k);
+            totals[k].value = std::accumulate(first_ptr + b + 1, first_ptr + chunks.end(k), T(first_ptr[b]), op);
+        });
+        for (size_t k = 1; k < chunks.count(); ++k) {
+            totals[k].value = op(totals[k - 1].value, totals[k].value);
+        }
+        pool.run(chunks.count(), [&](size_t k) {
+            size_t b = chunks.begin(k);
+            size_t e = chunks.end(k);
+            T total = k ? op(totals[k - 1].value, T(first_ptr[b])) : T(first_ptr[b]);
+
+            out_ptr[b] = total;
+            for (size_t i = b + 1; i < e; ++i) {
+                total = op(total, first_ptr[i]);
+                out_ptr[i] = total;
+            }
+        });
+    }
+
+    ///Stores inclusive prefix sums of [first, last) into the range starting at out.
+    template <typename In, typename Out>
+    void inclusive_scan(In first, In last, Out out, Thread_pool &pool = default_pool())
+    {
+        typedef typename std::remove_pointer<decltype(parallel::raw(out))>::type T;
+        parallel::inclusive_scan(first, last, out, std::plus<T>(), pool);
+    }
+
+    /**
+    \brief Assigns value to every element of [first, last).
+    */
+    template <typename It, typename T>
+    void fill(It first, It last, const T &value, Thread_pool &pool = default_pool())
+    {
+        auto first_ptr = parallel::raw(first);
+        Chunks<typename std::remove_pointer<decltype(first_ptr)>::type>
+            chunks(first_ptr, parallel::raw(last) - first_ptr, pool);
+
+        pool.run(chunks.count(), [&](size_t k) {
+            std::fill(first_ptr + chunks.begin(k), first_ptr + chunks.end(k), value);
+        });
+    }
+
+    /**
+    \brief Returns number of elements of a that precede the k-th output element
+     of the stable merge of sorted ranges a and b.
+    */
+    template <typename T, typename Compare>
+    size_t merge_split(const T *a_ptr, size_t a_size, const T *b_ptr, size_t b_size, size_t k, Compare comp)
+    {
+        size_t low = k > b_size ? k - b_size : 0;
+        size_t high = std::min(k, a_size);
+
+        while (low < high) {
+            size_t i = low + (high - low) / 2;
+
+            if (!comp(b_ptr[k - i - 1], a_ptr[i])) {
+                low = i + 1;
+            } else {
+                high = i;
+            }
+        }
+        return low;
+    }
+
+    /**
+    \brief Sorts [first, last) with comp by parallel merge sort. Chunks are sorted
+     with std::sort, then merged pairwise in rounds; every merge is split into
+     independent parts at output positions found by binary search before merging
+     starts, so all threads work in every round. T must be default constructible and move assignable.
+    \param first, last Contiguous range.
+    \param comp Strict weak ordering.
+    \param pool Optional pool.
+    */
+    template <typename It, typename Compare>
+    void sort(It first, It last, Compare comp, Thread_pool &pool = default_pool())
+    {
+        typedef typename std::remove_pointer<decltype(parallel::raw(first))>::type T;
+        T *first_ptr = parallel::raw(first);
+        size_t n = parallel::raw(last) - first_ptr;
+        Chunks<T> chunks(first_ptr, n, pool, 1);
+
+        if (chunks.count() <= 1) {
+            std::sort(first_ptr, first_ptr + n, comp);
+            return;
+        }
+        size_t runs = chunks.count();
+        Vector<size_t> bounds;
+        for (size_t k = 0; k <= runs; ++k) {
+            bounds.push_back(chunks.begin(k));
+        }
+        pool.run(runs, [&](size_t k) { std::sort(first_ptr + bounds[k], first_ptr + bounds[k + 1], comp); });
+
+        Vector<T> buffer(n);
+        T *src_ptr = first_ptr;
+        T *dst_ptr = &buffer[0];
+        const size_t parts_target = pool.size() * 2;
+
+        Vector<size_t> splits;
+
+        while (runs > 1) {
+            size_t pairs = (runs + 1) / 2;
+            size_t parts = std::max<size_t>(1, parts_target / pairs);
+
+            //Split points are found before any part moves elements out of the source runs.
+            splits.resize(pairs * (parts + 1));
+            pool.run(pairs * (parts + 1), [&](size_t task) {
+                size_t pair = task / (parts + 1);
+                size_t lo = bounds[2 * pair];
+                size_t mid = bounds[std::min(2 * pair + 1, runs)];
+                size_t hi = bounds[std::min(2 * pair + 2, runs)];
+                size_t k = (hi - lo) * (task % (parts + 1)) / parts;
+                splits[task] = merge_split(src_ptr + lo, mid - lo, src_ptr + mid, hi - mid, k, comp);
+            });
+            pool.run(pairs * parts, [&](size_t task) {
+                size_t pair = task / parts;
+                size_t part = task % parts;
+                size_t lo = bounds[2 * pair];
+                size_t mid = bounds[std::min(2 * pair + 1, runs)];
+                size_t total = bounds[std::min(2 * pair + 2, runs)] - lo;
+                size_t k0 = total * part / parts;
+                size_t k1 = total * (part + 1) / parts;
+                size_t i0 = splits[pair * (parts + 1) + part];
+                size_t i1 = splits[pair * (parts + 1) + part + 1];
+
+                std::merge(std::make_move_iterator(src_ptr + lo + i0), std::make_move_iterator(src_ptr + lo + i1),
+                           std::make_move_iterator(src_ptr + mid + (k0 - i0)),
+                           std::make_move_iterator(src_ptr + mid + (k1 - i1)),
+                           dst_ptr + lo + k0, comp);
+            });
+            for (size_t r = 0; r <= pairs; ++r) {
+                bounds[r] = bounds[std::min(2 * r, runs)];
+            }
+            runs = pairs;
+            std::swap(src_ptr, dst_ptr);
+        }
+        if (src_ptr != first_ptr) {
+            parallel::transform(src_ptr, src_ptr + n, first_ptr, [](T &value) { return std::move(value); }, pool);
+        }
+    }
+
+    ///Sorts [first, last) in ascending order.
+    template <typename It>
+    void sort(It first, It last, Thread_pool &pool = default_pool())
+    {
+        typedef typename std::remove_pointer<decltype(parallel::raw(first))>::type T;
+        parallel::sort(first, last, std::less<T>(), pool);
+    }
+}
+}
+
+#endif
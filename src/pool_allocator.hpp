@@ -0,0 +1,313 @@
+/**
+\file 
+\brief File contains thread-local size-class Pool and Pool_allocator for Vector.
+*/
+
+#ifndef _POOL_ALLOCATOR_HPP_
+#define _POOL_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace tasks {
+
+    /**
+    \brief Size-class memory pool with a free list cache per thread.
+     Requests up to max_block bytes are rounded up to a power of two and served 
+     from the calling thread's free list without locking. Empty lists are refilled 
+     from a shared depot, which also receives the lists of exiting threads. 
+     Larger or over-aligned requests go to operator new directly.
+     After the thread's cache is destroyed, as in destructors of other thread_local
+     or static objects, blocks are taken from and returned to the depot under its lock.
+     Pool memory is kept for the lifetime of the process.
+    */
+    class Pool
+    {
+    public:
+        ///Smallest block size in bytes.
+        static const size_t min_block = 16;
+        ///Largest block size in bytes served from the pool.
+        static const size_t max_block = 64 * 1024;
+        ///Number of size classes, min_block * 2^i for i < classes.
+        static const size_t classes = 13;
+        ///Bytes carved into blocks on every refill of an empty depot list.
+        static const size_t chunk_bytes = 256 * 1024;
+
+        static void *allocate(size_t bytes, size_t alignment);
+        static void deallocate(void *ptr, size_t bytes, size_t alignment);
+
+    private:
+        /**
+        \brief Free block, the link is stored in the block itself.
+        */
+        struct Block
+        {
+            Block *next;
+        };
+
+        /**
+        \brief Free lists shared by all threads.
+        */
+        struct Depot
+        {
+            std::mutex mutex;
+            Block *free_lists[classes];
+        };
+
+        /**
+        \brief Free lists of one thread. Returns them to the depot on thread exit.
+        */
+        struct Cache
+        {
+            Block *free_lists[classes];
+
+            Cache();
+            ~Cache();
+        };
+
+        static size_t size_class(size_t bytes);
+        static Depot &depot();
+        static Cache &cache();
+        static bool &cache_destroyed();
+        static Block *refill(size_t index);
+        static Block *depot_allocate(size_t index);
+        static void depot_return(Block *list, size_t index);
+    };
+
+    /**
+    \brief Allocates memory.
+    \param bytes Number of bytes.
+    \param alignment Required alignment.
+    \return Pointer to allocated memory.
+    */
+    inline void *Pool::allocate(size_t bytes, size_t alignment)
+    {
+        if (bytes > max_block || alignment > min_block) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+        size_t index = size_class(bytes);
+
+        if (cache_destroyed()) {
+            return depot_allocate(index);
+        }
+        Block *&head = cache().free_lists[index];
+
+        if (!head) {
+            head = refill(index);
+        }
+        Block *block = head;
+        head = block->next;
+        return block;
+    }
+
+    /**
+    \brief Returns memory to the calling thread's free list, or to the depot once its cache is destroyed.
+    \param ptr Pointer returned by allocate.
+    \param bytes, alignment Values given to allocate.
+    */
+    inline void Pool::deallocate(void *ptr, size_t bytes, size_t alignment)
+    {
+        if (bytes > max_block || alignment > min_block) {
+            ::operator delete(ptr, std::align_val_t(alignment));
+            return;
+        }
+        size_t index = size_class(bytes);
+        Block *block = static_cast<Block *>(ptr);
+
+        if (cache_destroyed()) {
+            block->next = 0;
+            depot_return(block, index);
+            return;
+        }
+        Block *&head = cache().free_lists[index];
+        block->next = head;
+        head = block;
+    }
+
+    /**
+    \brief Calculates the size class for given number of bytes.
+    \param bytes Number of bytes, not greater than max_block.
+    \return Index of the smallest class holding given bytes.
+    */
+    inline size_t Pool::size_class(size_t bytes)
+    {
+        size_t index = 0;
+
+        for (size_t block = min_block; block < bytes; block *= 2) {
+            ++index;
+        }
+        return index;
+    }
+
+    ///Returns the depot. It is never destroyed so blocks stay valid until process exit.
+    inline Pool::Depot &Pool::depot()
+    {
+        static Depot *depot_ptr = new Depot();
+        return *depot_ptr;
+    }
+
+    ///Returns the cache of the calling thread.
+    inline Pool::Cache &Pool::cache()
+    {
+        static thread_local Cache thread_cache;
+        return thread_cache;
+    }
+
+    /**
+    \brief Returns the flag set once the cache of the calling thread is destroyed.
+     The flag is trivially destructible, so it stays readable in destructors of other
+     thread_local objects running after the cache one, and of static objects.
+    */
+    inline bool &Pool::cache_destroyed()
+    {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    /**
+    \brief Takes the depot list of given class or carves a new chunk into blocks.
+    \param index Size class.
+    \return Nonempty list of free blocks.
+    */
+    inline Pool::Block *Pool::refill(size_t index)
+    {
+        Depot &shared = depot();
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            Block *list = shared.free_lists[index];
+
+            if (list) {
+                shared.free_lists[index] = 0;
+                return list;
+            }
+        }
+        size_t block_size = min_block << index;
+        size_t count = chunk_bytes / block_size;
+        char *chunk = static_cast<char *>(::operator new(count * block_size));
+        Block *list = 0;
+
+        for (size_t i = count; i > 0; --i) {
+            Block *block = reinterpret_cast<Block *>(chunk + (i - 1) * block_size);
+            block->next = list;
+            list = block;
+        }
+        return list;
+    }
+
+    /**
+    \brief Takes one block of given class from the depot, for a thread without cache.
+    \param index Size class.
+    \return Free block.
+    */
+    inline Pool::Block *Pool::depot_allocate(size_t index)
+    {
+        Depot &shared = depot();
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            Block *block = shared.free_lists[index];
+
+            if (block) {
+                shared.free_lists[index] = block->next;
+                return block;
+            }
+        }
+        Block *block = refill(index);
+        if (block->next) {
+            depot_return(block->next, index);
+        }
+        return block;
+    }
+
+    /**
+    \brief Splices a list of free blocks into the depot list of given class.
+    \param list Nonempty list of free blocks.
+    \param index Size class.
+    */
+    inline void Pool::depot_return(Block *list, size_t index)
+    {
+        Depot &shared = depot();
+        Block *tail = list;
+
+        while (tail->next) {
+            tail = tail->next;
+        }
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        tail->next = shared.free_lists[index];
+        shared.free_lists[index] = list;
+    }
+
+    ///Constructor. Touches the depot so it outlives every thread cache.
+    inline Pool::Cache::Cache()
+    {
+        depot();
+        for (size_t i = 0; i < classes; ++i) {
+            free_lists[i] = 0;
+        }
+    }
+
+    ///Destructor. Splices the free lists of the exiting thread into the depot, later calls of the thread use the depot.
+    inline Pool::Cache::~Cache()
+    {
+        cache_destroyed() = true;
+        for (size_t i = 0; i < classes; ++i) {
+            if (free_lists[i]) {
+                depot_return(free_lists[i], i);
+            }
+        }
+    }
+
+    /**
+    \brief Stateless standard allocator drawing memory from the thread-local Pool.
+     Memory may be freed by any thread.
+    */
+    template <typename T>
+    class Pool_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef std::true_type is_always_equal;
+
+        ///Default constructor.
+        Pool_allocator() { }
+        ///Converting constructor used for rebinding.
+        template <typename U>
+        Pool_allocator(const Pool_allocator<U> &) { }
+
+        /**
+        \brief Allocates memory for given number of objects.
+        \param count Number of objects.
+        \return Pointer to allocated memory.
+         Throws std::bad_array_new_length if the size in bytes does not fit in size_t.
+        */
+        T *allocate(size_t count)
+        {
+            if (count > SIZE_MAX / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(Pool::allocate(count * sizeof(T), alignof(T)));
+        }
+
+        /**
+        \brief Returns memory to the pool.
+        \param ptr Pointer returned by allocate.
+        \param count Number of objects given to allocate.
+        */
+        void deallocate(T *ptr, size_t count)
+        {
+            Pool::deallocate(ptr, count * sizeof(T), alignof(T));
+        }
+
+        ///All pool allocators are equal.
+        template <typename U>
+        bool operator==(const Pool_allocator<U> &) const { return true; }
+
+        ///All pool allocators are equal.
+        template <typename U>
+        bool operator!=(const Pool_allocator<U> &) const { return false; }
+    };
+}
+
+#endif
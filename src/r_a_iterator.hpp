@@ -8,121 +8,87 @@
 
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 
 namespace tasks {
 
-    template <typename T>
+    template <typename T, typename Allocator, typename Growth>
     class Vector;
 
     /**
     \brief Base template class representing base iterator. 
     */
     template <typename T>
-    class Base_r_a_iterator : public std::iterator<std::random_access_iterator_tag, T>
+    class Base_r_a_iterator
     {
-        friend class Vector<T>;
+        template <typename U, typename Allocator, typename Growth>
+        friend class Vector;
     protected:
         ///Pointer to an object on which iterator points.
         T* m_referee_ptr;
         T* get_ptr() const { return m_referee_ptr; }
-        //typename std::iterator<std::random_access_iterator_tag, T>::pointer m_referee_ptr;
     public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename std::remove_cv<T>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T *pointer;
+        typedef T &reference;
+
         /**
         \brief Default constructor.
         \param w_ptr Pointer to an object. 
         */
         Base_r_a_iterator(const T *w_ptr = 0) : m_referee_ptr(const_cast<T *>(w_ptr)) { }
-        T &operator*();
-        const T &operator*() const;
-        T *operator->();
-        const T *operator->() const;
-        bool operator==(Base_r_a_iterator<T> iter) const; 
-        bool operator!=(Base_r_a_iterator<T> iter) const;
-        bool operator<(Base_r_a_iterator<T> iter) const;
+        T &operator*() const;
+        T *operator->() const;
     };
 
     ///returns reference  to an object.
     template <typename T>
-    T &Base_r_a_iterator<T>::operator*()
-    {
-        return *m_referee_ptr;
-    }
-
-    ///returns const reference  to an object.
-    template <typename T>
-    const T &Base_r_a_iterator<T>::operator*() const
+    T &Base_r_a_iterator<T>::operator*() const
     {
         return *m_referee_ptr;
     }
 
     ///returns pointer to an object. 
     template <typename T>
-    T *Base_r_a_iterator<T>::operator->()
+    T *Base_r_a_iterator<T>::operator->() const
     {
         return m_referee_ptr;
     }
 
-    ///returns const pointer to an object. 
-    template <typename T>
-    const T *Base_r_a_iterator<T>::operator->() const
-    {
-        return m_referee_ptr; 
-    }
-
     /**
-    \brief Compare equality of two iterators.
-    \param iter Iterator to compare with.
-    \return true if equal, false if not.
-    */
-    template <typename T>
-    bool Base_r_a_iterator<T>::operator==(Base_r_a_iterator<T> iter) const 
-    { 
-        return m_referee_ptr == iter.m_referee_ptr;
-    }
-
-    /**
-    \brief Compare non equality of two iterators.
-    \param iter Iterator to compare with.
-    \return true if non equal, false if equal;
-    */
-    template <typename T>
-    bool Base_r_a_iterator<T>::operator!=(Base_r_a_iterator<T> iter) const
-    {
-        return !(*this == iter);
-    }
-    
-    /**
-    \brief Compare if iterator is less than given iterator.
-    \param iter Iterator to compare with.
-    \return true if less than given, false if not.
-    */
-    template <typename T>
-    bool Base_r_a_iterator<T>::operator<(Base_r_a_iterator<T> iter) const 
-    { 
-        return m_referee_ptr < iter.m_referee_ptr;
-    }
-
-    /**
-    \brief Template iterator class.
+    \brief Template contiguous iterator class, a thin wrapper of T * with the full set
+     of random access operations and signed offsets. R_a_iterator<const T> is the constant
+     iterator, R_a_iterator<T> converts to it and the two compare with each other.
     */
     template <typename T>
     class R_a_iterator : public Base_r_a_iterator<T>
     {
     public:
+        typedef typename Base_r_a_iterator<T>::difference_type difference_type;
+
         /**
         \brief Default constructor.
         \param w_ptr Pointer to an object. 
         */
         R_a_iterator(const T *w_ptr = 0) : Base_r_a_iterator<T>(w_ptr) { }
+        ///Conversion from iterator of non-constant elements.
+        template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+        R_a_iterator(const R_a_iterator<U> &iter) : Base_r_a_iterator<T>(iter.operator->()) { }
+        T &operator[](difference_type offset) const { return this->m_referee_ptr[offset]; }
         R_a_iterator<T> &operator++();
         R_a_iterator<T> operator++(int);
         R_a_iterator<T> &operator--();
         R_a_iterator<T> operator--(int);
-        R_a_iterator<T> operator+(const unsigned value) const;
-        R_a_iterator<T> operator-(const unsigned value) const;
-        ptrdiff_t operator-(const R_a_iterator<T> iter) const;
-        R_a_iterator<T> &operator+=(const unsigned value);
-        R_a_iterator<T> &operator-=(const unsigned value);
+        R_a_iterator<T> operator+(difference_type offset) const;
+        R_a_iterator<T> operator-(difference_type offset) const;
+        difference_type operator-(const R_a_iterator<T> iter) const;
+        R_a_iterator<T> &operator+=(difference_type offset);
+        R_a_iterator<T> &operator-=(difference_type offset);
+
+        ///Returns iterator offset elements after iter.
+        friend R_a_iterator<T> operator+(difference_type offset, R_a_iterator<T> iter) { return iter + offset; }
     };
 
     /**
@@ -131,7 +97,7 @@ namespace tasks {
     \return Distance of two iterators.
     */
     template <typename T>
-    ptrdiff_t R_a_iterator<T>::operator-(const R_a_iterator<T> iter) const
+    typename R_a_iterator<T>::difference_type R_a_iterator<T>::operator-(const R_a_iterator<T> iter) const
     {
          return this->m_referee_ptr - iter.m_referee_ptr;
     }
@@ -184,11 +150,11 @@ namespace tasks {
 
     /**
     \brief Performs addition assignment to iterator with given value.
-    \param offset Value for adding to an iterator.
+    \param offset Value for adding to an iterator, may be negative.
     \return Iterator after addition assignment.
     */
     template <typename T>
-    R_a_iterator<T> &R_a_iterator<T>::operator+=(const unsigned offset)
+    R_a_iterator<T> &R_a_iterator<T>::operator+=(difference_type offset)
     {
         this->m_referee_ptr += offset;
         return *this;
@@ -196,11 +162,11 @@ namespace tasks {
 
     /**
     \brief Performs addition to iterator with given value.
-    \param offset Value for adding to an iterator.
+    \param offset Value for adding to an iterator, may be negative.
     \return Temperary iterator as an addition result.
     */
     template <typename T>
-    R_a_iterator<T> R_a_iterator<T>::operator+(const unsigned offset) const
+    R_a_iterator<T> R_a_iterator<T>::operator+(difference_type offset) const
     {
         R_a_iterator<T> temp(this->m_referee_ptr + offset);
         return temp;
@@ -208,11 +174,11 @@ namespace tasks {
 
     /**
     \brief Performs subtraction assignment to iterator with given value.
-    \param offset Value for subtracting from an iterator.
+    \param offset Value for subtracting from an iterator, may be negative.
     \return Iterator after subtraction assignment.
     */
     template <typename T>
-    R_a_iterator<T> &R_a_iterator<T>::operator-=(const unsigned offset)
+    R_a_iterator<T> &R_a_iterator<T>::operator-=(difference_type offset)
     {
         this->m_referee_ptr -= offset;
         return *this;
@@ -220,38 +186,115 @@ namespace tasks {
 
     /**
     \brief Performs subtraction from iterator with given value.
-    \param offset Value for subtracting from an iterator.
+    \param offset Value for subtracting from an iterator, may be negative.
     \return Temperary iterator as a subtraction result.
     */
     template <typename T>
-    R_a_iterator<T> R_a_iterator<T>::operator-(const unsigned offset) const
+    R_a_iterator<T> R_a_iterator<T>::operator-(difference_type offset) const
     {
         R_a_iterator<T> temp(this->m_referee_ptr - offset);
         return temp;
     }
 
+    ///Returns distance of an iterator and a constant iterator.
+    template <typename T, typename U>
+    std::ptrdiff_t operator-(const R_a_iterator<T> &left, const R_a_iterator<U> &right)
+    {
+        return left.operator->() - right.operator->();
+    }
+
+    //Comparisons of iterators, also of an iterator with a constant iterator.
+
+    template <typename T, typename U>
+    bool operator==(const R_a_iterator<T> &left, const R_a_iterator<U> &right)
+    {
+        return left.operator->() == right.operator->();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const R_a_iterator<T> &left, const R_a_iterator<U> &right)
+    {
+        return left.operator->() != right.operator->();
+    }
+
+    template <typename T, typename U>
+    bool operator<(const R_a_iterator<T> &left, const R_a_iterator<U> &right)
+    {
+        return left.operator->() < right.operator->();
+    }
+
+    template <typename T, typename U>
+    bool operator>(const R_a_iterator<T> &left, const R_a_iterator<U> &right)
+    {
+        return left.operator->() > right.operator->();
+    }
+
+    template <typename T, typename U>
+    bool operator<=(const R_a_iterator<T> &left, const R_a_iterator<U> &right)
+    {
+        return left.operator->() <= right.operator->();
+    }
+
+    template <typename T, typename U>
+    bool operator>=(const R_a_iterator<T> &left, const R_a_iterator<U> &right)
+    {
+        return left.operator->() >= right.operator->();
+    }
+
     /**
-    \brief Template reverse iterator.
+    \brief Template reverse iterator, an adaptor of the contiguous iterator R_a_iterator<T>.
+     It keeps the forward iterator one past the element it refers to, like std::reverse_iterator,
+     so rend() of a vector holds begin() and never forms a pointer before the storage.
+     Dereferencing reads base()[-1], which the compiler folds into the addressing of a
+     plain pointer loop. Reverse_r_a_iterator<const T> is the constant reverse iterator.
     */
     template <typename T>
-    class Reverse_r_a_iterator : public Base_r_a_iterator<T>
+    class Reverse_r_a_iterator
     {
     public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename std::remove_cv<T>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T *pointer;
+        typedef T &reference;
+        typedef R_a_iterator<T> iterator_type;
+
         /**
         \brief Default constructor.
-        \param w_ptr Pointer to an object. 
+        \param w_ptr Pointer past the object the iterator refers to.
         */
-        Reverse_r_a_iterator(const T *w_ptr = 0) : Base_r_a_iterator<T>(w_ptr - 1) { }
+        Reverse_r_a_iterator(const T *w_ptr = 0) : m_base(w_ptr) { }
+        ///Constructor of iterator referring to the element before base.
+        explicit Reverse_r_a_iterator(R_a_iterator<T> base) : m_base(base) { }
+        ///Conversion from reverse iterator of non-constant elements.
+        template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+        Reverse_r_a_iterator(const Reverse_r_a_iterator<U> &iter) : m_base(iter.base()) { }
+
+        ///Returns the forward iterator one past the referred element.
+        R_a_iterator<T> base() const { return m_base; }
+        operator R_a_iterator<T>() const;
+        T &operator*() const { return m_base[-1]; }
+        T *operator->() const { return (m_base - 1).operator->(); }
+        T &operator[](difference_type offset) const { return m_base[-offset - 1]; }
         Reverse_r_a_iterator<T> &operator++();
         Reverse_r_a_iterator<T> operator++(int);
         Reverse_r_a_iterator<T> &operator--();
         Reverse_r_a_iterator<T> operator--(int);
-        Reverse_r_a_iterator<T> operator+(const unsigned value) const;
-        Reverse_r_a_iterator<T> operator-(const unsigned value) const;
-        operator R_a_iterator<T>() const;
-        ptrdiff_t operator-(const Reverse_r_a_iterator<T> iter) const;
-        Reverse_r_a_iterator<T> &operator+=(const unsigned value);
-        Reverse_r_a_iterator<T> &operator-=(const unsigned value);
+        Reverse_r_a_iterator<T> operator+(difference_type offset) const;
+        Reverse_r_a_iterator<T> operator-(difference_type offset) const;
+        difference_type operator-(const Reverse_r_a_iterator<T> iter) const;
+        Reverse_r_a_iterator<T> &operator+=(difference_type offset);
+        Reverse_r_a_iterator<T> &operator-=(difference_type offset);
+
+        ///Returns iterator offset elements after iter.
+        friend Reverse_r_a_iterator<T> operator+(difference_type offset, Reverse_r_a_iterator<T> iter)
+        {
+            return iter + offset;
+        }
+
+    private:
+        ///Forward iterator one past the referred element.
+        R_a_iterator<T> m_base;
     };
 
     /**
@@ -260,9 +303,10 @@ namespace tasks {
     \return Distance of two iterators.
     */
     template <typename T>
-    ptrdiff_t Reverse_r_a_iterator<T>::operator-(const Reverse_r_a_iterator<T> iter) const
+    typename Reverse_r_a_iterator<T>::difference_type
+    Reverse_r_a_iterator<T>::operator-(const Reverse_r_a_iterator<T> iter) const
     {
-         return iter.m_referee_ptr - this->m_referee_ptr;
+         return iter.m_base - m_base;
     }
 
     /**
@@ -272,7 +316,7 @@ namespace tasks {
     template <typename T>
     Reverse_r_a_iterator<T> &Reverse_r_a_iterator<T>::operator++()
     {
-        --this->m_referee_ptr;
+        --m_base;
         return *this;
     }
 
@@ -284,7 +328,7 @@ namespace tasks {
     Reverse_r_a_iterator<T> Reverse_r_a_iterator<T>::operator++(int)
     {
         Reverse_r_a_iterator<T> temp = *this;
-        --this->m_referee_ptr;
+        --m_base;
         return temp;
     }
 
@@ -295,77 +339,236 @@ namespace tasks {
     template <typename T>
     Reverse_r_a_iterator<T> &Reverse_r_a_iterator<T>::operator--()
     {
-        ++this->m_referee_ptr;
+        ++m_base;
         return *this;
     }
 
     /**
-    \brief Postincrements iterator.
-    \return Iterator before incrementing.
+    \brief Postdecrements iterator.
+    \return Iterator before decrementing.
     */
     template <typename T>
     Reverse_r_a_iterator<T> Reverse_r_a_iterator<T>::operator--(int)
     {
         Reverse_r_a_iterator<T> temp = *this;
-        ++this->m_referee_ptr;
+        ++m_base;
         return temp;
     }
 
     /**
     \brief Performs addition assignment to iterator with given value.
-    \param offset Value for adding to an iterator.
+    \param offset Number of elements to move towards the front, may be negative.
     \return Iterator after addition assignment.
     */
     template <typename T>
-    Reverse_r_a_iterator<T> &Reverse_r_a_iterator<T>::operator+=(const unsigned offset)
+    Reverse_r_a_iterator<T> &Reverse_r_a_iterator<T>::operator+=(difference_type offset)
     {
-        this->m_referee_ptr -= offset;
+        m_base -= offset;
         return *this;
     }
 
     /**
     \brief Performs addition to iterator with given value.
-    \param offset Value for adding to an iterator.
+    \param offset Number of elements to move towards the front, may be negative.
     \return Temperary iterator as an addition result.
     */
     template <typename T>
-    Reverse_r_a_iterator<T> Reverse_r_a_iterator<T>::operator+(const unsigned offset) const
+    Reverse_r_a_iterator<T> Reverse_r_a_iterator<T>::operator+(difference_type offset) const
     {
-        Reverse_r_a_iterator<T> temp(this->m_referee_ptr + offset);
-        return temp;
+        return Reverse_r_a_iterator<T>(m_base - offset);
     }
 
     /**
     \brief Performs subtraction assignment to iterator with given value.
-    \param offset Value for subtracting from an iterator.
+    \param offset Number of elements to move towards the back, may be negative.
     \return Iterator after subtraction assignment.
     */
     template <typename T>
-    Reverse_r_a_iterator<T> &Reverse_r_a_iterator<T>::operator-=(const unsigned offset)
+    Reverse_r_a_iterator<T> &Reverse_r_a_iterator<T>::operator-=(difference_type offset)
     {
-        this->m_referee_ptr += offset;
+        m_base += offset;
         return *this;
     }
 
     /**
     \brief Performs subtraction from iterator with given value.
-    \param offset Value for subtracting from an iterator.
+    \param offset Number of elements to move towards the back, may be negative.
     \return Temperary iterator as a subtraction result.
     */
     template <typename T>
-    Reverse_r_a_iterator<T> Reverse_r_a_iterator<T>::operator-(const unsigned offset) const
+    Reverse_r_a_iterator<T> Reverse_r_a_iterator<T>::operator-(difference_type offset) const
     {
-        Reverse_r_a_iterator<T> temp(this->m_referee_ptr + offset);
-        return temp;
+        return Reverse_r_a_iterator<T>(m_base + offset);
     }
 
     /**
-    \brief Conversion to a specified type.
+    \brief Conversion to the forward iterator one past the referred element,
+     rend() converts to begin().
     */
     template <typename T>
     Reverse_r_a_iterator<T>::operator R_a_iterator<T>() const
     {
-       return R_a_iterator<T>(this->m_referee_ptr + 1);
+       return m_base;
+    }
+
+    ///Returns distance of a reverse iterator and a constant reverse iterator.
+    template <typename T, typename U>
+    std::ptrdiff_t operator-(const Reverse_r_a_iterator<T> &left, const Reverse_r_a_iterator<U> &right)
+    {
+        return right.base() - left.base();
+    }
+
+    //Comparisons of reverse iterators, reversed comparisons of their bases.
+
+    template <typename T, typename U>
+    bool operator==(const Reverse_r_a_iterator<T> &left, const Reverse_r_a_iterator<U> &right)
+    {
+        return left.base() == right.base();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const Reverse_r_a_iterator<T> &left, const Reverse_r_a_iterator<U> &right)
+    {
+        return left.base() != right.base();
+    }
+
+    template <typename T, typename U>
+    bool operator<(const Reverse_r_a_iterator<T> &left, const Reverse_r_a_iterator<U> &right)
+    {
+        return right.base() < left.base();
+    }
+
+    template <typename T, typename U>
+    bool operator>(const Reverse_r_a_iterator<T> &left, const Reverse_r_a_iterator<U> &right)
+    {
+        return right.base() > left.base();
+    }
+
+    template <typename T, typename U>
+    bool operator<=(const Reverse_r_a_iterator<T> &left, const Reverse_r_a_iterator<U> &right)
+    {
+        return right.base() <= left.base();
+    }
+
+    template <typename T, typename U>
+    bool operator>=(const Reverse_r_a_iterator<T> &left, const Reverse_r_a_iterator<U> &right)
+    {
+        return right.base() >= left.base();
+    }
+
+    /**
+    \brief Template random access iterator of containers whose elements are not contiguous,
+     holding the container and an element index. Dereferencing returns (*owner)[index], so
+     Reference is the type operator[] of Owner returns: a reference of element, a proxy
+     or a value. Indexed_iterator<const Owner, ...> is the constant iterator, the iterator
+     of a non-constant owner converts to it and the two compare with each other.
+    */
+    template <typename Owner, typename Reference>
+    class Indexed_iterator
+    {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename std::remove_const<Owner>::type::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<std::is_reference<Reference>::value,
+                                          typename std::remove_reference<Reference>::type *, void>::type pointer;
+        typedef Reference reference;
+
+        ///Default constructor.
+        Indexed_iterator() : m_owner_ptr(0), m_index(0) { }
+        ///Constructor of iterator to element index of owner.
+        Indexed_iterator(Owner *owner_ptr, size_t index) : m_owner_ptr(owner_ptr), m_index(index) { }
+        ///Conversion from iterator of a non-constant owner.
+        template <typename Other, typename Other_reference,
+                  typename = typename std::enable_if<std::is_same<const Other, Owner>::value
+                                                     && !std::is_same<Other, Owner>::value>::type>
+        Indexed_iterator(const Indexed_iterator<Other, Other_reference> &iter)
+            : m_owner_ptr(iter.owner()), m_index(iter.index()) { }
+
+        reference operator*() const { return (*m_owner_ptr)[m_index]; }
+        ///Returns pointer to the element, only for owners returning references of elements.
+        pointer operator->() const { return &(*m_owner_ptr)[m_index]; }
+        reference operator[](difference_type offset) const { return (*m_owner_ptr)[m_index + offset]; }
+
+        Indexed_iterator &operator++() { ++m_index; return *this; }
+        Indexed_iterator operator++(int) { Indexed_iterator old(*this); ++m_index; return old; }
+        Indexed_iterator &operator--() { --m_index; return *this; }
+        Indexed_iterator operator--(int) { Indexed_iterator old(*this); --m_index; return old; }
+        Indexed_iterator &operator+=(difference_type offset) { m_index += offset; return *this; }
+        Indexed_iterator &operator-=(difference_type offset) { m_index -= offset; return *this; }
+        Indexed_iterator operator+(difference_type offset) const { return Indexed_iterator(m_owner_ptr, m_index + offset); }
+        Indexed_iterator operator-(difference_type offset) const { return Indexed_iterator(m_owner_ptr, m_index - offset); }
+
+        ///Returns iterator offset elements after iter.
+        friend Indexed_iterator operator+(difference_type offset, Indexed_iterator iter) { return iter + offset; }
+
+        ///Returns the container.
+        Owner *owner() const { return m_owner_ptr; }
+        ///Returns index of the element.
+        size_t index() const { return m_index; }
+
+    private:
+        Owner *m_owner_ptr;
+        size_t m_index;
+    };
+
+    ///Returns distance of two iterators of the same owner type, also of an iterator and a constant iterator.
+    template <typename O, typename R, typename P, typename S,
+              typename = typename std::enable_if<std::is_same<typename std::remove_const<O>::type,
+                                                              typename std::remove_const<P>::type>::value>::type>
+    std::ptrdiff_t operator-(const Indexed_iterator<O, R> &left, const Indexed_iterator<P, S> &right)
+    {
+        return std::ptrdiff_t(left.index() - right.index());
+    }
+
+    //Comparisons of iterators of the same owner type, also of an iterator with a constant iterator.
+
+    template <typename O, typename R, typename P, typename S,
+              typename = typename std::enable_if<std::is_same<typename std::remove_const<O>::type,
+                                                              typename std::remove_const<P>::type>::value>::type>
+    bool operator==(const Indexed_iterator<O, R> &left, const Indexed_iterator<P, S> &right)
+    {
+        return left.index() == right.index();
+    }
+
+    template <typename O, typename R, typename P, typename S,
+              typename = typename std::enable_if<std::is_same<typename std::remove_const<O>::type,
+                                                              typename std::remove_const<P>::type>::value>::type>
+    bool operator!=(const Indexed_iterator<O, R> &left, const Indexed_iterator<P, S> &right)
+    {
+        return left.index() != right.index();
+    }
+
+    template <typename O, typename R, typename P, typename S,
+              typename = typename std::enable_if<std::is_same<typename std::remove_const<O>::type,
+                                                              typename std::remove_const<P>::type>::value>::type>
+    bool operator<(const Indexed_iterator<O, R> &left, const Indexed_iterator<P, S> &right)
+    {
+        return left.index() < right.index();
+    }
+
+    template <typename O, typename R, typename P, typename S,
+              typename = typename std::enable_if<std::is_same<typename std::remove_const<O>::type,
+                                                              typename std::remove_const<P>::type>::value>::type>
+    bool operator>(const Indexed_iterator<O, R> &left, const Indexed_iterator<P, S> &right)
+    {
+        return left.index() > right.index();
+    }
+
+    template <typename O, typename R, typename P, typename S,
+              typename = typename std::enable_if<std::is_same<typename std::remove_const<O>::type,
+                                                              typename std::remove_const<P>::type>::value>::type>
+    bool operator<=(const Indexed_iterator<O, R> &left, const Indexed_iterator<P, S> &right)
+    {
+        return left.index() <= right.index();
+    }
+
+    template <typename O, typename R, typename P, typename S,
+              typename = typename std::enable_if<std::is_same<typename std::remove_const<O>::type,
+                                                              typename std::remove_const<P>::type>::value>::type>
+    bool operator>=(const Indexed_iterator<O, R> &left, const Indexed_iterator<P, S> &right)
+    {
+        return left.index() >= right.index();
     }
 }
 
@@ -0,0 +1,499 @@
+/**
+\file
+\brief File contains definition of template Ring_vector class, a double-ended queue
+ in one circular buffer.
+*/
+
+#ifndef _RING_VECTOR_HPP_
+#define _RING_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "smart_array.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector with amortized constant time push_front, push_back, pop_front and pop_back.
+     Elements live in one buffer of power of two capacity used as a ring: element i is
+     at slot (head + i) & (capacity - 1). A full ring doubles its buffer and moves the
+     elements to the start of it, otherwise no element is moved by pushing or popping.
+     Iterators are Indexed_iterator, holding the vector and an index, pushing and
+     popping at the front shifts the indices, so keep them only while the vector is unchanged.
+     linearize() returns the elements as a contiguous Vector.
+    */
+    template <typename T, typename Allocator = std::allocator<T> >
+    class Ring_vector
+    {
+        typedef std::allocator_traits<Allocator> alloc_traits;
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef Allocator allocator_type;
+
+        ///Capacity of the first buffer.
+        static const size_type min_capacity = 8;
+
+        typedef Indexed_iterator<Ring_vector, T &> iterator;
+        typedef Indexed_iterator<const Ring_vector, const T &> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        ///Default constructor, allocates nothing.
+        Ring_vector() : v_buffer_ptr(0), v_capacity(0), v_head(0), v_size(0), v_alloc() {}
+        ///Constructor of an empty vector using given allocator.
+        explicit Ring_vector(const Allocator &alloc)
+            : v_buffer_ptr(0), v_capacity(0), v_head(0), v_size(0), v_alloc(alloc) {}
+        Ring_vector(const size_type, const T & = T(), const Allocator & = Allocator());
+        Ring_vector(const Ring_vector &vec);
+        Ring_vector(Ring_vector &&vec) noexcept;
+        template <typename In, typename = typename std::iterator_traits<In>::iterator_category>
+        Ring_vector(In, In, const Allocator & = Allocator());
+        ~Ring_vector(void);
+
+        const Ring_vector &operator=(const Ring_vector &);
+        const Ring_vector &operator=(Ring_vector &&) noexcept;
+        bool operator==(const Ring_vector &) const;
+        bool operator!=(const Ring_vector &vec) const { return !(*this == vec); }
+        T &operator[](const size_type i) { return v_buffer_ptr[(v_head + i) & (v_capacity - 1)]; }
+        const T &operator[](const size_type i) const { return v_buffer_ptr[(v_head + i) & (v_capacity - 1)]; }
+        T &at(size_type);
+        const T &at(size_type) const;
+        void push_back(const T &value) { emplace_back(value); }
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        void push_front(const T &value) { emplace_front(value); }
+        void push_front(T &&value) { emplace_front(std::move(value)); }
+        template <typename... Args>
+        T &emplace_back(Args &&...);
+        template <typename... Args>
+        T &emplace_front(Args &&...);
+        void pop_back();
+        void pop_front();
+        T &front() { return (*this)[0]; }
+        T &back() { return (*this)[v_size - 1]; }
+        const T &front() const { return (*this)[0]; }
+        const T &back() const { return (*this)[v_size - 1]; }
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, v_size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, v_size); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        bool empty() const { return 0 == v_size; }
+        size_type capacity() const { return v_capacity; }
+        size_type size() const { return v_size; }
+        void reserve(const size_type);
+        void swap(Ring_vector &) noexcept;
+        void clear();
+        Vector<T, Allocator> linearize() const &;
+        Vector<T, Allocator> linearize() &&;
+        size_type max_size() const { return alloc_traits::max_size(v_alloc); }
+        allocator_type get_allocator() const { return v_alloc; }
+
+    private:
+        ///Pointer to the ring buffer of v_capacity slots.
+        T *v_buffer_ptr;
+        ///Number of slots, 0 or a power of two.
+        size_type v_capacity;
+        ///Slot of the first element.
+        size_type v_head;
+        ///Number of elements in vector.
+        size_type v_size;
+        ///Allocator providing the buffer.
+        Allocator v_alloc;
+
+        ///Returns number of elements from the head to the end of the buffer.
+        size_type first_run() const { return std::min(v_size, v_capacity - v_head); }
+        size_type round_capacity(const size_type count) const;
+        template <typename... Args>
+        void grow_emplace(const bool at_front, Args &&...);
+        void relocate(T *new_ptr);
+        void replace_buffer(T *new_ptr, const size_type new_cap, const size_type new_head);
+    };
+
+    template <typename T, typename Allocator>
+    const typename Ring_vector<T, Allocator>::size_type Ring_vector<T, Allocator>::min_capacity;
+
+    /**
+    \brief Constructor of vector with size copies of value.
+    \param size Number of elements.
+    \param value Value of elements.
+    \param alloc Allocator of the vector.
+    */
+    template <typename T, typename Allocator>
+    Ring_vector<T, Allocator>::Ring_vector(const size_type size, const T &value, const Allocator &alloc)
+        : v_buffer_ptr(0), v_capacity(0), v_head(0), v_size(0), v_alloc(alloc)
+    {
+        reserve(size);
+        try {
+            tasks::uninitialized_fill(v_buffer_ptr, v_buffer_ptr + size, value);
+        } catch (...) {
+            alloc_traits::deallocate(v_alloc, v_buffer_ptr, v_capacity);
+            throw;
+        }
+        v_size = size;
+    }
+
+    ///Copy constructor, the copy starts at the first slot of its buffer.
+    template <typename T, typename Allocator>
+    Ring_vector<T, Allocator>::Ring_vector(const Ring_vector &vec)
+        : v_buffer_ptr(0), v_capacity(0), v_head(0), v_size(0),
+          v_alloc(alloc_traits::select_on_container_copy_construction(vec.v_alloc))
+    {
+        if (!vec.v_size) {
+            return;
+        }
+        size_type run = vec.first_run();
+        size_type new_cap = round_capacity(vec.v_size);
+        T *new_ptr = alloc_traits::allocate(v_alloc, new_cap);
+
+        try {
+            tasks::uninitialized_copy(new_ptr, vec.v_buffer_ptr + vec.v_head, new_ptr + run);
+            try {
+                tasks::uninitialized_copy(new_ptr + run, vec.v_buffer_ptr, new_ptr + vec.v_size);
+            } catch (...) {
+                tasks::destroy(new_ptr, new_ptr + run);
+                throw;
+            }
+        } catch (...) {
+            alloc_traits::deallocate(v_alloc, new_ptr, new_cap);
+            throw;
+        }
+        v_buffer_ptr = new_ptr;
+        v_capacity = new_cap;
+        v_size = vec.v_size;
+    }
+
+    ///Move constructor, takes the buffer of vec.
+    template <typename T, typename Allocator>
+    Ring_vector<T, Allocator>::Ring_vector(Ring_vector &&vec) noexcept
+        : v_buffer_ptr(vec.v_buffer_ptr), v_capacity(vec.v_capacity), v_head(vec.v_head), v_size(vec.v_size),
+          v_alloc(std::move(vec.v_alloc))
+    {
+        vec.v_buffer_ptr = 0;
+        vec.v_capacity = 0;
+        vec.v_head = 0;
+        vec.v_size = 0;
+    }
+
+    /**
+    \brief Constructor of vector with the contents of the range [first, last).
+    \param first, last Input iterators.
+    \param alloc Allocator of the vector.
+    */
+    template <typename T, typename Allocator>
+    template <typename In, typename>
+    Ring_vector<T, Allocator>::Ring_vector(In first, In last, const Allocator &alloc)
+        : v_buffer_ptr(0), v_capacity(0), v_head(0), v_size(0), v_alloc(alloc)
+    {
+        try {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        } catch (...) {
+            clear();
+            alloc_traits::deallocate(v_alloc, v_buffer_ptr, v_capacity);
+            throw;
+        }
+    }
+
+    ///Destructor.
+    template <typename T, typename Allocator>
+    Ring_vector<T, Allocator>::~Ring_vector(void)
+    {
+        clear();
+        if (v_buffer_ptr) {
+            alloc_traits::deallocate(v_alloc, v_buffer_ptr, v_capacity);
+        }
+    }
+
+    ///Copy assignment, gives strong guarantee by copying first.
+    template <typename T, typename Allocator>
+    const Ring_vector<T, Allocator> &Ring_vector<T, Allocator>::operator=(const Ring_vector &vec)
+    {
+        if (this != &vec) {
+            Ring_vector temp(vec);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ///Move assignment, frees own elements and takes the buffer of vec.
+    template <typename T, typename Allocator>
+    const Ring_vector<T, Allocator> &Ring_vector<T, Allocator>::operator=(Ring_vector &&vec) noexcept
+    {
+        if (this != &vec) {
+            Ring_vector temp(std::move(vec));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    /**
+    \brief Compares sizes and elements of two vectors, positions of the heads do not matter.
+    */
+    template <typename T, typename Allocator>
+    bool Ring_vector<T, Allocator>::operator==(const Ring_vector &vec) const
+    {
+        return v_size == vec.v_size && std::equal(begin(), end(), vec.begin());
+    }
+
+    /**
+    \brief Returns element i. Throws std::out_of_range if i is not less than size.
+    */
+    template <typename T, typename Allocator>
+    T &Ring_vector<T, Allocator>::at(size_type i)
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Returns element i. Throws std::out_of_range if i is not less than size.
+    */
+    template <typename T, typename Allocator>
+    const T &Ring_vector<T, Allocator>::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Appends element constructed from args.
+    \param args Arguments of the element constructor, may refer to elements of the vector.
+    \return Reference to the new element.
+    */
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    T &Ring_vector<T, Allocator>::emplace_back(Args &&... args)
+    {
+        if (v_size == v_capacity) {
+            grow_emplace(false, std::forward<Args>(args)...);
+            return back();
+        }
+        T *element_ptr = v_buffer_ptr + ((v_head + v_size) & (v_capacity - 1));
+        alloc_traits::construct(v_alloc, element_ptr, std::forward<Args>(args)...);
+        ++v_size;
+        return *element_ptr;
+    }
+
+    /**
+    \brief Prepends element constructed from args.
+    \param args Arguments of the element constructor, may refer to elements of the vector.
+    \return Reference to the new element.
+    */
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    T &Ring_vector<T, Allocator>::emplace_front(Args &&... args)
+    {
+        if (v_size == v_capacity) {
+            grow_emplace(true, std::forward<Args>(args)...);
+            return front();
+        }
+        size_type new_head = (v_head - 1) & (v_capacity - 1);
+        alloc_traits::construct(v_alloc, v_buffer_ptr + new_head, std::forward<Args>(args)...);
+        v_head = new_head;
+        ++v_size;
+        return front();
+    }
+
+    /**
+    \brief Moves a full ring to a buffer of twice the capacity and adds an element
+     constructed from args. The element is constructed first, in the last slot if it
+     goes to the front, after the moved elements otherwise, so args may refer to
+     elements of the vector.
+    \param at_front Whether the element is prepended.
+    \param args Arguments of the element constructor.
+    */
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    void Ring_vector<T, Allocator>::grow_emplace(const bool at_front, Args &&... args)
+    {
+        size_type new_cap = round_capacity(v_size + 1);
+        size_type slot = at_front ? new_cap - 1 : v_size;
+        T *new_ptr = alloc_traits::allocate(v_alloc, new_cap);
+
+        try {
+            alloc_traits::construct(v_alloc, new_ptr + slot, std::forward<Args>(args)...);
+            try {
+                relocate(new_ptr);
+            } catch (...) {
+                alloc_traits::destroy(v_alloc, new_ptr + slot);
+                throw;
+            }
+        } catch (...) {
+            alloc_traits::deallocate(v_alloc, new_ptr, new_cap);
+            throw;
+        }
+        replace_buffer(new_ptr, new_cap, at_front ? slot : 0);
+        ++v_size;
+    }
+
+    ///Removes the last element.
+    template <typename T, typename Allocator>
+    void Ring_vector<T, Allocator>::pop_back()
+    {
+        if (v_size) {
+            --v_size;
+            alloc_traits::destroy(v_alloc, &(*this)[v_size]);
+        }
+    }
+
+    ///Removes the first element.
+    template <typename T, typename Allocator>
+    void Ring_vector<T, Allocator>::pop_front()
+    {
+        if (v_size) {
+            alloc_traits::destroy(v_alloc, v_buffer_ptr + v_head);
+            v_head = (v_head + 1) & (v_capacity - 1);
+            --v_size;
+        }
+    }
+
+    /**
+    \brief Makes room for at least new_cap elements, the capacity is rounded up
+     to a power of two. Throws std::length_error if new_cap is greater than maximum size.
+    */
+    template <typename T, typename Allocator>
+    void Ring_vector<T, Allocator>::reserve(const size_type new_cap)
+    {
+        if (new_cap <= v_capacity) {
+            return;
+        }
+        size_type rounded = round_capacity(new_cap);
+        T *new_ptr = alloc_traits::allocate(v_alloc, rounded);
+
+        try {
+            relocate(new_ptr);
+        } catch (...) {
+            alloc_traits::deallocate(v_alloc, new_ptr, rounded);
+            throw;
+        }
+        replace_buffer(new_ptr, rounded, 0);
+    }
+
+    ///Swaps the contents of two vectors, elements are not moved.
+    template <typename T, typename Allocator>
+    void Ring_vector<T, Allocator>::swap(Ring_vector &other) noexcept
+    {
+        std::swap(v_buffer_ptr, other.v_buffer_ptr);
+        std::swap(v_capacity, other.v_capacity);
+        std::swap(v_head, other.v_head);
+        std::swap(v_size, other.v_size);
+        std::swap(v_alloc, other.v_alloc);
+    }
+
+    ///Removes all elements, keeps the buffer.
+    template <typename T, typename Allocator>
+    void Ring_vector<T, Allocator>::clear()
+    {
+        size_type run = first_run();
+
+        tasks::destroy(v_buffer_ptr + v_head, v_buffer_ptr + v_head + run);
+        tasks::destroy(v_buffer_ptr, v_buffer_ptr + (v_size - run));
+        v_head = 0;
+        v_size = 0;
+    }
+
+    /**
+    \brief Copies the elements in order into a contiguous vector, at most two block copies.
+    \return Vector of the elements.
+    */
+    template <typename T, typename Allocator>
+    Vector<T, Allocator> Ring_vector<T, Allocator>::linearize() const &
+    {
+        size_type run = first_run();
+        Vector<T, Allocator> vec(v_alloc);
+
+        vec.reserve(v_size);
+        vec.append(v_buffer_ptr + v_head, v_buffer_ptr + v_head + run);
+        vec.append(v_buffer_ptr, v_buffer_ptr + (v_size - run));
+        return vec;
+    }
+
+    /**
+    \brief Moves the elements in order into a contiguous vector, leaving this one empty.
+    \return Vector of the elements.
+    */
+    template <typename T, typename Allocator>
+    Vector<T, Allocator> Ring_vector<T, Allocator>::linearize() &&
+    {
+        size_type run = first_run();
+        Vector<T, Allocator> vec(v_alloc);
+
+        vec.reserve(v_size);
+        vec.append(std::make_move_iterator(v_buffer_ptr + v_head), std::make_move_iterator(v_buffer_ptr + v_head + run));
+        vec.append(std::make_move_iterator(v_buffer_ptr), std::make_move_iterator(v_buffer_ptr + (v_size - run)));
+        clear();
+        return vec;
+    }
+
+    /**
+    \brief Returns the smallest power of two capacity holding count elements.
+     Throws std::length_error if count is greater than maximum size.
+    */
+    template <typename T, typename Allocator>
+    typename Ring_vector<T, Allocator>::size_type Ring_vector<T, Allocator>::round_capacity(const size_type count) const
+    {
+        if (count > max_size()) {
+            throw std::length_error("Capacity cannot be greater than maximum size.");
+        }
+        size_type new_cap = min_capacity;
+        while (new_cap < count) {
+            new_cap *= 2;
+        }
+        return new_cap;
+    }
+
+    /**
+    \brief Moves the elements, or copies them if moving may throw, to the first slots of new_ptr.
+     The elements of this vector are left in place.
+    */
+    template <typename T, typename Allocator>
+    void Ring_vector<T, Allocator>::relocate(T *new_ptr)
+    {
+        size_type run = first_run();
+
+        tasks::uninitialized_move_if_noexcept(new_ptr, v_buffer_ptr + v_head, new_ptr + run);
+        try {
+            tasks::uninitialized_move_if_noexcept(new_ptr + run, v_buffer_ptr, new_ptr + v_size);
+        } catch (...) {
+            tasks::destroy(new_ptr, new_ptr + run);
+            throw;
+        }
+    }
+
+    /**
+    \brief Destroys the elements in the old buffer, frees it and switches to new_ptr,
+     where relocate placed the elements.
+    */
+    template <typename T, typename Allocator>
+    void Ring_vector<T, Allocator>::replace_buffer(T *new_ptr, const size_type new_cap, const size_type new_head)
+    {
+        size_type count = v_size;
+
+        clear();
+        if (v_buffer_ptr) {
+            alloc_traits::deallocate(v_alloc, v_buffer_ptr, v_capacity);
+        }
+        v_buffer_ptr = new_ptr;
+        v_capacity = new_cap;
+        v_head = new_head;
+        v_size = count;
+    }
+}
+
+#endif
@@ -0,0 +1,453 @@
+/**
+\file
+\brief File contains definition of template Segmented_vector class.
+*/
+
+#ifndef _SEGMENTED_VECTOR_HPP_
+#define _SEGMENTED_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "smart_array.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector storing elements in blocks of equal size listed in a block index.
+     Element i lives in block i >> block_shift at position i & block_mask.
+     Growing allocates new blocks and only the index of block pointers is reallocated,
+     so existing elements never move: push_back, emplace_back, reserve and growing
+     resize keep references to elements valid. Iterators are Indexed_iterator, holding the vector and an index,
+     they stay valid while the index is in range. Insert and erase shift the elements
+     after the position like Vector does. A block holds Block_bytes bytes, at least one element.
+    */
+    template <typename T, typename Allocator = std::allocator<T>, size_t Block_bytes = 4096>
+    class Segmented_vector
+    {
+        typedef std::allocator_traits<Allocator> alloc_traits;
+
+        ///Returns floor of log2 of value.
+        static constexpr size_t log2(size_t value) { return value > 1 ? 1 + log2(value / 2) : 0; }
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef Allocator allocator_type;
+
+        ///Binary logarithm of the number of elements of a block.
+        static const size_type block_shift = log2(Block_bytes / sizeof(T));
+        ///Number of elements of a block.
+        static const size_type block_size = size_type(1) << block_shift;
+        ///Mask of the position of an element in its block.
+        static const size_type block_mask = block_size - 1;
+
+        typedef Indexed_iterator<Segmented_vector, T &> iterator;
+        typedef Indexed_iterator<const Segmented_vector, const T &> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        ///Default constructor.
+        Segmented_vector() : v_size(0), v_alloc() {}
+        ///Constructor of an empty vector using given allocator.
+        explicit Segmented_vector(const Allocator &alloc) : v_size(0), v_alloc(alloc) {}
+        Segmented_vector(const size_type, const T & = T(), const Allocator & = Allocator());
+        Segmented_vector(const Segmented_vector &vec);
+        Segmented_vector(Segmented_vector &&vec) noexcept;
+        template <typename In, typename = typename std::iterator_traits<In>::iterator_category>
+        Segmented_vector(In, In, const Allocator & = Allocator());
+        ~Segmented_vector(void);
+
+        const Segmented_vector &operator=(const Segmented_vector &);
+        const Segmented_vector &operator=(Segmented_vector &&) noexcept;
+        bool operator==(const Segmented_vector &) const;
+        bool operator!=(const Segmented_vector &vec) const { return !(*this == vec); }
+        T &operator[](const size_type i) { return v_blocks[i >> block_shift][i & block_mask]; }
+        const T &operator[](const size_type i) const { return v_blocks[i >> block_shift][i & block_mask]; }
+        T &at(size_type);
+        const T &at(size_type) const;
+        void push_back(const T &value) { emplace_back(value); }
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        template <typename... Args>
+        T &emplace_back(Args &&...);
+        void pop_back();
+        iterator insert(const_iterator, const T &);
+        iterator insert(const_iterator, T &&);
+        iterator erase(const_iterator);
+        iterator erase(const_iterator, const_iterator);
+        T &front() { return (*this)[0]; }
+        T &back() { return (*this)[v_size - 1]; }
+        const T &front() const { return (*this)[0]; }
+        const T &back() const { return (*this)[v_size - 1]; }
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, v_size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, v_size); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        bool empty() const { return 0 == v_size; }
+        ///Returns number of elements the allocated blocks hold.
+        size_type capacity() const { return v_blocks.size() * block_size; }
+        size_type size() const { return v_size; }
+        ///Returns number of allocated blocks.
+        size_type block_count() const { return v_blocks.size(); }
+        void reserve(const size_type);
+        void resize(const size_type, const T & = T());
+        void shrink_to_fit();
+        void swap(Segmented_vector &) noexcept;
+        void clear();
+        size_type max_size() const { return alloc_traits::max_size(v_alloc); }
+        allocator_type get_allocator() const { return v_alloc; }
+
+    private:
+        ///Pointers to the blocks, the first size / block_size are full.
+        Vector<T *> v_blocks;
+        ///Number of elements in vector.
+        size_type v_size;
+        ///Allocator providing the blocks.
+        Allocator v_alloc;
+
+        void add_block();
+        void free_blocks(const size_type keep);
+    };
+
+    template <typename T, typename Allocator, size_t Block_bytes>
+    const typename Segmented_vector<T, Allocator, Block_bytes>::size_type
+    Segmented_vector<T, Allocator, Block_bytes>::block_shift;
+
+    template <typename T, typename Allocator, size_t Block_bytes>
+    const typename Segmented_vector<T, Allocator, Block_bytes>::size_type
+    Segmented_vector<T, Allocator, Block_bytes>::block_size;
+
+    template <typename T, typename Allocator, size_t Block_bytes>
+    const typename Segmented_vector<T, Allocator, Block_bytes>::size_type
+    Segmented_vector<T, Allocator, Block_bytes>::block_mask;
+
+    /**
+    \brief Constructor of vector with size copies of value.
+    \param size Number of elements.
+    \param value Value of elements.
+    \param alloc Allocator of the vector.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    Segmented_vector<T, Allocator, Block_bytes>::Segmented_vector(const size_type size, const T &value,
+                                                                   const Allocator &alloc)
+        : v_size(0), v_alloc(alloc)
+    {
+        try {
+            resize(size, value);
+        } catch (...) {
+            clear();
+            free_blocks(0);
+            throw;
+        }
+    }
+
+    ///Copy constructor.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    Segmented_vector<T, Allocator, Block_bytes>::Segmented_vector(const Segmented_vector &vec)
+        : v_size(0), v_alloc(alloc_traits::select_on_container_copy_construction(vec.v_alloc))
+    {
+        try {
+            reserve(vec.v_size);
+            for (size_type i = 0; i < vec.v_size; ++i) {
+                emplace_back(vec[i]);
+            }
+        } catch (...) {
+            clear();
+            free_blocks(0);
+            throw;
+        }
+    }
+
+    ///Move constructor, takes the blocks of vec.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    Segmented_vector<T, Allocator, Block_bytes>::Segmented_vector(Segmented_vector &&vec) noexcept
+        : v_blocks(std::move(vec.v_blocks)), v_size(vec.v_size), v_alloc(std::move(vec.v_alloc))
+    {
+        vec.v_size = 0;
+    }
+
+    /**
+    \brief Constructor of vector with the contents of the range [first, last).
+    \param first, last Input iterators.
+    \param alloc Allocator of the vector.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    template <typename In, typename>
+    Segmented_vector<T, Allocator, Block_bytes>::Segmented_vector(In first, In last, const Allocator &alloc)
+        : v_size(0), v_alloc(alloc)
+    {
+        try {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        } catch (...) {
+            clear();
+            free_blocks(0);
+            throw;
+        }
+    }
+
+    ///Destructor.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    Segmented_vector<T, Allocator, Block_bytes>::~Segmented_vector(void)
+    {
+        clear();
+        free_blocks(0);
+    }
+
+    ///Copy assignment, gives strong guarantee by copying first.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    const Segmented_vector<T, Allocator, Block_bytes> &
+    Segmented_vector<T, Allocator, Block_bytes>::operator=(const Segmented_vector &vec)
+    {
+        if (this != &vec) {
+            Segmented_vector temp(vec);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ///Move assignment, frees own elements and takes the blocks of vec.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    const Segmented_vector<T, Allocator, Block_bytes> &
+    Segmented_vector<T, Allocator, Block_bytes>::operator=(Segmented_vector &&vec) noexcept
+    {
+        if (this != &vec) {
+            Segmented_vector temp(std::move(vec));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    /**
+    \brief Compares sizes and elements of two vectors.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    bool Segmented_vector<T, Allocator, Block_bytes>::operator==(const Segmented_vector &vec) const
+    {
+        if (v_size != vec.v_size) {
+            return false;
+        }
+        for (size_type b = 0; b * block_size < v_size; ++b) {
+            size_type count = std::min(block_size, v_size - b * block_size);
+            if (!std::equal(v_blocks[b], v_blocks[b] + count, vec.v_blocks[b])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+    \brief Returns element i. Throws std::out_of_range if i is not less than size.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    T &Segmented_vector<T, Allocator, Block_bytes>::at(size_type i)
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Returns element i. Throws std::out_of_range if i is not less than size.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    const T &Segmented_vector<T, Allocator, Block_bytes>::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Appends element constructed from args, adding a block if the last one is full.
+     Elements already stored are not moved.
+    \param args Arguments of the element constructor.
+    \return Reference to the new element.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    template <typename... Args>
+    T &Segmented_vector<T, Allocator, Block_bytes>::emplace_back(Args &&... args)
+    {
+        if (v_size == capacity()) {
+            add_block();
+        }
+        T *element_ptr = v_blocks[v_size >> block_shift] + (v_size & block_mask);
+        alloc_traits::construct(v_alloc, element_ptr, std::forward<Args>(args)...);
+        ++v_size;
+        return *element_ptr;
+    }
+
+    ///Removes the last element, keeps its block.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::pop_back()
+    {
+        if (v_size) {
+            --v_size;
+            alloc_traits::destroy(v_alloc, &(*this)[v_size]);
+        }
+    }
+
+    /**
+    \brief Inserts value before pos, elements from pos on are shifted by one.
+    \return Iterator to the inserted element.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    typename Segmented_vector<T, Allocator, Block_bytes>::iterator
+    Segmented_vector<T, Allocator, Block_bytes>::insert(const_iterator pos, const T &value)
+    {
+        size_type index = pos.index();
+
+        emplace_back(value);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    /**
+    \brief Inserts value before pos, elements from pos on are shifted by one.
+    \return Iterator to the inserted element.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    typename Segmented_vector<T, Allocator, Block_bytes>::iterator
+    Segmented_vector<T, Allocator, Block_bytes>::insert(const_iterator pos, T &&value)
+    {
+        size_type index = pos.index();
+
+        emplace_back(std::move(value));
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    /**
+    \brief Removes element at pos, following elements are shifted by one.
+    \return Iterator to the element following the removed one.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    typename Segmented_vector<T, Allocator, Block_bytes>::iterator
+    Segmented_vector<T, Allocator, Block_bytes>::erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    /**
+    \brief Removes elements of the range [first, last). Does nothing if the range is out of the vector.
+    \return Iterator to the element following the removed ones.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    typename Segmented_vector<T, Allocator, Block_bytes>::iterator
+    Segmented_vector<T, Allocator, Block_bytes>::erase(const_iterator first, const_iterator last)
+    {
+        if (last < first || last.index() > v_size) {
+            return end();
+        }
+        std::move(begin() + last.index(), end(), begin() + first.index());
+        for (size_type count = last - first; count; --count) {
+            pop_back();
+        }
+        return begin() + first.index();
+    }
+
+    /**
+    \brief Allocates blocks until new_cap elements fit. Throws std::length_error
+     if new_cap is greater than maximum size.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::reserve(const size_type new_cap)
+    {
+        if (new_cap > max_size()) {
+            throw std::length_error("Capacity cannot be greater than maximum size.");
+        }
+        v_blocks.reserve((new_cap + block_mask) >> block_shift);
+        while (capacity() < new_cap) {
+            add_block();
+        }
+    }
+
+    /**
+    \brief Changes the number of stored elements. Works like std::vector::resize(),
+     but growing does not move stored elements.
+    \param new_size Number of elements.
+    \param value Value of appended elements if new_size is greater than the size.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::resize(const size_type new_size, const T &value)
+    {
+        if (new_size > v_size) {
+            reserve(new_size);
+        }
+        while (v_size > new_size) {
+            pop_back();
+        }
+        while (v_size < new_size) {
+            emplace_back(value);
+        }
+    }
+
+    ///Frees blocks holding no elements and shrinks the block index.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::shrink_to_fit()
+    {
+        free_blocks((v_size + block_mask) >> block_shift);
+        Vector<T *> blocks(v_blocks.begin(), v_blocks.end());
+        v_blocks.swap(blocks);
+    }
+
+    ///Swaps the contents of two vectors, elements are not moved.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::swap(Segmented_vector &other) noexcept
+    {
+        v_blocks.swap(other.v_blocks);
+        std::swap(v_size, other.v_size);
+        std::swap(v_alloc, other.v_alloc);
+    }
+
+    ///Removes all elements, keeps the blocks.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::clear()
+    {
+        for (size_type b = 0; b * block_size < v_size; ++b) {
+            size_type count = std::min(block_size, v_size - b * block_size);
+            for (size_type j = 0; j < count; ++j) {
+                alloc_traits::destroy(v_alloc, v_blocks[b] + j);
+            }
+        }
+        v_size = 0;
+    }
+
+    ///Allocates a block and appends it to the index.
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::add_block()
+    {
+        T *block_ptr = alloc_traits::allocate(v_alloc, block_size);
+
+        try {
+            v_blocks.push_back(block_ptr);
+        } catch (...) {
+            alloc_traits::deallocate(v_alloc, block_ptr, block_size);
+            throw;
+        }
+    }
+
+    /**
+    \brief Frees the blocks past the first keep, which must hold no elements.
+    */
+    template <typename T, typename Allocator, size_t Block_bytes>
+    void Segmented_vector<T, Allocator, Block_bytes>::free_blocks(const size_type keep)
+    {
+        while (v_blocks.size() > keep) {
+            alloc_traits::deallocate(v_alloc, v_blocks.back(), block_size);
+            v_blocks.pop_back();
+        }
+    }
+}
+
+#endif
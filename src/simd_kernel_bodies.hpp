@@ -0,0 +1,163 @@
+/**
+\file
+\brief Generic kernels of simd_kernels.hpp written against a lane traits class.
+ Deliberately without include guard: simd_kernels.hpp includes this file once per
+ instruction set inside its namespace, so every copy is compiled for that target.
+
+ Traits provide value_type, sum_type, reg, acc, lanes and the static functions
+ load, set1, eq_mask (one bit per lane), min, max, store, acc_zero, accumulate and reduce.
+*/
+
+    /**
+    \brief Compares two arrays for equality.
+    \param left_ptr, right_ptr Arrays of n elements.
+    \param n Number of elements.
+    \return true if all elements are equal.
+    */
+    template <typename Traits>
+    bool equal(const typename Traits::value_type *left_ptr,
+               const typename Traits::value_type *right_ptr, size_t n)
+    {
+        const unsigned full = ~0u >> (32 - Traits::lanes);
+        size_t i = 0;
+
+        for (; i + Traits::lanes <= n; i += Traits::lanes) {
+            if (Traits::eq_mask(Traits::load(left_ptr + i), Traits::load(right_ptr + i)) != full) {
+                return false;
+            }
+        }
+        for (; i < n; ++i) {
+            if (left_ptr[i] != right_ptr[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+    \brief Finds the first element equal to value.
+    \return Index of the element, n if not found.
+    */
+    template <typename Traits>
+    size_t find(const typename Traits::value_type *ptr, size_t n, typename Traits::value_type value)
+    {
+        const typename Traits::reg key = Traits::set1(value);
+        size_t i = 0;
+
+        for (; i + Traits::lanes <= n; i += Traits::lanes) {
+            unsigned mask = Traits::eq_mask(Traits::load(ptr + i), key);
+
+            if (mask) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        for (; i < n; ++i) {
+            if (ptr[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    ///Counts set bits of a lane mask without relying on the popcnt instruction.
+    inline unsigned bit_count(unsigned mask)
+    {
+        mask = mask - ((mask >> 1) & 0x55555555u);
+        mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+        return (((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+    }
+
+    /**
+    \brief Counts elements equal to value.
+    */
+    template <typename Traits>
+    size_t count(const typename Traits::value_type *ptr, size_t n, typename Traits::value_type value)
+    {
+        const typename Traits::reg key = Traits::set1(value);
+        size_t total = 0;
+        size_t i = 0;
+
+        for (; i + Traits::lanes <= n; i += Traits::lanes) {
+            total += bit_count(Traits::eq_mask(Traits::load(ptr + i), key));
+        }
+        for (; i < n; ++i) {
+            total += ptr[i] == value;
+        }
+        return total;
+    }
+
+    /**
+    \brief Returns the smallest element of nonempty array.
+    */
+    template <typename Traits>
+    typename Traits::value_type min_value(const typename Traits::value_type *ptr, size_t n)
+    {
+        typedef typename Traits::value_type T;
+        T result = ptr[0];
+        size_t i = 0;
+
+        if (n >= Traits::lanes) {
+            typename Traits::reg best = Traits::load(ptr);
+            T parts[Traits::lanes];
+
+            for (i = Traits::lanes; i + Traits::lanes <= n; i += Traits::lanes) {
+                best = Traits::min(best, Traits::load(ptr + i));
+            }
+            Traits::store(parts, best);
+            for (size_t l = 0; l < Traits::lanes; ++l) {
+                result = parts[l] < result ? parts[l] : result;
+            }
+        }
+        for (; i < n; ++i) {
+            result = ptr[i] < result ? ptr[i] : result;
+        }
+        return result;
+    }
+
+    /**
+    \brief Returns the largest element of nonempty array.
+    */
+    template <typename Traits>
+    typename Traits::value_type max_value(const typename Traits::value_type *ptr, size_t n)
+    {
+        typedef typename Traits::value_type T;
+        T result = ptr[0];
+        size_t i = 0;
+
+        if (n >= Traits::lanes) {
+            typename Traits::reg best = Traits::load(ptr);
+            T parts[Traits::lanes];
+
+            for (i = Traits::lanes; i + Traits::lanes <= n; i += Traits::lanes) {
+                best = Traits::max(best, Traits::load(ptr + i));
+            }
+            Traits::store(parts, best);
+            for (size_t l = 0; l < Traits::lanes; ++l) {
+                result = result < parts[l] ? parts[l] : result;
+            }
+        }
+        for (; i < n; ++i) {
+            result = result < ptr[i] ? ptr[i] : result;
+        }
+        return result;
+    }
+
+    /**
+    \brief Sums the elements in Traits::sum_type.
+    */
+    template <typename Traits>
+    typename Traits::sum_type sum(const typename Traits::value_type *ptr, size_t n)
+    {
+        typename Traits::acc total = Traits::acc_zero();
+        size_t i = 0;
+
+        for (; i + Traits::lanes <= n; i += Traits::lanes) {
+            total = Traits::accumulate(total, Traits::load(ptr + i));
+        }
+        typename Traits::sum_type result = Traits::reduce(total);
+
+        for (; i < n; ++i) {
+            result += ptr[i];
+        }
+        return result;
+    }
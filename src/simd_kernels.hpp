@@ -0,0 +1,863 @@
+/**
+\file
+\brief File contains SIMD kernels for arrays of int, float, double and uint8_t:
+ equality, find, count, min, max and sum, kernels for arrays of 64-bit words:
+ popcount and bitwise and, or, xor and not, and unpacking of bit-packed blocks.
+ Kernels exist in scalar, SSE2 and AVX2 versions, the best one supported by the CPU
+ is chosen at runtime.
+ Other element types use generic scalar templates with the same interface.
+ Results of min_value and max_value on floating point arrays holding NaN are unspecified,
+ floating point sums may differ from sequential summation in rounding.
+*/
+
+#ifndef _SIMD_KERNELS_HPP_
+#define _SIMD_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SMART_ARRAY_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace tasks {
+namespace simd {
+
+    ///Instruction sets in ascending order.
+    enum Isa { scalar_isa, sse2_isa, avx2_isa };
+
+    ///Type of the sum of elements of type T.
+    template <typename T> struct Sum { typedef T type; };
+    template <> struct Sum<int> { typedef long long type; };
+    template <> struct Sum<uint8_t> { typedef unsigned long long type; };
+
+    /**
+    \brief Lane traits treating one element as one lane, used by the scalar kernels.
+    */
+    template <typename T>
+    struct Scalar_traits
+    {
+        typedef T value_type;
+        typedef typename Sum<T>::type sum_type;
+        typedef T reg;
+        typedef sum_type acc;
+        static const size_t lanes = 1;
+
+        static reg load(const T *ptr) { return *ptr; }
+        static reg set1(T value) { return value; }
+        static unsigned eq_mask(reg a, reg b) { return a == b; }
+        static reg min(reg a, reg b) { return b < a ? b : a; }
+        static reg max(reg a, reg b) { return a < b ? b : a; }
+        static void store(T *ptr, reg a) { *ptr = a; }
+        static acc acc_zero() { return acc(); }
+        static acc accumulate(acc total, reg a) { return total + a; }
+        static sum_type reduce(acc total) { return total; }
+    };
+
+    namespace scalar {
+#include "simd_kernel_bodies.hpp"
+    }
+
+#ifdef SMART_ARRAY_X86_SIMD
+    namespace sse2 {
+
+        ///SSE2 lanes of int.
+        struct Int_traits
+        {
+            typedef int value_type;
+            typedef long long sum_type;
+            typedef __m128i reg;
+            typedef __m128i acc;
+            static const size_t lanes = 4;
+
+            static reg load(const int *ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)); }
+            static reg set1(int value) { return _mm_set1_epi32(value); }
+            static unsigned eq_mask(reg a, reg b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+            static reg min(reg a, reg b)
+            {
+                __m128i greater = _mm_cmpgt_epi32(a, b);
+                return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+            }
+            static reg max(reg a, reg b)
+            {
+                __m128i greater = _mm_cmpgt_epi32(a, b);
+                return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+            }
+            static void store(int *ptr, reg a) { _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), a); }
+            static acc acc_zero() { return _mm_setzero_si128(); }
+            ///Sign extends the lanes to 64 bits and adds them to two 64-bit sums.
+            static acc accumulate(acc total, reg a)
+            {
+                __m128i sign = _mm_srai_epi32(a, 31);
+                total = _mm_add_epi64(total, _mm_unpacklo_epi32(a, sign));
+                return _mm_add_epi64(total, _mm_unpackhi_epi32(a, sign));
+            }
+            static sum_type reduce(acc total)
+            {
+                long long sums[2];
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(sums), total);
+                return sums[0] + sums[1];
+            }
+        };
+
+        ///SSE2 lanes of uint8_t.
+        struct Byte_traits
+        {
+            typedef uint8_t value_type;
+            typedef unsigned long long sum_type;
+            typedef __m128i reg;
+            typedef __m128i acc;
+            static const size_t lanes = 16;
+
+            static reg load(const uint8_t *ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)); }
+            static reg set1(uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+            static unsigned eq_mask(reg a, reg b) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+            static reg min(reg a, reg b) { return _mm_min_epu8(a, b); }
+            static reg max(reg a, reg b) { return _mm_max_epu8(a, b); }
+            static void store(uint8_t *ptr, reg a) { _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), a); }
+            static acc acc_zero() { return _mm_setzero_si128(); }
+            ///Adds byte sums of both halves to two 64-bit sums.
+            static acc accumulate(acc total, reg a) { return _mm_add_epi64(total, _mm_sad_epu8(a, _mm_setzero_si128())); }
+            static sum_type reduce(acc total)
+            {
+                unsigned long long sums[2];
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(sums), total);
+                return sums[0] + sums[1];
+            }
+        };
+
+        ///SSE2 lanes of float.
+        struct Float_traits
+        {
+            typedef float value_type;
+            typedef float sum_type;
+            typedef __m128 reg;
+            typedef __m128 acc;
+            static const size_t lanes = 4;
+
+            static reg load(const float *ptr) { return _mm_loadu_ps(ptr); }
+            static reg set1(float value) { return _mm_set1_ps(value); }
+            static unsigned eq_mask(reg a, reg b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+            static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+            static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+            static void store(float *ptr, reg a) { _mm_storeu_ps(ptr, a); }
+            static acc acc_zero() { return _mm_setzero_ps(); }
+            static acc accumulate(acc total, reg a) { return _mm_add_ps(total, a); }
+            static sum_type reduce(acc total)
+            {
+                float sums[4];
+                _mm_storeu_ps(sums, total);
+                return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+            }
+        };
+
+        ///SSE2 lanes of double.
+        struct Double_traits
+        {
+            typedef double value_type;
+            typedef double sum_type;
+            typedef __m128d reg;
+            typedef __m128d acc;
+            static const size_t lanes = 2;
+
+            static reg load(const double *ptr) { return _mm_loadu_pd(ptr); }
+            static reg set1(double value) { return _mm_set1_pd(value); }
+            static unsigned eq_mask(reg a, reg b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+            static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+            static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+            static void store(double *ptr, reg a) { _mm_storeu_pd(ptr, a); }
+            static acc acc_zero() { return _mm_setzero_pd(); }
+            static acc accumulate(acc total, reg a) { return _mm_add_pd(total, a); }
+            static sum_type reduce(acc total)
+            {
+                double sums[2];
+                _mm_storeu_pd(sums, total);
+                return sums[0] + sums[1];
+            }
+        };
+
+        ///Maps element type to its traits.
+        template <typename T> struct Traits;
+        template <> struct Traits<int> { typedef Int_traits type; };
+        template <> struct Traits<uint8_t> { typedef Byte_traits type; };
+        template <> struct Traits<float> { typedef Float_traits type; };
+        template <> struct Traits<double> { typedef Double_traits type; };
+
+#include "simd_kernel_bodies.hpp"
+    }
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+    namespace avx2 {
+
+        ///AVX2 lanes of int.
+        struct Int_traits
+        {
+            typedef int value_type;
+            typedef long long sum_type;
+            typedef __m256i reg;
+            typedef __m256i acc;
+            static const size_t lanes = 8;
+
+            static reg load(const int *ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+            static reg set1(int value) { return _mm256_set1_epi32(value); }
+            static unsigned eq_mask(reg a, reg b)
+            {
+                return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+            }
+            static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+            static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+            static void store(int *ptr, reg a) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), a); }
+            static acc acc_zero() { return _mm256_setzero_si256(); }
+            ///Sign extends both halves to 64 bits and adds them to four 64-bit sums.
+            static acc accumulate(acc total, reg a)
+            {
+                total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)));
+                return _mm256_add_epi64(total, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+            }
+            static sum_type reduce(acc total)
+            {
+                long long sums[4];
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), total);
+                return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+            }
+        };
+
+        ///AVX2 lanes of uint8_t.
+        struct Byte_traits
+        {
+            typedef uint8_t value_type;
+            typedef unsigned long long sum_type;
+            typedef __m256i reg;
+            typedef __m256i acc;
+            static const size_t lanes = 32;
+
+            static reg load(const uint8_t *ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+            static reg set1(uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+            static unsigned eq_mask(reg a, reg b) { return _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+            static reg min(reg a, reg b) { return _mm256_min_epu8(a, b); }
+            static reg max(reg a, reg b) { return _mm256_max_epu8(a, b); }
+            static void store(uint8_t *ptr, reg a) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), a); }
+            static acc acc_zero() { return _mm256_setzero_si256(); }
+            ///Adds byte sums of the four quarters to four 64-bit sums.
+            static acc accumulate(acc total, reg a)
+            {
+                return _mm256_add_epi64(total, _mm256_sad_epu8(a, _mm256_setzero_si256()));
+            }
+            static sum_type reduce(acc total)
+            {
+                unsigned long long sums[4];
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), total);
+                return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+            }
+        };
+
+        ///AVX2 lanes of float.
+        struct Float_traits
+        {
+            typedef float value_type;
+            typedef float sum_type;
+            typedef __m256 reg;
+            typedef __m256 acc;
+            static const size_t lanes = 8;
+
+            static reg load(const float *ptr) { return _mm256_loadu_ps(ptr); }
+            static reg set1(float value) { return _mm256_set1_ps(value); }
+            static unsigned eq_mask(reg a, reg b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+            static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+            static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+            static void store(float *ptr, reg a) { _mm256_storeu_ps(ptr, a); }
+            static acc acc_zero() { return _mm256_setzero_ps(); }
+            static acc accumulate(acc total, reg a) { return _mm256_add_ps(total, a); }
+            static sum_type reduce(acc total)
+            {
+                float sums[8];
+                _mm256_storeu_ps(sums, total);
+                return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+            }
+        };
+
+        ///AVX2 lanes of double.
+        struct Double_traits
+        {
+            typedef double value_type;
+            typedef double sum_type;
+            typedef __m256d reg;
+            typedef __m256d acc;
+            static const size_t lanes = 4;
+
+            static reg load(const double *ptr) { return _mm256_loadu_pd(ptr); }
+            static reg set1(double value) { return _mm256_set1_pd(value); }
+            static unsigned eq_mask(reg a, reg b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+            static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+            static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+            static void store(double *ptr, reg a) { _mm256_storeu_pd(ptr, a); }
+            static acc acc_zero() { return _mm256_setzero_pd(); }
+            static acc accumulate(acc total, reg a) { return _mm256_add_pd(total, a); }
+            static sum_type reduce(acc total)
+            {
+                double sums[4];
+                _mm256_storeu_pd(sums, total);
+                return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+            }
+        };
+
+        ///Maps element type to its traits.
+        template <typename T> struct Traits;
+        template <> struct Traits<int> { typedef Int_traits type; };
+        template <> struct Traits<uint8_t> { typedef Byte_traits type; };
+        template <> struct Traits<float> { typedef Float_traits type; };
+        template <> struct Traits<double> { typedef Double_traits type; };
+
+#include "simd_kernel_bodies.hpp"
+    }
+#pragma GCC pop_options
+#endif
+
+    ///Returns the best instruction set supported by the CPU.
+    inline Isa detected_isa()
+    {
+#ifdef SMART_ARRAY_X86_SIMD
+        return __builtin_cpu_supports("avx2") ? avx2_isa : sse2_isa;
+#else
+        return scalar_isa;
+#endif
+    }
+
+    ///Instruction set used by the kernels.
+    inline Isa &active_isa()
+    {
+        static Isa isa = detected_isa();
+        return isa;
+    }
+
+    ///Returns the instruction set used by the kernels.
+    inline Isa isa() { return active_isa(); }
+
+    /**
+    \brief Selects the instruction set used by the kernels, for tests and benchmarks.
+    \param wanted Wanted instruction set, lowered to the best supported one.
+    \return Selected instruction set.
+    */
+    inline Isa set_isa(Isa wanted)
+    {
+        Isa best = detected_isa();
+        active_isa() = wanted < best ? wanted : best;
+        return active_isa();
+    }
+
+    /**
+    \brief Kernels of one instruction set for element type T.
+    */
+    template <typename T>
+    struct Kernel_table
+    {
+        bool (*equal)(const T *, const T *, size_t);
+        size_t (*find)(const T *, size_t, T);
+        size_t (*count)(const T *, size_t, T);
+        T (*min_value)(const T *, size_t);
+        T (*max_value)(const T *, size_t);
+        typename Sum<T>::type (*sum)(const T *, size_t);
+    };
+
+    ///Returns the kernels of the active instruction set for T.
+    template <typename T>
+    const Kernel_table<T> &kernels()
+    {
+        typedef Scalar_traits<T> S;
+        static const Kernel_table<T> tables[] = {
+            { &scalar::equal<S>, &scalar::find<S>, &scalar::count<S>,
+              &scalar::min_value<S>, &scalar::max_value<S>, &scalar::sum<S> },
+#ifdef SMART_ARRAY_X86_SIMD
+            { &sse2::equal<typename sse2::Traits<T>::type>, &sse2::find<typename sse2::Traits<T>::type>,
+              &sse2::count<typename sse2::Traits<T>::type>, &sse2::min_value<typename sse2::Traits<T>::type>,
+              &sse2::max_value<typename sse2::Traits<T>::type>, &sse2::sum<typename sse2::Traits<T>::type> },
+            { &avx2::equal<typename avx2::Traits<T>::type>, &avx2::find<typename avx2::Traits<T>::type>,
+              &avx2::count<typename avx2::Traits<T>::type>, &avx2::min_value<typename avx2::Traits<T>::type>,
+              &avx2::max_value<typename avx2::Traits<T>::type>, &avx2::sum<typename avx2::Traits<T>::type> }
+#endif
+        };
+        return tables[isa()];
+    }
+
+    /**
+    \brief Compares two arrays element by element, generic version.
+    \param left_ptr, right_ptr Arrays of n elements, may be null if n is 0.
+    \param n Number of elements.
+    \return true if no pair of elements differs.
+    */
+    template <typename T>
+    bool equal(const T *left_ptr, const T *right_ptr, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            if (left_ptr[i] != right_ptr[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ///Returns index of the first element equal to value, n if none, generic version.
+    template <typename T>
+    size_t find(const T *ptr, size_t n, const T &value)
+    {
+        size_t i = 0;
+
+        while (i < n && !(ptr[i] == value)) {
+            ++i;
+        }
+        return i;
+    }
+
+    ///Returns number of elements equal to value, generic version.
+    template <typename T>
+    size_t count(const T *ptr, size_t n, const T &value)
+    {
+        size_t total = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            total += ptr[i] == value;
+        }
+        return total;
+    }
+
+    ///Returns the smallest element of nonempty array, generic version.
+    template <typename T>
+    T min_value(const T *ptr, size_t n)
+    {
+        return scalar::min_value<Scalar_traits<T> >(ptr, n);
+    }
+
+    ///Returns the largest element of nonempty array, generic version.
+    template <typename T>
+    T max_value(const T *ptr, size_t n)
+    {
+        return scalar::max_value<Scalar_traits<T> >(ptr, n);
+    }
+
+    ///Returns the sum of elements, generic version.
+    template <typename T>
+    typename Sum<T>::type sum(const T *ptr, size_t n)
+    {
+        return scalar::sum<Scalar_traits<T> >(ptr, n);
+    }
+
+    namespace scalar {
+
+        ///Counts set bits of a word with shifts and masks.
+        inline size_t word_bit_count(uint64_t word)
+        {
+            word = word - ((word >> 1) & 0x5555555555555555ULL);
+            word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+            return (((word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * 0x0101010101010101ULL) >> 56;
+        }
+
+        ///Returns number of set bits of n words.
+        inline size_t popcount(const uint64_t *ptr, size_t n)
+        {
+            size_t total = 0;
+
+            for (size_t i = 0; i < n; ++i) {
+                total += word_bit_count(ptr[i]);
+            }
+            return total;
+        }
+
+        ///Stores left & right into left, word by word.
+        inline void bit_and(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i) {
+                left_ptr[i] &= right_ptr[i];
+            }
+        }
+
+        ///Stores left | right into left, word by word.
+        inline void bit_or(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i) {
+                left_ptr[i] |= right_ptr[i];
+            }
+        }
+
+        ///Stores left ^ right into left, word by word.
+        inline void bit_xor(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i) {
+                left_ptr[i] ^= right_ptr[i];
+            }
+        }
+
+        ///Inverts n words.
+        inline void bit_not(uint64_t *ptr, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i) {
+                ptr[i] = ~ptr[i];
+            }
+        }
+    }
+
+#ifdef SMART_ARRAY_X86_SIMD
+    namespace sse2 {
+
+        ///Counts set bits with the popcnt instruction.
+        __attribute__((target("popcnt"))) inline size_t popcount_instruction(const uint64_t *ptr, size_t n)
+        {
+            size_t total = 0;
+
+            for (size_t i = 0; i < n; ++i) {
+                total += __builtin_popcountll(ptr[i]);
+            }
+            return total;
+        }
+
+        ///Returns number of set bits of n words, uses popcnt if the CPU has it.
+        inline size_t popcount(const uint64_t *ptr, size_t n)
+        {
+            return __builtin_cpu_supports("popcnt") ? popcount_instruction(ptr, n) : scalar::popcount(ptr, n);
+        }
+
+        ///Operations combining 128-bit blocks and, for the tail, single words.
+        struct And_op
+        {
+            static __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+            static uint64_t scalar(uint64_t a, uint64_t b) { return a & b; }
+        };
+        struct Or_op
+        {
+            static __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+            static uint64_t scalar(uint64_t a, uint64_t b) { return a | b; }
+        };
+        struct Xor_op
+        {
+            static __m128i apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+            static uint64_t scalar(uint64_t a, uint64_t b) { return a ^ b; }
+        };
+        struct Not_op
+        {
+            static __m128i apply(__m128i a, __m128i) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+            static uint64_t scalar(uint64_t a, uint64_t) { return ~a; }
+        };
+
+        ///Applies Op to pairs of blocks of left and right, stores into left.
+        template <typename Op>
+        void bitwise(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i + 2 <= n; i += 2) {
+                __m128i *target = reinterpret_cast<__m128i *>(left_ptr + i);
+                __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i *>(right_ptr + i));
+                _mm_storeu_si128(target, Op::apply(_mm_loadu_si128(target), right));
+            }
+            for (; i < n; ++i) {
+                left_ptr[i] = Op::scalar(left_ptr[i], right_ptr[i]);
+            }
+        }
+
+        inline void bit_and(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            bitwise<And_op>(left_ptr, right_ptr, n);
+        }
+
+        inline void bit_or(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            bitwise<Or_op>(left_ptr, right_ptr, n);
+        }
+
+        inline void bit_xor(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            bitwise<Xor_op>(left_ptr, right_ptr, n);
+        }
+
+        inline void bit_not(uint64_t *ptr, size_t n) { bitwise<Not_op>(ptr, ptr, n); }
+    }
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+    namespace avx2 {
+
+        /**
+        \brief Returns number of set bits of n words. Bytes are split into nibbles whose
+         bit counts are looked up with a byte shuffle and summed with sad.
+        */
+        inline size_t popcount(const uint64_t *ptr, size_t n)
+        {
+            const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low_mask = _mm256_set1_epi8(0x0F);
+            __m256i total = _mm256_setzero_si256();
+            size_t i = 0;
+
+            for (; i + 4 <= n; i += 4) {
+                __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr + i));
+                __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(words, low_mask));
+                __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(words, 4), low_mask));
+                total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+            }
+            uint64_t sums[4];
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), total);
+            return sums[0] + sums[1] + sums[2] + sums[3] + scalar::popcount(ptr + i, n - i);
+        }
+
+        ///Operations combining 256-bit blocks and, for the tail, single words.
+        struct And_op
+        {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+            static uint64_t scalar(uint64_t a, uint64_t b) { return a & b; }
+        };
+        struct Or_op
+        {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+            static uint64_t scalar(uint64_t a, uint64_t b) { return a | b; }
+        };
+        struct Xor_op
+        {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+            static uint64_t scalar(uint64_t a, uint64_t b) { return a ^ b; }
+        };
+        struct Not_op
+        {
+            static __m256i apply(__m256i a, __m256i) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+            static uint64_t scalar(uint64_t a, uint64_t) { return ~a; }
+        };
+
+        ///Applies Op to pairs of blocks of left and right, stores into left.
+        template <typename Op>
+        void bitwise(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i + 4 <= n; i += 4) {
+                __m256i *target = reinterpret_cast<__m256i *>(left_ptr + i);
+                __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(right_ptr + i));
+                _mm256_storeu_si256(target, Op::apply(_mm256_loadu_si256(target), right));
+            }
+            for (; i < n; ++i) {
+                left_ptr[i] = Op::scalar(left_ptr[i], right_ptr[i]);
+            }
+        }
+
+        inline void bit_and(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            bitwise<And_op>(left_ptr, right_ptr, n);
+        }
+
+        inline void bit_or(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            bitwise<Or_op>(left_ptr, right_ptr, n);
+        }
+
+        inline void bit_xor(uint64_t *left_ptr, const uint64_t *right_ptr, size_t n)
+        {
+            bitwise<Xor_op>(left_ptr, right_ptr, n);
+        }
+
+        inline void bit_not(uint64_t *ptr, size_t n) { bitwise<Not_op>(ptr, ptr, n); }
+    }
+#pragma GCC pop_options
+#endif
+
+    /**
+    \brief Word kernels of one instruction set.
+    */
+    struct Word_kernel_table
+    {
+        size_t (*popcount)(const uint64_t *, size_t);
+        void (*bit_and)(uint64_t *, const uint64_t *, size_t);
+        void (*bit_or)(uint64_t *, const uint64_t *, size_t);
+        void (*bit_xor)(uint64_t *, const uint64_t *, size_t);
+        void (*bit_not)(uint64_t *, size_t);
+    };
+
+    ///Returns the word kernels of the active instruction set.
+    inline const Word_kernel_table &word_kernels()
+    {
+        static const Word_kernel_table tables[] = {
+            { &scalar::popcount, &scalar::bit_and, &scalar::bit_or, &scalar::bit_xor, &scalar::bit_not },
+#ifdef SMART_ARRAY_X86_SIMD
+            { &sse2::popcount, &sse2::bit_and, &sse2::bit_or, &sse2::bit_xor, &sse2::bit_not },
+            { &avx2::popcount, &avx2::bit_and, &avx2::bit_or, &avx2::bit_xor, &avx2::bit_not }
+#endif
+        };
+        return tables[isa()];
+    }
+
+    ///Returns number of set bits of n words.
+    inline size_t popcount(const uint64_t *p, size_t n) { return word_kernels().popcount(p, n); }
+    ///Stores l & r into l, n words.
+    inline void bit_and(uint64_t *l, const uint64_t *r, size_t n) { word_kernels().bit_and(l, r, n); }
+    ///Stores l | r into l, n words.
+    inline void bit_or(uint64_t *l, const uint64_t *r, size_t n) { word_kernels().bit_or(l, r, n); }
+    ///Stores l ^ r into l, n words.
+    inline void bit_xor(uint64_t *l, const uint64_t *r, size_t n) { word_kernels().bit_xor(l, r, n); }
+    ///Inverts n words.
+    inline void bit_not(uint64_t *p, size_t n) { word_kernels().bit_not(p, n); }
+
+    /**
+    \brief Number of values of a bit-packed block. Values are split into 4 lanes, value j
+     going to lane j % 4, and each lane stores its 32 values in consecutive bits of
+     its own 32-bit words. Word k of lane l is word 4 * k + l of the block, so a block
+     of values taking bits bits each occupies 4 * bits words and one 128-bit load
+     fetches word k of every lane.
+    */
+    const size_t packed_block_size = 128;
+
+    namespace scalar {
+
+        /**
+        \brief Unpacks a block of packed_block_size values of given bit width.
+         In frame of reference mode (Delta false) value j is base plus stored value j,
+         in delta mode value j is value j - 4, or base for the first row, plus stored value j.
+        \param in_ptr Block of 4 * bits words.
+        \param bits Bit width, 0 to 32.
+        \param base Base value.
+        \param out_ptr Array of packed_block_size values.
+        */
+        template <bool Delta>
+        void unpack_block(const uint32_t *in_ptr, unsigned bits, uint32_t base, uint32_t *out_ptr)
+        {
+            uint32_t mask = bits < 32 ? (uint32_t(1) << bits) - 1 : ~uint32_t(0);
+
+            for (size_t lane = 0; lane < 4; ++lane) {
+                uint32_t value = base;
+                for (size_t row = 0; row < 32; ++row) {
+                    size_t bit = row * bits, word = bit / 32 * 4 + lane, shift = bit % 32;
+                    uint32_t stored = 0;
+                    if (bits) {
+                        stored = in_ptr[word] >> shift;
+                        if (shift + bits > 32) {
+                            stored |= in_ptr[word + 4] << (32 - shift);
+                        }
+                    }
+                    value = Delta ? value + (stored & mask) : base + (stored & mask);
+                    out_ptr[row * 4 + lane] = value;
+                }
+            }
+        }
+
+        inline void unpack_for(const uint32_t *in_ptr, unsigned bits, uint32_t base, uint32_t *out_ptr)
+        {
+            unpack_block<false>(in_ptr, bits, base, out_ptr);
+        }
+
+        inline void unpack_delta(const uint32_t *in_ptr, unsigned bits, uint32_t base, uint32_t *out_ptr)
+        {
+            unpack_block<true>(in_ptr, bits, base, out_ptr);
+        }
+    }
+
+#ifdef SMART_ARRAY_X86_SIMD
+    namespace sse2 {
+
+        /**
+        \brief Unpacks a block of packed_block_size values, a row of 4 lanes at a time.
+         See scalar::unpack_block.
+        */
+        template <bool Delta>
+        void unpack_block(const uint32_t *in_ptr, unsigned bits, uint32_t base, uint32_t *out_ptr)
+        {
+            const __m128i *words_ptr = reinterpret_cast<const __m128i *>(in_ptr);
+            __m128i mask = _mm_set1_epi32(bits < 32 ? int((uint32_t(1) << bits) - 1) : -1);
+            __m128i bases = _mm_set1_epi32(int(base));
+            __m128i values = bases;
+            __m128i current = bits ? _mm_loadu_si128(words_ptr) : _mm_setzero_si128();
+            unsigned shift = 0;
+
+            for (size_t row = 0; row < 32; ++row) {
+                __m128i stored = _mm_srl_epi32(current, _mm_cvtsi32_si128(int(shift)));
+                shift += bits;
+                if (shift >= 32 && row < 31) {
+                    shift -= 32;
+                    current = _mm_loadu_si128(++words_ptr);
+                    if (shift) {
+                        stored = _mm_or_si128(stored, _mm_sll_epi32(current, _mm_cvtsi32_si128(int(bits - shift))));
+                    }
+                }
+                stored = _mm_and_si128(stored, mask);
+                values = _mm_add_epi32(Delta ? values : bases, stored);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out_ptr + row * 4), values);
+            }
+        }
+
+        inline void unpack_for(const uint32_t *in_ptr, unsigned bits, uint32_t base, uint32_t *out_ptr)
+        {
+            unpack_block<false>(in_ptr, bits, base, out_ptr);
+        }
+
+        inline void unpack_delta(const uint32_t *in_ptr, unsigned bits, uint32_t base, uint32_t *out_ptr)
+        {
+            unpack_block<true>(in_ptr, bits, base, out_ptr);
+        }
+    }
+#endif
+
+    /**
+    \brief Block unpacking kernels of one instruction set. The block layout holds 4 lanes,
+     so AVX2 uses the SSE2 kernels.
+    */
+    struct Block_kernel_table
+    {
+        void (*unpack_for)(const uint32_t *, unsigned, uint32_t, uint32_t *);
+        void (*unpack_delta)(const uint32_t *, unsigned, uint32_t, uint32_t *);
+    };
+
+    ///Returns the block unpacking kernels of the active instruction set.
+    inline const Block_kernel_table &block_kernels()
+    {
+        static const Block_kernel_table tables[] = {
+            { &scalar::unpack_for, &scalar::unpack_delta },
+#ifdef SMART_ARRAY_X86_SIMD
+            { &sse2::unpack_for, &sse2::unpack_delta },
+            { &sse2::unpack_for, &sse2::unpack_delta }
+#endif
+        };
+        return tables[isa()];
+    }
+
+    ///Unpacks a frame of reference block, see scalar::unpack_block.
+    inline void unpack_for(const uint32_t *in, unsigned bits, uint32_t base, uint32_t *out)
+    {
+        block_kernels().unpack_for(in, bits, base, out);
+    }
+    ///Unpacks a delta block, see scalar::unpack_block.
+    inline void unpack_delta(const uint32_t *in, unsigned bits, uint32_t base, uint32_t *out)
+    {
+        block_kernels().unpack_delta(in, bits, base, out);
+    }
+
+    //Overloads for element types with SIMD kernels.
+
+    inline bool equal(const int *l, const int *r, size_t n) { return kernels<int>().equal(l, r, n); }
+    inline bool equal(const float *l, const float *r, size_t n) { return kernels<float>().equal(l, r, n); }
+    inline bool equal(const double *l, const double *r, size_t n) { return kernels<double>().equal(l, r, n); }
+    inline bool equal(const uint8_t *l, const uint8_t *r, size_t n) { return kernels<uint8_t>().equal(l, r, n); }
+
+    inline size_t find(const int *p, size_t n, int v) { return kernels<int>().find(p, n, v); }
+    inline size_t find(const float *p, size_t n, float v) { return kernels<float>().find(p, n, v); }
+    inline size_t find(const double *p, size_t n, double v) { return kernels<double>().find(p, n, v); }
+    inline size_t find(const uint8_t *p, size_t n, uint8_t v) { return kernels<uint8_t>().find(p, n, v); }
+
+    inline size_t count(const int *p, size_t n, int v) { return kernels<int>().count(p, n, v); }
+    inline size_t count(const float *p, size_t n, float v) { return kernels<float>().count(p, n, v); }
+    inline size_t count(const double *p, size_t n, double v) { return kernels<double>().count(p, n, v); }
+    inline size_t count(const uint8_t *p, size_t n, uint8_t v) { return kernels<uint8_t>().count(p, n, v); }
+
+    inline int min_value(const int *p, size_t n) { return kernels<int>().min_value(p, n); }
+    inline float min_value(const float *p, size_t n) { return kernels<float>().min_value(p, n); }
+    inline double min_value(const double *p, size_t n) { return kernels<double>().min_value(p, n); }
+    inline uint8_t min_value(const uint8_t *p, size_t n) { return kernels<uint8_t>().min_value(p, n); }
+
+    inline int max_value(const int *p, size_t n) { return kernels<int>().max_value(p, n); }
+    inline float max_value(const float *p, size_t n) { return kernels<float>().max_value(p, n); }
+    inline double max_value(const double *p, size_t n) { return kernels<double>().max_value(p, n); }
+    inline uint8_t max_value(const uint8_t *p, size_t n) { return kernels<uint8_t>().max_value(p, n); }
+
+    inline long long sum(const int *p, size_t n) { return kernels<int>().sum(p, n); }
+    inline float sum(const float *p, size_t n) { return kernels<float>().sum(p, n); }
+    inline double sum(const double *p, size_t n) { return kernels<double>().sum(p, n); }
+    inline unsigned long long sum(const uint8_t *p, size_t n) { return kernels<uint8_t>().sum(p, n); }
+}
+}
+
+#endif
@@ -0,0 +1,720 @@
+/**
+\file
+\brief File contains definition of template Small_vector class.
+*/
+
+#ifndef _SMALL_VECTOR_HPP_
+#define _SMALL_VECTOR_HPP_
+
+#include "smart_array.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Vector storing up to N elements inline, without heap allocation.
+     Past N elements storage is moved to the heap obtained from Allocator.
+     Has the interface of Vector, so callers can switch with a typedef change.
+     Moving or swapping inline elements moves them one by one.
+    */
+    template <typename T, size_t N, typename Allocator = std::allocator<T>,
+              typename Growth = Geometric_growth<> >
+    class Small_vector
+    {
+        static_assert(N > 0, "Inline capacity must be positive.");
+        typedef std::allocator_traits<Allocator> alloc_traits;
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef Allocator allocator_type;
+
+        ///Iterator class, contiguous with signed offsets.
+        typedef R_a_iterator<T> Iterator;
+        ///Reverse iterator class, an adaptor of Iterator.
+        typedef Reverse_r_a_iterator<T> Reverse_iterator;
+
+        typedef Iterator iterator;
+        typedef R_a_iterator<const T> const_iterator;
+        typedef Reverse_iterator reverse_iterator;
+        typedef Reverse_r_a_iterator<const T> const_reverse_iterator;
+
+        ///Default constructor.
+        Small_vector() : v_size(0), v_capacity(N), v_front_ptr(inline_ptr()), v_alloc() {}
+        ///Constructor of an empty vector using given allocator.
+        explicit Small_vector(const Allocator &alloc)
+            : v_size(0), v_capacity(N), v_front_ptr(inline_ptr()), v_alloc(alloc) {}
+        Small_vector(const size_type, const T & = T(), const Allocator & = Allocator());
+        Small_vector(const Small_vector &vec);
+        Small_vector(const Small_vector &vec, const Allocator &alloc);
+        Small_vector(Small_vector &&vec) noexcept(std::is_nothrow_move_constructible<T>::value);
+        template <typename In>
+        Small_vector(In, In, const Allocator & = Allocator());
+        ~Small_vector(void);
+
+        const Small_vector &operator=(const Small_vector &);
+        const Small_vector &operator=(Small_vector &&)
+            noexcept(std::is_nothrow_move_constructible<T>::value
+                     && (alloc_traits::propagate_on_container_move_assignment::value
+                         || alloc_traits::is_always_equal::value));
+        bool operator==(const Small_vector &) const;
+        bool operator!=(const Small_vector & vec) const;
+        T &operator[](const size_type i) { return v_front_ptr[i]; }
+        const T &operator[](const size_type i) const { return v_front_ptr[i]; }
+        T &at(size_type);
+        const T &at(size_type) const;
+        void assign(const size_type , const T& = T());
+        template <typename In>
+        void assign(In, In);
+        template <typename In>
+        void append(In, In);
+        void push_back(const T &value) { emplace_back(value); }
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        template <typename... Args>
+        T &emplace_back(Args &&...);
+        void pop_back();
+        iterator insert(iterator pos, const T &value) { return emplace(pos, value); }
+        iterator insert(iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+        iterator insert(iterator, const size_type, const T &);
+        template <typename In>
+        iterator insert(iterator, In, In);
+        template <typename... Args>
+        iterator emplace(iterator, Args &&...);
+        iterator erase(iterator);
+        iterator erase(iterator, iterator);
+        T &front() { return *v_front_ptr; }
+        T &back() { return v_front_ptr[v_size - 1]; }
+        const T &front() const { return *v_front_ptr; }
+        const T &back() const { return v_front_ptr[v_size - 1]; }
+        iterator begin() { return iterator(v_front_ptr); }
+        iterator end() { return iterator(v_front_ptr + v_size); }
+        const_iterator begin() const { return const_iterator(v_front_ptr); }
+        const_iterator end() const { return const_iterator(v_front_ptr + v_size); }
+        reverse_iterator rbegin() { return reverse_iterator(v_front_ptr + v_size); }
+        reverse_iterator rend() { return reverse_iterator(v_front_ptr); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(v_front_ptr + v_size); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(v_front_ptr); }
+        ///Returns pointer to the first element, inline or on the heap.
+        T *data() { return v_front_ptr; }
+        ///Returns const pointer to the first element, inline or on the heap.
+        const T *data() const { return v_front_ptr; }
+        ///Returns view of the elements for algorithms and kernels working on raw pointers.
+        Span<T> span() { return Span<T>(v_front_ptr, v_size); }
+        ///Returns read-only view of the elements.
+        Span<const T> span() const { return Span<const T>(v_front_ptr, v_size); }
+        bool empty() const { return 0 == v_size; }
+        size_type capacity() const { return v_capacity; }
+        size_type size() const { return v_size; }
+        void reserve(const size_type);
+        void resize(const size_type, const T & = T());
+        void swap(Small_vector &)
+            noexcept(std::is_nothrow_move_constructible<T>::value
+                     && (alloc_traits::propagate_on_container_move_assignment::value
+                         || alloc_traits::is_always_equal::value));
+        void clear();
+        size_type max_size() const { return alloc_traits::max_size(v_alloc); }
+        allocator_type get_allocator() const { return v_alloc; }
+        ///Checks if elements are stored inline.
+        bool is_inline() const { return v_front_ptr == inline_ptr(); }
+
+    private:
+        ///Number of elements in vector.
+        size_type v_size;
+        ///Number of elements the vector can contain before reallocating, N while inline.
+        size_type v_capacity;
+        ///Pointer to the start of an object array, inline buffer or heap.
+        T *v_front_ptr;
+        ///Allocator providing the heap storage.
+        Allocator v_alloc;
+        ///Inline storage for N elements.
+        alignas(T) unsigned char v_buffer[N * sizeof(T)];
+
+        T *inline_ptr() { return reinterpret_cast<T *>(v_buffer); }
+        const T *inline_ptr() const { return reinterpret_cast<const T *>(v_buffer); }
+        void free_heap();
+        void reallocate(const size_type new_cap);
+        size_type re_capacity(const size_type size) const;
+        template <typename Int>
+        void insert_dispatcher(size_type, Int, Int, std::__true_type);
+        template <typename In>
+        void insert_dispatcher(size_type, In, In, std::__false_type);
+        template <typename In>
+        void insert_range(size_type, In, In, std::input_iterator_tag);
+        template <typename In>
+        void insert_range(size_type, In, In, std::forward_iterator_tag);
+    };
+
+    /**
+    \brief Constructor.
+    \param size Count of elements.
+    \param value Optional reference to an object to initialize all elements.
+    \param alloc Optional allocator.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    Small_vector<T, N, Allocator, Growth>::Small_vector(const size_type size, const T &value,
+                                                        const Allocator &alloc)
+        : v_size(0), v_capacity(N), v_front_ptr(inline_ptr()), v_alloc(alloc)
+    {
+        insert(end(), size, value);
+    }
+
+    /**
+    \brief Copy constructor.
+    \param vec Reference to a Small_vector object.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    Small_vector<T, N, Allocator, Growth>::Small_vector(const Small_vector &vec)
+        : v_size(0), v_capacity(N), v_front_ptr(inline_ptr()),
+          v_alloc(alloc_traits::select_on_container_copy_construction(vec.v_alloc))
+    {
+        append(vec.v_front_ptr, vec.v_front_ptr + vec.v_size);
+    }
+
+    /**
+    \brief Copy constructor using given allocator.
+    \param vec Reference to a Small_vector object.
+    \param alloc Allocator of the new vector.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    Small_vector<T, N, Allocator, Growth>::Small_vector(const Small_vector &vec, const Allocator &alloc)
+        : v_size(0), v_capacity(N), v_front_ptr(inline_ptr()), v_alloc(alloc)
+    {
+        append(vec.v_front_ptr, vec.v_front_ptr + vec.v_size);
+    }
+
+    /**
+    \brief Move constructor. Takes over heap storage, inline elements are moved one by one.
+     Given vector is left empty.
+    \param vec Rvalue reference to a Small_vector object.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    Small_vector<T, N, Allocator, Growth>::Small_vector(Small_vector &&vec)
+        noexcept(std::is_nothrow_move_constructible<T>::value)
+        : v_size(0), v_capacity(N), v_front_ptr(inline_ptr()), v_alloc(std::move(vec.v_alloc))
+    {
+        if (vec.is_inline()) {
+            tasks::uninitialized_move(v_front_ptr, vec.v_front_ptr, v_front_ptr + vec.v_size);
+            v_size = vec.v_size;
+            vec.clear();
+        } else {
+            v_size = vec.v_size;
+            v_capacity = vec.v_capacity;
+            v_front_ptr = vec.v_front_ptr;
+            vec.v_size = 0;
+            vec.v_capacity = N;
+            vec.v_front_ptr = vec.inline_ptr();
+        }
+    }
+
+    /**
+    \brief Constructor.
+    \param it_begin, it_end Iterators to the start and end of the sequence to initialize.
+    \param alloc Optional allocator.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename In>
+    Small_vector<T, N, Allocator, Growth>::Small_vector(In it_begin, In it_end, const Allocator &alloc)
+        : v_size(0), v_capacity(N), v_front_ptr(inline_ptr()), v_alloc(alloc)
+    {
+        insert(end(), it_begin, it_end);
+    }
+
+    ///Destructor.
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    Small_vector<T, N, Allocator, Growth>::~Small_vector(void)
+    {
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        free_heap();
+    }
+
+    /**
+    \brief Assigns given vector to the Small_vector object.
+     The allocator is taken from given vector only if it propagates on copy assignment,
+     heap storage of the previous allocator is freed first.
+    \param right Given vector.
+    \return Changed Small_vector object.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    const Small_vector<T, N, Allocator, Growth> &
+    Small_vector<T, N, Allocator, Growth>::operator=(const Small_vector &right)
+    {
+        if (this != &right) {
+            if (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (!alloc_traits::is_always_equal::value && !(v_alloc == right.v_alloc)) {
+                    clear();
+                    free_heap();
+                }
+                v_alloc = right.v_alloc;
+            }
+            assign(right.v_front_ptr, right.v_front_ptr + right.v_size);
+        }
+        return *this;
+    }
+
+    /**
+    \brief Move assigns given vector to the Small_vector object.
+     Heap storage is taken over unless allocators differ and do not propagate,
+     inline elements are moved one by one. The allocator is taken from given vector
+     if it propagates on move assignment. Given vector is left empty.
+    \param right Given vector.
+    \return Changed Small_vector object.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    const Small_vector<T, N, Allocator, Growth> &
+    Small_vector<T, N, Allocator, Growth>::operator=(Small_vector &&right)
+        noexcept(std::is_nothrow_move_constructible<T>::value
+                 && (alloc_traits::propagate_on_container_move_assignment::value
+                     || alloc_traits::is_always_equal::value))
+    {
+        if (this == &right) {
+            return *this;
+        }
+        clear();
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            free_heap();
+            v_alloc = right.v_alloc;
+        }
+        if (right.is_inline() || !(alloc_traits::propagate_on_container_move_assignment::value
+                                   || alloc_traits::is_always_equal::value || v_alloc == right.v_alloc)) {
+            append(std::make_move_iterator(right.v_front_ptr),
+                   std::make_move_iterator(right.v_front_ptr + right.v_size));
+            right.clear();
+        } else {
+            free_heap();
+            v_size = right.v_size;
+            v_capacity = right.v_capacity;
+            v_front_ptr = right.v_front_ptr;
+            right.v_size = 0;
+            right.v_capacity = N;
+            right.v_front_ptr = right.inline_ptr();
+        }
+        return *this;
+    }
+
+    /**
+    \brief Compare equality of two vectors.
+    \param right Vector to compare with.
+    \return true if equal, false if not.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    bool Small_vector<T, N, Allocator, Growth>::operator==(const Small_vector &right) const
+    {
+        return v_size == right.v_size && std::equal(v_front_ptr, v_front_ptr + v_size, right.v_front_ptr);
+    }
+
+    /**
+    \brief Compare non equality of two vectors.
+    \param vec Vector to compare with.
+    \return true if non equal, false if equal;
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    bool Small_vector<T, N, Allocator, Growth>::operator!=(const Small_vector &vec) const
+    {
+        return !(*this == vec);
+    }
+
+    /**
+    \brief Accessing the vector element. Throws exception if index is out of range.
+    \param i Index.
+    \return Reference to the element.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    T &Small_vector<T, N, Allocator, Growth>::at(size_type i)
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+        return v_front_ptr[i];
+    }
+
+    /**
+    \brief Accessing the vector element. Throws exception if index is out of range.
+    \param i Index.
+    \return Const reference to the element.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    const T &Small_vector<T, N, Allocator, Growth>::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+        return v_front_ptr[i];
+    }
+
+    /**
+    \brief Replaces the contents with count copies of given value.
+    \param count Number of elements.
+    \param value Value to be copied, may refer to an element of the vector.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::assign(const size_type count, const T &value)
+    {
+        T value_copy(value);
+
+        clear();
+        insert(end(), count, value_copy);
+    }
+
+    /**
+    \brief Replaces the contents with the elements of the range [first, last).
+     The range must not refer to the vector.
+    \param first, last Iterators to the start and end of the range.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename In>
+    void Small_vector<T, N, Allocator, Growth>::assign(In first, In last)
+    {
+        clear();
+        insert(end(), first, last);
+    }
+
+    /**
+    \brief Appends elements of the range [first, last) to the end.
+     The range must not refer to the vector.
+    \param first, last Iterators to the start and end of the range.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename In>
+    void Small_vector<T, N, Allocator, Growth>::append(In first, In last)
+    {
+        insert(end(), first, last);
+    }
+
+    /**
+    \brief Constructs element in place at the end of the vector. Moves to the heap if neccessary.
+     Arguments may refer to elements of the vector.
+    \param args Arguments forwarded to the constructor of T.
+    \return Reference to the constructed element.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename... Args>
+    T &Small_vector<T, N, Allocator, Growth>::emplace_back(Args &&... args)
+    {
+        if (v_size == v_capacity) {
+            T value(std::forward<Args>(args)...);
+            reallocate(re_capacity(v_size + 1));
+            ::new (static_cast<void *>(v_front_ptr + v_size)) T(std::move(value));
+        } else {
+            ::new (static_cast<void *>(v_front_ptr + v_size)) T(std::forward<Args>(args)...);
+        }
+        return v_front_ptr[v_size++];
+    }
+
+    ///Popping the last element of Small_vector.
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::pop_back()
+    {
+        if (v_size) {
+            --v_size;
+            v_front_ptr[v_size].~T();
+        }
+    }
+
+    /**
+    \brief Inserts count copies of value before given position. Does nothing if position is out of range.
+    \param pos Position.
+    \param count Number of copies.
+    \param value Value to be inserted, may refer to an element of the vector.
+    \return Iterator to the first inserted element, end if position is out of range.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    typename Small_vector<T, N, Allocator, Growth>::iterator
+    Small_vector<T, N, Allocator, Growth>::insert(iterator pos, const size_type count, const T &value)
+    {
+        if (end() < pos || pos < begin()) {
+            return end();
+        }
+        size_type index = pos - begin();
+        T value_copy(value);
+        insert_range(index, Repeat_iterator<T>(value_copy, count),
+                     Repeat_iterator<T>(value_copy, 0), std::forward_iterator_tag());
+        return iterator(v_front_ptr + index);
+    }
+
+    /**
+    \brief Inserts elements of the range [first, last) before given position.
+     Does nothing if position is out of range. The range must not refer to the vector.
+    \param pos Position.
+    \param first, last Iterators to the start and end of the range.
+    \return Iterator to the first inserted element, end if position is out of range.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename In>
+    typename Small_vector<T, N, Allocator, Growth>::iterator
+    Small_vector<T, N, Allocator, Growth>::insert(iterator pos, In first, In last)
+    {
+        if (end() < pos || pos < begin()) {
+            return end();
+        }
+        typedef typename std::__is_integer<In>::__type Integral;
+        size_type index = pos - begin();
+        insert_dispatcher(index, first, last, Integral());
+        return iterator(v_front_ptr + index);
+    }
+
+    /**
+    \brief Overloaded function called by range insert for integral arguments,
+     which mean count and value.
+    \param std::__true_type is a struct that is used to decide
+     which overloaded function will be called
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename Int>
+    void Small_vector<T, N, Allocator, Growth>::insert_dispatcher(size_type index, Int count,
+                                                                  Int value, std::__true_type)
+    {
+        insert(iterator(v_front_ptr + index), static_cast<size_type>(count), static_cast<T>(value));
+    }
+
+    /**
+    \brief Overloaded function called by range insert for iterators.
+    \param std::__false_type is a struct that is used to decide
+     which overloaded function will be called
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename In>
+    void Small_vector<T, N, Allocator, Growth>::insert_dispatcher(size_type index, In first,
+                                                                  In last, std::__false_type)
+    {
+        typedef typename std::iterator_traits<In>::iterator_category category;
+        insert_range(index, first, last, category());
+    }
+
+    /**
+    \brief Inserts range of single pass iterators. Elements are appended one by one
+     and rotated into place.
+    \param std::input_iterator_tag.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename In>
+    void Small_vector<T, N, Allocator, Growth>::insert_range(size_type index, In first, In last,
+                                                             std::input_iterator_tag)
+    {
+        size_type old_size = v_size;
+
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(v_front_ptr + index, v_front_ptr + old_size, v_front_ptr + v_size);
+    }
+
+    /**
+    \brief Inserts range of forward iterators, moving to the heap at most once.
+     The tail is moved into spare capacity and the range is assigned or constructed
+     into the gap, so the vector stays valid if a constructor throws.
+    \param std::forward_iterator_tag.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename In>
+    void Small_vector<T, N, Allocator, Growth>::insert_range(size_type index, In first, In last,
+                                                             std::forward_iterator_tag)
+    {
+        size_type count = std::distance(first, last);
+
+        if (0 == count) {
+            return;
+        }
+        if (v_size + count > v_capacity) {
+            reallocate(re_capacity(v_size + count));
+        }
+        T *pos_ptr = v_front_ptr + index;
+        T *old_end_ptr = v_front_ptr + v_size;
+        size_type tail = v_size - index;
+
+        if (tail > count) {
+            tasks::uninitialized_move(old_end_ptr, old_end_ptr - count, old_end_ptr + count);
+            v_size += count;
+            std::move_backward(pos_ptr, old_end_ptr - count, old_end_ptr);
+            std::copy(first, last, pos_ptr);
+        } else {
+            In mid = first;
+            std::advance(mid, tail);
+
+            for (In it = mid; it != last; ++it, ++v_size) {
+                ::new (static_cast<void *>(v_front_ptr + v_size)) T(*it);
+            }
+            tasks::uninitialized_move(v_front_ptr + v_size, pos_ptr, v_front_ptr + v_size + tail);
+            v_size += tail;
+            std::copy(first, mid, pos_ptr);
+        }
+    }
+
+    /**
+    \brief Constructs element in place at given position. Does nothing if position is out of range.
+    \param pos Position.
+    \param args Arguments forwarded to the constructor of T.
+    \return Iterator to the inserted element if inserted, to the end otherwise.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth> template <typename... Args>
+    typename Small_vector<T, N, Allocator, Growth>::iterator
+    Small_vector<T, N, Allocator, Growth>::emplace(iterator pos, Args &&... args)
+    {
+        if (pos == end()) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(v_front_ptr + v_size - 1);
+        }
+        if (end() < pos || pos < begin()) {
+            return end();
+        }
+        size_type index = pos - begin();
+        T value(std::forward<Args>(args)...);
+
+        if (v_size == v_capacity) {
+            reallocate(re_capacity(v_size + 1));
+        }
+        tasks::shift_right(v_front_ptr + index, v_front_ptr + v_size);
+        ++v_size;
+        v_front_ptr[index] = std::move(value);
+        return iterator(v_front_ptr + index);
+    }
+
+    /**
+    \brief Remove element of given position. Does nothing if position is out of range.
+    \param pos Position.
+    \return Iterator to the next element of removed element, to the end if not removed.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    typename Small_vector<T, N, Allocator, Growth>::iterator
+    Small_vector<T, N, Allocator, Growth>::erase(iterator pos)
+    {
+        if (end() < pos || pos == end() || pos < begin()) {
+            return end();
+        }
+        tasks::shift_left(&*pos, v_front_ptr + v_size, 1);
+        pop_back();
+        return pos;
+    }
+
+    /**
+    \brief Removes elements of the range [first, last) with one shift of the tail.
+     Does nothing if the range is out of the vector.
+    \param first, last Iterators to the start and end of the range.
+    \return Iterator to the element following the removed ones, end if nothing is removed.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    typename Small_vector<T, N, Allocator, Growth>::iterator
+    Small_vector<T, N, Allocator, Growth>::erase(iterator first, iterator last)
+    {
+        if (first < begin() || end() < last || last < first) {
+            return end();
+        }
+        size_type count = last - first;
+
+        if (count) {
+            T *end_ptr = v_front_ptr + v_size;
+            tasks::shift_left(&*first, end_ptr, count);
+            tasks::destroy(end_ptr - count, end_ptr);
+            v_size -= count;
+        }
+        return first;
+    }
+
+    /**
+    \brief Increasing the capacity if given value is greater than capacity.
+           Throws length_error if value is greater than maximum size.
+    \param new_cap Capacity.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::reserve(const size_type new_cap)
+    {
+        if (new_cap > max_size()) {
+            throw std::length_error("Capacity cannot be greater than maximum size.");
+        }
+        if (new_cap > v_capacity) {
+            reallocate(new_cap);
+        }
+    }
+
+    /**
+    \brief Changes the number of stored elements. Works like std::vector::resize().
+    \param new_size Number of elements.
+    \param value Value of appended elements if new_size is greater than the size.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::resize(const size_type new_size, const T &value)
+    {
+        if (new_size <= v_size) {
+            tasks::destroy(v_front_ptr + new_size, v_front_ptr + v_size);
+            v_size = new_size;
+        } else {
+            insert(end(), new_size - v_size, value);
+        }
+    }
+
+    /**
+    \brief Swaps the contents of two vectors. Heap buffers are exchanged without
+     throwing, with the allocators if they propagate on swap, inline elements are moved.
+    \param other Vector to make swap with.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::swap(Small_vector &other)
+        noexcept(std::is_nothrow_move_constructible<T>::value
+                 && (alloc_traits::propagate_on_container_move_assignment::value
+                     || alloc_traits::is_always_equal::value))
+    {
+        if (this == &other) {
+            return;
+        }
+        if (!is_inline() && !other.is_inline()) {
+            std::swap(v_size, other.v_size);
+            std::swap(v_capacity, other.v_capacity);
+            std::swap(v_front_ptr, other.v_front_ptr);
+            if (alloc_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap(v_alloc, other.v_alloc);
+            }
+        } else {
+            Small_vector temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+    }
+
+    ///Removes all elements, keeps the capacity.
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::clear()
+    {
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        v_size = 0;
+    }
+
+    ///Returns heap storage to the allocator and switches back to the inline buffer.
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::free_heap()
+    {
+        if (!is_inline()) {
+            alloc_traits::deallocate(v_alloc, v_front_ptr, v_capacity);
+            v_front_ptr = inline_ptr();
+            v_capacity = N;
+        }
+    }
+
+    /**
+    \brief Moves elements into newly allocated heap storage of given capacity.
+    \param new_cap New capacity, must be greater than N and not less than size.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    void Small_vector<T, N, Allocator, Growth>::reallocate(const size_type new_cap)
+    {
+        SMART_ARRAY_STAT(stats::on_allocate<T>(new_cap));
+        T *temp_ptr = alloc_traits::allocate(v_alloc, new_cap);
+
+        try {
+            tasks::uninitialized_move_if_noexcept(temp_ptr, v_front_ptr, temp_ptr + v_size);
+        } catch (...) {
+            alloc_traits::deallocate(v_alloc, temp_ptr, new_cap);
+            throw;
+        }
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        free_heap();
+        v_front_ptr = temp_ptr;
+        v_capacity = new_cap;
+    }
+
+    /**
+    \brief Calculates the capacity for growing to given number of elements using the growth policy.
+    \param size Number of elements that must fit.
+    \return New capacity value.
+    */
+    template <typename T, size_t N, typename Allocator, typename Growth>
+    typename Small_vector<T, N, Allocator, Growth>::size_type
+    Small_vector<T, N, Allocator, Growth>::re_capacity(const size_type size) const
+    {
+        size_type new_cap = Growth::grow(v_capacity, size, sizeof(T));
+
+        SMART_ARRAY_STAT(stats::on_grow<T>(size, new_cap));
+        return new_cap;
+    }
+}
+
+#endif
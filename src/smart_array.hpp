@@ -10,68 +10,100 @@
 #include <limits>
 #include <cstdlib>
 #include <cstddef>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <string>
 #include <bits/cpp_type_traits.h>
 
 #include "r_a_iterator.hpp"
+#include "span.hpp"
+#include "growth_policy.hpp"
+#include "vector_stats.hpp"
+#include "simd_kernels.hpp"
+#include "vector_io.hpp"
 
 namespace tasks {
-    const unsigned cap_modifier = 3;
 
     /**
     \brief Template Vector class. 
+     Memory is obtained from Allocator through std::allocator_traits, 
+     elements are constructed in it with placement new.
+     Growth policy decides the capacity when elements do not fit (see growth_policy.hpp).
     */
-    template <typename T>
+    template <typename T, typename Allocator = std::allocator<T>, 
+              typename Growth = Geometric_growth<> >
     class Vector
     {
+        typedef std::allocator_traits<Allocator> alloc_traits;
+
     public:
+        typedef T value_type;
         typedef size_t size_type;
+        typedef Allocator allocator_type;
 
-        class Reverse_iterator;
-
-        /**
-        \brief Iterator class.
-        */
-        class Iterator : public R_a_iterator<T> 
-        {
-        public:
-            Iterator(const T *w_ptr); 
-        };
-
-        /**
-        \brief Reverse iterator class.
-        */
-        class Reverse_iterator : public Reverse_r_a_iterator<T>
-        {
-        public:
-            Reverse_iterator(const T *w_ptr);
-            operator Iterator() const;
-        };
+        ///Iterator class, contiguous with signed offsets.
+        typedef R_a_iterator<T> Iterator;
+        ///Reverse iterator class, an adaptor of Iterator.
+        typedef Reverse_r_a_iterator<T> Reverse_iterator;
 
         typedef Iterator iterator;
-        typedef const Iterator const_iterator;
+        typedef R_a_iterator<const T> const_iterator;
         typedef Reverse_iterator reverse_iterator;
-        typedef const Reverse_iterator const_reverse_iterator;
+        typedef Reverse_r_a_iterator<const T> const_reverse_iterator;
 
         ///Default constructor. 
-        Vector() : v_size(0), v_capacity(0), v_front_ptr(0) {}
-        Vector(const size_type, const T & = T());
-        Vector(const Vector<T> &vec);
+        Vector() : v_size(0), v_capacity(0), v_front_ptr(0), v_alloc() {}
+        ///Constructor of an empty vector using given allocator. 
+        explicit Vector(const Allocator &alloc) 
+            : v_size(0), v_capacity(0), v_front_ptr(0), v_alloc(alloc) {}
+        Vector(const size_type, const T & = T(), const Allocator & = Allocator());
+        Vector(const Vector &vec);
+        Vector(const Vector &vec, const Allocator &alloc);
+        Vector(Vector &&vec) noexcept;
         template <typename In>
-        Vector(In, In);
+        Vector(In, In, const Allocator & = Allocator());
+        template <typename Expr, typename = typename Expr::is_vector_expression>
+        Vector(const Expr &, const Allocator & = Allocator());
         ~Vector(void);
         
-        const Vector<T> &operator=(const Vector<T> &);
-        bool operator==(const Vector<T> &) const;
-        bool operator!=(const Vector<T> & vec) const;
+        const Vector &operator=(const Vector &);
+        const Vector &operator=(Vector &&) 
+            noexcept(alloc_traits::propagate_on_container_move_assignment::value
+                     || alloc_traits::is_always_equal::value);
+        template <typename Expr, typename = typename Expr::is_vector_expression>
+        const Vector &operator=(const Expr &);
+        bool operator==(const Vector &) const;
+        bool operator!=(const Vector & vec) const;
         T &operator[](const size_type i);
         const T &operator[](const size_type i) const;
         T &at(size_type);
         const T &at(size_type) const;
         void assign(const size_type , const T& = T());
+        template <typename In>
+        void assign(In, In);
+        template <typename In>
+        void append(In, In);
         void push_back(const T &);
+        void push_back(T &&);
+        template <typename... Args>
+        T &emplace_back(Args &&...);
         void pop_back();
         iterator insert(iterator, const T &);
+        iterator insert(iterator, T &&);
+        iterator insert(iterator, const size_type, const T &);
+        template <typename In>
+        iterator insert(iterator, In, In);
+        template <typename... Args>
+        iterator emplace(iterator, Args &&...);
         iterator erase(iterator);
+        iterator erase(iterator, iterator);
         T &front();
         T &back();
         const T &front() const;
@@ -84,14 +116,23 @@ namespace tasks {
         reverse_iterator rend();
         const_reverse_iterator rbegin() const;
         const_reverse_iterator rend() const;
+        T *data();
+        const T *data() const;
+        Span<T> span();
+        Span<const T> span() const;
         bool empty() const;
         size_type capacity() const;
         size_type size() const;
         void reserve(const size_type);
         void resize(const size_type, const T & = T()); 
-        void swap(Vector<T> &);
+        void swap(Vector &) noexcept;
         void clear();
         size_type max_size() const;
+        allocator_type get_allocator() const;
+        void save(std::ostream &) const;
+        void save(const std::string &) const;
+        void load(std::istream &);
+        void load(const std::string &);
 
     private:
         ///Number of elements in vector.
@@ -100,9 +141,14 @@ namespace tasks {
         size_type v_capacity;
         ///Pointer to the start of an object array.
         T *v_front_ptr;
+        ///Allocator providing the storage.
+        Allocator v_alloc;
 
         T *service_dynamic(const size_type new_cap);
-        size_type re_capacity();
+        void service_free(T *ptr, const size_type cap);
+        void take_storage(Vector &other) noexcept;
+        void reallocate(const size_type new_cap);
+        size_type re_capacity(const size_type size) const;
         template <typename Int>
         void initialize_dispatcher(Int, Int, std::__true_type);
         template <typename In>
@@ -110,57 +156,358 @@ namespace tasks {
         template <typename In>
         void range_constructor_helper(In, In, std::input_iterator_tag);
         void constructor_helper(const size_type, const T&);
+        template <typename Int>
+        void assign_dispatcher(Int, Int, std::__true_type);
+        template <typename In>
+        void assign_dispatcher(In, In, std::__false_type);
+        template <typename In>
+        void assign_range(In, In, std::input_iterator_tag);
+        template <typename In>
+        void assign_range(In, In, std::forward_iterator_tag);
+        template <typename Int>
+        iterator insert_dispatcher(iterator, Int, Int, std::__true_type);
+        template <typename In>
+        iterator insert_dispatcher(iterator, In, In, std::__false_type);
+        template <typename In>
+        size_type insert_range(size_type, In, In, std::input_iterator_tag);
+        template <typename In>
+        size_type insert_range(size_type, In, In, std::forward_iterator_tag);
+        template <typename In>
+        void insert_in_place(size_type, In, In, size_type, std::false_type);
+        template <typename In>
+        void insert_in_place(size_type, In, In, size_type, std::true_type);
+        void save_elements(std::ostream &, std::false_type) const;
+        void save_elements(std::ostream &, std::true_type) const;
+        void load_elements(std::istream &, const Vector_file_header &, std::false_type);
+        void load_elements(std::istream &, const Vector_file_header &, std::true_type);
     };
 
     /**
-    \brief Copies right array into left.
+    \brief Copies right array into left element by element.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void copy(T *left_ptr, const T *right_ptr, T *end_ptr, std::false_type)
+    {
+        for (; left_ptr !=  end_ptr; ++left_ptr, ++right_ptr) {
+            *left_ptr = *right_ptr;
+        }
+    }
+
+    /**
+    \brief Copies right array into left with one memcpy, T is trivially copyable.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void copy(T *left_ptr, const T *right_ptr, T *end_ptr, std::true_type)
+    {
+        if (left_ptr != end_ptr) {
+            std::memcpy(left_ptr, right_ptr, (end_ptr - left_ptr) * sizeof(T));
+        }
+    }
+
+    /**
+    \brief Copies right array into left. Arrays must not overlap.
     \param left_ptr, right_ptr Pointers to the start of left and right arrays. 
     \param end_ptr Pointer to the end of the left array.
     */
     template <typename T>
     void copy(T *left_ptr, T *right_ptr, T *end_ptr)
     {
-        for (; left_ptr !=  end_ptr; ++left_ptr, ++right_ptr) {
-            *left_ptr = *right_ptr;
+        typedef typename std::is_trivially_copyable<T>::type Trivial;
+        SMART_ARRAY_STAT(stats::on_copy<T>(end_ptr - left_ptr));
+        tasks::copy(left_ptr, right_ptr, end_ptr, Trivial());
+    }
+
+    /**
+    \brief Destroys objects of the range [first_ptr, end_ptr) without freeing memory.
+    \param first_ptr, end_ptr Pointers to the start and end of the range.
+    */
+    template <typename T>
+    void destroy(T *first_ptr, T *end_ptr)
+    {
+        for (; first_ptr != end_ptr; ++first_ptr) {
+            first_ptr->~T();
+        }
+    }
+
+    /**
+    \brief Copy constructs right array into uninitialized left storage one by one.
+     Destroys already constructed objects if a copy throws.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void uninitialized_copy(T *left_ptr, const T *right_ptr, T *end_ptr, std::false_type)
+    {
+        T *first_ptr = left_ptr;
+
+        try {
+            for (; left_ptr != end_ptr; ++left_ptr, ++right_ptr) {
+                ::new (static_cast<void *>(left_ptr)) T(*right_ptr);
+            }
+        } catch (...) {
+            tasks::destroy(first_ptr, left_ptr);
+            throw;
         }
     }
 
     /**
-    \brief Default constructor.
-    \param w_ptr Pointer to an object. 
+    \brief Copies right array into uninitialized left storage with one memcpy,
+     T is trivially copyable.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
     */
     template <typename T>
-    Vector<T>::iterator::Iterator(const T *w_ptr) : R_a_iterator<T>(w_ptr)
+    void uninitialized_copy(T *left_ptr, const T *right_ptr, T *end_ptr, std::true_type)
     {
-        
+        tasks::copy(left_ptr, right_ptr, end_ptr, std::true_type());
     }
 
     /**
-    \brief Default constructor.
-    \param w_ptr Pointer to an object. 
+    \brief Copy constructs right array into uninitialized left storage. Arrays must not overlap.
+    \param left_ptr, right_ptr Pointers to the start of left and right arrays. 
+    \param end_ptr Pointer to the end of the left array.
     */
     template <typename T>
-    Vector<T>::reverse_iterator::Reverse_iterator(const T *w_ptr) : Reverse_r_a_iterator<T>(w_ptr)
+    void uninitialized_copy(T *left_ptr, const T *right_ptr, T *end_ptr)
     {
-        
+        typedef typename std::is_trivially_copyable<T>::type Trivial;
+        SMART_ARRAY_STAT(stats::on_copy<T>(end_ptr - left_ptr));
+        tasks::uninitialized_copy(left_ptr, right_ptr, end_ptr, Trivial());
+    }
+
+    /**
+    \brief Move constructs right array into uninitialized left storage one by one.
+     Destroys already constructed objects if a move throws.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void uninitialized_move(T *left_ptr, T *right_ptr, T *end_ptr, std::false_type)
+    {
+        T *first_ptr = left_ptr;
+
+        try {
+            for (; left_ptr != end_ptr; ++left_ptr, ++right_ptr) {
+                ::new (static_cast<void *>(left_ptr)) T(std::move(*right_ptr));
+            }
+        } catch (...) {
+            tasks::destroy(first_ptr, left_ptr);
+            throw;
+        }
+    }
+
+    /**
+    \brief Moves right array into uninitialized left storage with one memcpy,
+     T is trivially copyable.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void uninitialized_move(T *left_ptr, T *right_ptr, T *end_ptr, std::true_type)
+    {
+        tasks::copy(left_ptr, right_ptr, end_ptr, std::true_type());
+    }
+
+    /**
+    \brief Move constructs right array into uninitialized left storage. Arrays must not overlap.
+    \param left_ptr, right_ptr Pointers to the start of left and right arrays. 
+    \param end_ptr Pointer to the end of the left array.
+    */
+    template <typename T>
+    void uninitialized_move(T *left_ptr, T *right_ptr, T *end_ptr)
+    {
+        typedef typename std::is_trivially_copyable<T>::type Trivial;
+        SMART_ARRAY_STAT(stats::on_move<T>(end_ptr - left_ptr));
+        tasks::uninitialized_move(left_ptr, right_ptr, end_ptr, Trivial());
+    }
+
+    /**
+    \brief Called by uninitialized_move_if_noexcept when moving T cannot throw.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void uninitialized_relocate(T *left_ptr, T *right_ptr, T *end_ptr, std::true_type)
+    {
+        tasks::uninitialized_move(left_ptr, right_ptr, end_ptr);
+    }
+
+    /**
+    \brief Called by uninitialized_move_if_noexcept when moving T may throw,
+     copying keeps the source intact in that case.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void uninitialized_relocate(T *left_ptr, T *right_ptr, T *end_ptr, std::false_type)
+    {
+        tasks::uninitialized_copy(left_ptr, right_ptr, end_ptr);
+    }
+
+    /**
+    \brief Moves right array into uninitialized left storage if T has a
+     non-throwing (or the only available) move constructor, copies otherwise.
+    \param left_ptr, right_ptr Pointers to the start of left and right arrays. 
+    \param end_ptr Pointer to the end of the left array.
+    */
+    template <typename T>
+    void uninitialized_move_if_noexcept(T *left_ptr, T *right_ptr, T *end_ptr)
+    {
+        typedef std::integral_constant<bool, 
+            std::is_nothrow_move_constructible<T>::value 
+            || !std::is_copy_constructible<T>::value> Movable;
+        tasks::uninitialized_relocate(left_ptr, right_ptr, end_ptr, Movable());
+    }
+
+    /**
+    \brief Copy constructs given value into every slot of uninitialized storage.
+     Destroys already constructed objects if a copy throws.
+    \param first_ptr, end_ptr Pointers to the start and end of the storage.
+    \param value Value to be copied.
+    */
+    template <typename T>
+    void uninitialized_fill(T *first_ptr, T *end_ptr, const T &value)
+    {
+        T *cur_ptr = first_ptr;
+
+        SMART_ARRAY_STAT(stats::on_copy<T>(end_ptr - first_ptr));
+        try {
+            for (; cur_ptr != end_ptr; ++cur_ptr) {
+                ::new (static_cast<void *>(cur_ptr)) T(value);
+            }
+        } catch (...) {
+            tasks::destroy(first_ptr, cur_ptr);
+            throw;
+        }
+    }
+
+    /**
+    \brief Shifts [first_ptr, end_ptr) one slot to the right element by element.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void shift_right(T *first_ptr, T *end_ptr, std::false_type)
+    {
+        ::new (static_cast<void *>(end_ptr)) T(std::move(*(end_ptr - 1)));
+
+        for (--end_ptr; end_ptr != first_ptr; --end_ptr) {
+            *end_ptr = std::move(*(end_ptr - 1));
+        }
+    }
+
+    /**
+    \brief Shifts [first_ptr, end_ptr) one slot to the right with one memmove,
+     T is trivially copyable.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void shift_right(T *first_ptr, T *end_ptr, std::true_type)
+    {
+        std::memmove(first_ptr + 1, first_ptr, (end_ptr - first_ptr) * sizeof(T));
+    }
+
+    /**
+    \brief Shifts nonempty range [first_ptr, end_ptr) one slot to the right. 
+     The slot at end_ptr must be uninitialized storage, it holds an object afterwards.
+     The slot at first_ptr keeps a moved-from object to be assigned by the caller.
+    \param first_ptr, end_ptr Pointers to the start and end of the range.
+    */
+    template <typename T>
+    void shift_right(T *first_ptr, T *end_ptr)
+    {
+        typedef typename std::is_trivially_copyable<T>::type Trivial;
+        SMART_ARRAY_STAT(stats::on_move<T>(end_ptr - first_ptr));
+        tasks::shift_right(first_ptr, end_ptr, Trivial());
+    }
+
+    /**
+    \brief Shifts [first_ptr + count, end_ptr) count slots to the left element by element.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void shift_left(T *first_ptr, T *end_ptr, size_t count, std::false_type)
+    {
+        for (; first_ptr + count != end_ptr; ++first_ptr) {
+            *first_ptr = std::move(*(first_ptr + count));
+        }
+    }
+
+    /**
+    \brief Shifts [first_ptr + count, end_ptr) count slots to the left with one memmove,
+     T is trivially copyable.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T>
+    void shift_left(T *first_ptr, T *end_ptr, size_t count, std::true_type)
+    {
+        std::memmove(first_ptr, first_ptr + count, (end_ptr - first_ptr - count) * sizeof(T));
     }
 
     /**
-    \brief Conversion to a specified type.
+    \brief Shifts elements of range [first_ptr + count, end_ptr) count slots to the left, 
+     overwriting the objects from first_ptr. The last count slots keep moved-from objects 
+     to be destroyed by the caller.
+    \param first_ptr, end_ptr Pointers to the start and end of the range.
+    \param count Number of slots, not greater than the range length.
     */
     template <typename T>
-    Vector<T>::reverse_iterator::operator Vector<T>::iterator() const
+    void shift_left(T *first_ptr, T *end_ptr, size_t count)
     {
-       return Vector<T>::iterator(this->m_referee_ptr + 1);
+        typedef typename std::is_trivially_copyable<T>::type Trivial;
+        SMART_ARRAY_STAT(stats::on_move<T>(end_ptr - first_ptr - count));
+        tasks::shift_left(first_ptr, end_ptr, count, Trivial());
     }
 
+    /**
+    \brief Forward iterator repeating one value given number of times, 
+     lets the fill functions of Vector share the code of the range functions.
+    */
+    template <typename T>
+    class Repeat_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        /**
+        \brief Constructor.
+        \param value Repeated value.
+        \param count Number of repetitions left.
+        */
+        Repeat_iterator(const T &value, size_t count) : m_value_ptr(&value), m_count(count) { }
+        const T &operator*() const { return *m_value_ptr; }
+        Repeat_iterator &operator++() { --m_count; return *this; }
+        Repeat_iterator operator++(int) { Repeat_iterator temp = *this; --m_count; return temp; }
+        bool operator==(const Repeat_iterator &iter) const { return m_count == iter.m_count; }
+        bool operator!=(const Repeat_iterator &iter) const { return m_count != iter.m_count; }
+
+    private:
+        ///Pointer to the repeated value.
+        const T *m_value_ptr;
+        ///Number of repetitions left.
+        size_t m_count;
+    };
+
     /**
     \brief Constructor.
     \param size Count of elements.
     \param value Optional reference to an object to initialize all elements. 
+    \param alloc Optional allocator.
     */
-    template <typename T>
-    Vector<T>::Vector(const size_type size, const T &value)
+    template <typename T, typename Allocator, typename Growth>
+    Vector<T, Allocator, Growth>::Vector(const size_type size, const T &value, const Allocator &alloc)
+        : v_alloc(alloc)
     {
         constructor_helper(size, value);
     }
@@ -171,35 +518,86 @@ namespace tasks {
     \param size Count of elements.
     \param value Optional reference to an object to initialize all elements. 
     */
-    template <typename T>
-    void Vector<T>::constructor_helper(const size_type size, const T &value)
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::constructor_helper(const size_type size, const T &value)
     {
-        v_size = size; 
-        v_front_ptr = service_dynamic(re_capacity()); 
-
-        for (size_type i = 0; i < v_size; ++i) {
-       	    v_front_ptr[i] = value; 
+        v_size = 0;
+        v_capacity = size;
+        v_front_ptr = service_dynamic(v_capacity); 
+
+        try {
+            tasks::uninitialized_fill(v_front_ptr, v_front_ptr + size, value);
+        } catch (...) {
+            service_free(v_front_ptr, v_capacity);
+            throw;
         }
+        v_size = size;
     }
 
     /**
     \brief Copy constructor.
     \param vec Reference to a Vector object. 
     */
-    template <typename T>
-    Vector<T>::Vector(const Vector<T> &vec)
+    template <typename T, typename Allocator, typename Growth>
+    Vector<T, Allocator, Growth>::Vector(const Vector<T, Allocator, Growth> &vec)
+        : v_size(0), v_capacity(0), v_front_ptr(0), 
+          v_alloc(alloc_traits::select_on_container_copy_construction(vec.v_alloc))
+    { 
+        v_capacity = vec.v_size;
+        v_front_ptr = service_dynamic(v_capacity); 
+
+        try {
+            tasks::uninitialized_copy(v_front_ptr, vec.v_front_ptr, v_front_ptr + vec.v_size); 
+        } catch (...) {
+            service_free(v_front_ptr, v_capacity);
+            throw;
+        }
+        v_size = vec.v_size;
+    }
+
+    /**
+    \brief Copy constructor using given allocator.
+    \param vec Reference to a Vector object. 
+    \param alloc Allocator of the new vector.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    Vector<T, Allocator, Growth>::Vector(const Vector<T, Allocator, Growth> &vec, const Allocator &alloc)
+        : v_size(0), v_capacity(0), v_front_ptr(0), v_alloc(alloc)
+    { 
+        v_capacity = vec.v_size;
+        v_front_ptr = service_dynamic(v_capacity); 
+
+        try {
+            tasks::uninitialized_copy(v_front_ptr, vec.v_front_ptr, v_front_ptr + vec.v_size); 
+        } catch (...) {
+            service_free(v_front_ptr, v_capacity);
+            throw;
+        }
+        v_size = vec.v_size;
+    }
+
+    /**
+    \brief Move constructor. Takes over the buffer of given vector, leaving it empty.
+    \param vec Rvalue reference to a Vector object. 
+    */
+    template <typename T, typename Allocator, typename Growth>
+    Vector<T, Allocator, Growth>::Vector(Vector<T, Allocator, Growth> &&vec) noexcept
+        : v_size(vec.v_size), v_capacity(vec.v_capacity), v_front_ptr(vec.v_front_ptr),
+          v_alloc(std::move(vec.v_alloc))
     { 
-        v_size = vec.v_size; 
-        v_front_ptr = service_dynamic(re_capacity()); 
-        copy(v_front_ptr, vec.v_front_ptr, v_front_ptr + v_size); 
+        vec.v_size = 0;
+        vec.v_capacity = 0;
+        vec.v_front_ptr = 0;
     }
 
     /**
     \brief Constructor.
     \param it_begin, it_end Iterators to the start and end of the sequence to initialize. 
+    \param alloc Optional allocator.
     */
-    template <typename T> template <typename In>
-    Vector<T>::Vector(In it_begin, In it_end)
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    Vector<T, Allocator, Growth>::Vector(In it_begin, In it_end, const Allocator &alloc)
+        : v_alloc(alloc)
     {
             typedef typename std::__is_integer<In>::__type Integral;
             initialize_dispatcher(it_begin, it_end, Integral());
@@ -212,8 +610,8 @@ namespace tasks {
     \param std::__true_type is a struct that is used to decide 
      which overloaded function will be called
     */
-    template <typename T> template <typename Int>
-    void Vector<T>::initialize_dispatcher(Int size, Int value, std::__true_type)
+    template <typename T, typename Allocator, typename Growth> template <typename Int>
+    void Vector<T, Allocator, Growth>::initialize_dispatcher(Int size, Int value, std::__true_type)
     {
         constructor_helper(static_cast<size_type>(size), value);
     }
@@ -224,8 +622,8 @@ namespace tasks {
     \param std::__false_type is a struct that is used to decide 
      which overloaded function will be called
     */
-    template <typename T> template <typename In>
-    void Vector<T>::initialize_dispatcher(In begin, In end, std::__false_type)
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::initialize_dispatcher(In begin, In end, std::__false_type)
     {
        typedef typename std::iterator_traits<In>::iterator_category category;
        range_constructor_helper(begin, end, category());
@@ -236,68 +634,136 @@ namespace tasks {
     \param it_begin, it_end Iterators to the start and end of the sequence to initialize. 
     \param std::input_iterator_tag.
     */
-    template <typename T> template <typename In>
-    void Vector<T>::range_constructor_helper(In begin, In end, std::input_iterator_tag)
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::range_constructor_helper(In begin, In end, std::input_iterator_tag)
     {
         size_type size = std::distance(begin, end);
 
+        v_size = 0;
         if (size > 0) {
-            v_size = size;
-            v_front_ptr = service_dynamic(re_capacity());
+            v_capacity = size;
+            v_front_ptr = service_dynamic(v_capacity);
 
-            for (int i = 0; begin != end; ++begin, ++i) {
-                v_front_ptr[i] = *begin;
+            try {
+                for (; begin != end; ++begin, ++v_size) {
+                    ::new (static_cast<void *>(v_front_ptr + v_size)) T(*begin);
+                }
+            } catch (...) {
+                tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+                service_free(v_front_ptr, v_capacity);
+                throw;
             }
         } else {
-            v_size = 0;
             v_capacity = 0;
             v_front_ptr = 0;
         }
     }
 
     ///Destructor.
-    template <typename T>
-    Vector<T>::~Vector(void)
+    template <typename T, typename Allocator, typename Growth>
+    Vector<T, Allocator, Growth>::~Vector(void)
     {
-	    delete[] v_front_ptr; 
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        service_free(v_front_ptr, v_capacity);
     }
 
     /**
     \brief Assigns given vector to the Vector object.
+     The allocator is taken from given vector only if it propagates on copy assignment.
     \param right Given vector.
     \return Changed Vector object.
     */
-    template <typename T>
-    const Vector<T> &Vector<T>::operator=(const Vector<T> &right)
+    template <typename T, typename Allocator, typename Growth>
+    const Vector<T, Allocator, Growth> &Vector<T, Allocator, Growth>::operator=(const Vector<T, Allocator, Growth> &right)
+    {
+        if(this != &right){ 
+            Vector<T, Allocator, Growth> temp(right, 
+                alloc_traits::propagate_on_container_copy_assignment::value ? right.v_alloc : v_alloc);
+            take_storage(temp);
+        } 
+        return *this; 
+    }
+
+    /**
+    \brief Move assigns given vector to the Vector object. 
+     Previous elements are destroyed, given vector is left empty. The buffer is
+     taken over unless allocators differ and do not propagate, then elements are moved one by one.
+    \param right Given vector.
+    \return Changed Vector object.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    const Vector<T, Allocator, Growth> &Vector<T, Allocator, Growth>::operator=(Vector<T, Allocator, Growth> &&right)
+        noexcept(alloc_traits::propagate_on_container_move_assignment::value
+                 || alloc_traits::is_always_equal::value)
     {
         if(this != &right){ 
-            v_size = right.v_size; 
-            v_front_ptr = service_dynamic(re_capacity()); 
-            copy(v_front_ptr, right.v_front_ptr, v_front_ptr + v_size); 
+            if (alloc_traits::propagate_on_container_move_assignment::value 
+                || alloc_traits::is_always_equal::value || v_alloc == right.v_alloc) {
+                Vector<T, Allocator, Growth> temp(std::move(right));
+
+                if (!alloc_traits::propagate_on_container_move_assignment::value) {
+                    temp.v_alloc = v_alloc;
+                }
+                take_storage(temp);
+            } else {
+                Vector<T, Allocator, Growth> temp(std::make_move_iterator(right.v_front_ptr), 
+                                          std::make_move_iterator(right.v_front_ptr + right.v_size), 
+                                          v_alloc);
+                take_storage(temp);
+                right.clear();
+            }
         } 
         return *this; 
     }
 
+    /**
+    \brief Constructor evaluating an element-wise expression of vector_expr.hpp in one pass.
+     The expression assigns the elements into the new storage without constructing them,
+     which is valid for trivially copyable elements only.
+    \param expr Expression, its size becomes the size of the vector.
+    \param alloc Optional allocator.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename Expr, typename>
+    Vector<T, Allocator, Growth>::Vector(const Expr &expr, const Allocator &alloc)
+        : v_size(0), v_capacity(expr.size()), v_front_ptr(0), v_alloc(alloc)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Expressions are evaluated into uninitialized storage, elements must be trivially copyable.");
+        v_front_ptr = service_dynamic(v_capacity);
+        expr.evaluate(v_front_ptr);
+        v_size = v_capacity;
+    }
+
+    /**
+    \brief Assigns an element-wise expression of vector_expr.hpp. Elements are overwritten
+     in place when the size is unchanged, so the expression may refer to this vector.
+    \param expr Expression.
+    \return Changed Vector object.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename Expr, typename>
+    const Vector<T, Allocator, Growth> &Vector<T, Allocator, Growth>::operator=(const Expr &expr)
+    {
+        if (expr.size() == v_size) {
+            expr.evaluate(v_front_ptr);
+        } else {
+            Vector<T, Allocator, Growth> temp(expr, v_alloc);
+            take_storage(temp);
+        }
+        return *this;
+    }
+
     /**
     \brief Compare equality of two vectors.
     \param right Vector to compare with.
     \return true if equal, false if not.
     */
-    template <typename T>
-    bool Vector<T>::operator==(const Vector<T> &right) const
+    template <typename T, typename Allocator, typename Growth>
+    bool Vector<T, Allocator, Growth>::operator==(const Vector<T, Allocator, Growth> &right) const
     {
         if (v_size != right.v_size) {
        	    return false; 
-        } else {
-
-        	for (size_type i = 0; i <= v_size; ++i) {
-
-        		if (v_front_ptr[i] != right.v_front_ptr[i]) {
-        			return false; 
-                }
-            }
         }
-        return true; 
+        return simd::equal(v_front_ptr, right.v_front_ptr, v_size); 
     }
 
     /**
@@ -305,8 +771,8 @@ namespace tasks {
     \param iter Vector object to compare with.
     \return true if non equal, false if equal;
     */
-    template <typename T>
-    bool Vector<T>::operator!=(const Vector<T> & vec) const
+    template <typename T, typename Allocator, typename Growth>
+    bool Vector<T, Allocator, Growth>::operator!=(const Vector<T, Allocator, Growth> & vec) const
     {
         return !(*this == vec);
     }
@@ -316,8 +782,8 @@ namespace tasks {
     \param i Index. 
     \return Reference to an object at given index.
     */
-    template <typename T>
-    T &Vector<T>::operator[](const size_type i)
+    template <typename T, typename Allocator, typename Growth>
+    T &Vector<T, Allocator, Growth>::operator[](const size_type i)
     {
         return *(v_front_ptr + i);
     }
@@ -327,8 +793,8 @@ namespace tasks {
     \param i Index. 
     \return Const reference to an object at given index.
     */
-    template <typename T>
-    const T &Vector<T>::operator[](const size_type i) const
+    template <typename T, typename Allocator, typename Growth>
+    const T &Vector<T, Allocator, Growth>::operator[](const size_type i) const
     {
         return *(v_front_ptr + i);
     }
@@ -338,8 +804,8 @@ namespace tasks {
     \param i Index.
     \return Reference to the element.
     */
-    template <typename T>
-    T &Vector<T>::at(size_type i)
+    template <typename T, typename Allocator, typename Growth>
+    T &Vector<T, Allocator, Growth>::at(size_type i)
     {
         if (i >= 0 && i < v_size) {
        	    return *(v_front_ptr + i); 
@@ -354,8 +820,8 @@ namespace tasks {
     \param i Index.
     \return Const reference to the element.
     */
-    template <typename T>
-    const T &Vector<T>::at(size_type i) const
+    template <typename T, typename Allocator, typename Growth>
+    const T &Vector<T, Allocator, Growth>::at(size_type i) const
     {
         if (i >= 0 && i < v_size) {
        	    return *(v_front_ptr + i); 
@@ -369,34 +835,68 @@ namespace tasks {
     \brief Adding element to the end of the vector. Reallocating if neccessary.
     \param value Element to be added.
     */
-    template <typename T>
-    void Vector<T>::push_back(const T &value)
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::push_back(const T &value)
+    {
+        emplace_back(value);
+    }
+
+    /**
+    \brief Adding element to the end of the vector by moving it. Reallocating if neccessary.
+    \param value Element to be moved.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::push_back(T &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    /**
+    \brief Constructs element in place at the end of the vector. Reallocating if neccessary.
+     Arguments may refer to elements of the vector.
+    \param args Arguments forwarded to the constructor of T.
+    \return Reference to the constructed element.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename... Args>
+    T &Vector<T, Allocator, Growth>::emplace_back(Args &&... args)
     {
         if (v_size < v_capacity) { 
-       	    v_front_ptr[v_size] = value; 
+            ::new (static_cast<void *>(v_front_ptr + v_size)) T(std::forward<Args>(args)...);
             ++v_size; 
         } else { 
-
-       	    if (empty()) { 
-                 v_size = 1;
-        	     v_front_ptr = service_dynamic(re_capacity()); 
-        	     v_front_ptr[v_size - 1] = value; 
-            } else { 
-                T *temp_ptr = v_front_ptr; 
-                v_front_ptr = service_dynamic(re_capacity()); 
-                copy(v_front_ptr, temp_ptr, v_front_ptr + v_size); 
-                v_front_ptr[v_size] = value; 
-                ++v_size; 
-                delete[] temp_ptr; 
-        	} 
+            size_type new_cap = re_capacity(v_size + 1);
+            T *temp_ptr = service_dynamic(new_cap); 
+
+            try {
+                ::new (static_cast<void *>(temp_ptr + v_size)) T(std::forward<Args>(args)...);
+            } catch (...) {
+                service_free(temp_ptr, new_cap);
+                throw;
+            }
+            try {
+                tasks::uninitialized_move_if_noexcept(temp_ptr, v_front_ptr, temp_ptr + v_size); 
+            } catch (...) {
+                temp_ptr[v_size].~T();
+                service_free(temp_ptr, new_cap);
+                throw;
+            }
+            tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+            service_free(v_front_ptr, v_capacity);
+            v_front_ptr = temp_ptr;
+            v_capacity = new_cap;
+            ++v_size; 
         } 
+        return v_front_ptr[v_size - 1];
     }
 
     ///Popping the last element of Vector.
-    template <typename T>
-    void Vector<T>::pop_back()
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::pop_back()
     {
-        if (v_size) --v_size;
+        if (v_size) {
+            --v_size;
+            v_front_ptr[v_size].~T();
+        }
     }
         
     /**
@@ -405,35 +905,292 @@ namespace tasks {
     \param value Value to be inserted.
     \return Iterator to the inserted element if inserted, to the end otherwise.
     */
-    template <typename T>
-    typename Vector<T>::iterator Vector<T>::insert(iterator pos, const T &value)
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator Vector<T, Allocator, Growth>::insert(iterator pos, const T &value)
     {
-        if (pos == end()) {
-            push_back(value);
-            return Vector<T>::iterator(v_front_ptr + v_size - 1);
-        }
-        if (end() < pos || pos < begin()) {
-            return end();
-        }
-        if (v_size < v_capacity) {
-            size_type index = pos - begin();
-            T *temp_ptr = service_dynamic(v_capacity - index);
-            copy(temp_ptr, v_front_ptr + index, temp_ptr + v_size - index);
-            v_front_ptr[index] = value;
-            ++v_size;
-            copy(v_front_ptr + index + 1, temp_ptr, v_front_ptr + v_size);
-            delete[] temp_ptr;
-            return Vector<T>::iterator(v_front_ptr + index);
-        }
-        size_type index = pos - begin();
-        T *temp_ptr = v_front_ptr;
+        return emplace(pos, value);
+    }
+
+    /**
+    \brief Inserts element to given position by moving it. Does nothing if position is out of range.
+    \param pos Position.
+    \param value Value to be moved.
+    \return Iterator to the inserted element if inserted, to the end otherwise.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator Vector<T, Allocator, Growth>::insert(iterator pos, T &&value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    /**
+    \brief Constructs element in place at given position. Does nothing if position is out of range.
+    \param pos Position.
+    \param args Arguments forwarded to the constructor of T.
+    \return Iterator to the inserted element if inserted, to the end otherwise.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename... Args>
+    typename Vector<T, Allocator, Growth>::iterator Vector<T, Allocator, Growth>::emplace(iterator pos, Args &&... args)
+    {
+        if (pos == end()) {
+            emplace_back(std::forward<Args>(args)...);
+            return Vector<T, Allocator, Growth>::iterator(v_front_ptr + v_size - 1);
+        }
+        if (end() < pos || pos < begin()) {
+            return end();
+        }
+        size_type index = pos - begin();
+
+        if (v_size < v_capacity) {
+            T value(std::forward<Args>(args)...);
+            tasks::shift_right(v_front_ptr + index, v_front_ptr + v_size);
+            ++v_size;
+            v_front_ptr[index] = std::move(value);
+            return Vector<T, Allocator, Growth>::iterator(v_front_ptr + index);
+        }
+        size_type new_cap = re_capacity(v_size + 1);
+        T *temp_ptr = service_dynamic(new_cap);
+        size_type constructed = 0;
+
+        try {
+            ::new (static_cast<void *>(temp_ptr + index)) T(std::forward<Args>(args)...);
+            ++constructed;
+            tasks::uninitialized_move_if_noexcept(temp_ptr, v_front_ptr, temp_ptr + index);
+            constructed += index;
+            tasks::uninitialized_move_if_noexcept(temp_ptr + index + 1, v_front_ptr + index, 
+                                           temp_ptr + v_size + 1);
+        } catch (...) {
+            if (constructed > 0) {
+                temp_ptr[index].~T();
+            }
+            if (constructed > 1) {
+                tasks::destroy(temp_ptr, temp_ptr + index);
+            }
+            service_free(temp_ptr, new_cap);
+            throw;
+        }
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        service_free(v_front_ptr, v_capacity);
+        v_front_ptr = temp_ptr;
+        v_capacity = new_cap;
         ++v_size;
-        v_front_ptr = service_dynamic(re_capacity());
-        copy(v_front_ptr, temp_ptr, v_front_ptr + index);
-        v_front_ptr[index] = value;
-        copy(v_front_ptr + index + 1, temp_ptr + index, v_front_ptr + v_size);
-        delete[] temp_ptr;
-        return Vector<T>::iterator(v_front_ptr + index);
+        return Vector<T, Allocator, Growth>::iterator(v_front_ptr + index);
+    }
+
+    /**
+    \brief Inserts count copies of value before given position. Does nothing if position is out of range.
+     Reallocates at most once.
+    \param pos Position.
+    \param count Number of copies.
+    \param value Value to be inserted, may refer to an element of the vector.
+    \return Iterator to the first inserted element, pos if count is 0, end if position is out of range.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator 
+    Vector<T, Allocator, Growth>::insert(iterator pos, const size_type count, const T &value)
+    {
+        if (end() < pos || pos < begin()) {
+            return end();
+        }
+        size_type index = pos - begin();
+        T value_copy(value);
+        insert_range(index, Repeat_iterator<T>(value_copy, count), 
+                     Repeat_iterator<T>(value_copy, 0), std::forward_iterator_tag());
+        return iterator(v_front_ptr + index);
+    }
+
+    /**
+    \brief Inserts elements of the range [first, last) before given position. 
+     Does nothing if position is out of range. Reallocates at most once and shifts 
+     the tail once for forward iterators. The range must not refer to the vector.
+    \param pos Position.
+    \param first, last Iterators to the start and end of the range.
+    \return Iterator to the first inserted element, pos if the range is empty, 
+     end if position is out of range.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    typename Vector<T, Allocator, Growth>::iterator 
+    Vector<T, Allocator, Growth>::insert(iterator pos, In first, In last)
+    {
+        typedef typename std::__is_integer<In>::__type Integral;
+        return insert_dispatcher(pos, first, last, Integral());
+    }
+
+    /**
+    \brief Overloaded function called by range insert for integral arguments, 
+     which mean count and value.
+    \param std::__true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename Int>
+    typename Vector<T, Allocator, Growth>::iterator 
+    Vector<T, Allocator, Growth>::insert_dispatcher(iterator pos, Int count, Int value, std::__true_type)
+    {
+        return insert(pos, static_cast<size_type>(count), static_cast<T>(value));
+    }
+
+    /**
+    \brief Overloaded function called by range insert for iterators.
+    \param std::__false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    typename Vector<T, Allocator, Growth>::iterator 
+    Vector<T, Allocator, Growth>::insert_dispatcher(iterator pos, In first, In last, std::__false_type)
+    {
+        if (end() < pos || pos < begin()) {
+            return end();
+        }
+        typedef typename std::iterator_traits<In>::iterator_category category;
+        size_type index = pos - begin();
+        insert_range(index, first, last, category());
+        return iterator(v_front_ptr + index);
+    }
+
+    /**
+    \brief Appends elements of the range [first, last) to the end. 
+     Reallocates at most once for forward iterators. The range must not refer to the vector.
+    \param first, last Iterators to the start and end of the range.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::append(In first, In last)
+    {
+        typedef typename std::iterator_traits<In>::iterator_category category;
+        insert_range(v_size, first, last, category());
+    }
+
+    /**
+    \brief Inserts range of single pass iterators. Elements are appended one by one 
+     and rotated into place.
+    \param index Position of the first inserted element.
+    \param first, last Iterators to the start and end of the range.
+    \param std::input_iterator_tag.
+    \return Number of inserted elements.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    typename Vector<T, Allocator, Growth>::size_type 
+    Vector<T, Allocator, Growth>::insert_range(size_type index, In first, In last, 
+                                                std::input_iterator_tag)
+    {
+        size_type old_size = v_size;
+
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(v_front_ptr + index, v_front_ptr + old_size, v_front_ptr + v_size);
+        return v_size - old_size;
+    }
+
+    /**
+    \brief Inserts range of forward iterators with at most one reallocation.
+    \param index Position of the first inserted element.
+    \param first, last Iterators to the start and end of the range.
+    \param std::forward_iterator_tag.
+    \return Number of inserted elements.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    typename Vector<T, Allocator, Growth>::size_type 
+    Vector<T, Allocator, Growth>::insert_range(size_type index, In first, In last, 
+                                                std::forward_iterator_tag)
+    {
+        size_type count = std::distance(first, last);
+
+        if (0 == count) {
+            return 0;
+        }
+        if (count > max_size() - v_size) {
+            throw std::length_error("Size cannot be greater than maximum size.");
+        }
+        if (v_size + count <= v_capacity) {
+            typedef typename std::is_trivially_copyable<T>::type Trivial;
+            insert_in_place(index, first, last, count, Trivial());
+            return count;
+        }
+        size_type new_cap = re_capacity(v_size + count);
+        T *temp_ptr = service_dynamic(new_cap);
+        T *cur_ptr = temp_ptr + index;
+
+        try {
+            for (; first != last; ++first, ++cur_ptr) {
+                ::new (static_cast<void *>(cur_ptr)) T(*first);
+            }
+        } catch (...) {
+            tasks::destroy(temp_ptr + index, cur_ptr);
+            service_free(temp_ptr, new_cap);
+            throw;
+        }
+        try {
+            tasks::uninitialized_move_if_noexcept(temp_ptr, v_front_ptr, temp_ptr + index);
+        } catch (...) {
+            tasks::destroy(temp_ptr + index, cur_ptr);
+            service_free(temp_ptr, new_cap);
+            throw;
+        }
+        try {
+            tasks::uninitialized_move_if_noexcept(cur_ptr, v_front_ptr + index, 
+                                                  temp_ptr + v_size + count);
+        } catch (...) {
+            tasks::destroy(temp_ptr, cur_ptr);
+            service_free(temp_ptr, new_cap);
+            throw;
+        }
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        service_free(v_front_ptr, v_capacity);
+        v_front_ptr = temp_ptr;
+        v_capacity = new_cap;
+        v_size += count;
+        return count;
+    }
+
+    /**
+    \brief Inserts count elements of forward range into spare capacity element by element.
+     The vector stays valid if a constructor or assignment throws.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::insert_in_place(size_type index, In first, In last, 
+                                                        size_type count, std::false_type)
+    {
+        T *pos_ptr = v_front_ptr + index;
+        T *old_end_ptr = v_front_ptr + v_size;
+        size_type tail = v_size - index;
+
+        if (tail > count) {
+            tasks::uninitialized_move(old_end_ptr, old_end_ptr - count, old_end_ptr + count);
+            v_size += count;
+            std::move_backward(pos_ptr, old_end_ptr - count, old_end_ptr);
+            std::copy(first, last, pos_ptr);
+        } else {
+            In mid = first;
+            std::advance(mid, tail);
+
+            for (In it = mid; it != last; ++it, ++v_size) {
+                ::new (static_cast<void *>(v_front_ptr + v_size)) T(*it);
+            }
+            tasks::uninitialized_move(v_front_ptr + v_size, pos_ptr, v_front_ptr + v_size + tail);
+            v_size += tail;
+            std::copy(first, mid, pos_ptr);
+        }
+    }
+
+    /**
+    \brief Inserts count elements of forward range into spare capacity, 
+     T is trivially copyable so the tail is shifted with one memmove.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::insert_in_place(size_type index, In first, In last, 
+                                                        size_type count, std::true_type)
+    {
+        T *pos_ptr = v_front_ptr + index;
+
+        std::memmove(pos_ptr + count, pos_ptr, (v_size - index) * sizeof(T));
+        v_size += count;
+        for (; first != last; ++first, ++pos_ptr) {
+            ::new (static_cast<void *>(pos_ptr)) T(*first);
+        }
     }
 
     /**
@@ -441,125 +1198,176 @@ namespace tasks {
     \param pos Position.
     \return Iterator to the next element of removed element, to the end if not removed.
     */
-    template <typename T>
-    typename Vector<T>::iterator Vector<T>::erase(iterator pos)
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator Vector<T, Allocator, Growth>::erase(iterator pos)
     {
         
         if (end() < pos || pos == end() || pos < begin()) {
             return end();
         }
         if (end() == pos + 1) {
-            --v_size;
+            pop_back();
             return end();
         }
-        for (Vector<T>::iterator it = pos; it != end(); ++it) {
-            *it = *(it + 1);
-        }
-        --v_size;
+        tasks::shift_left(&*pos, v_front_ptr + v_size, 1);
+        pop_back();
         return pos;
     }
 
+    /**
+    \brief Removes elements of the range [first, last) with one shift of the tail.
+     Does nothing if the range is out of the vector.
+    \param first, last Iterators to the start and end of the range.
+    \return Iterator to the element following the removed ones, end if nothing is removed.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator 
+    Vector<T, Allocator, Growth>::erase(iterator first, iterator last)
+    {
+        if (first < begin() || end() < last || last < first) {
+            return end();
+        }
+        size_type count = last - first;
+
+        if (0 == count) {
+            return first;
+        }
+        T *end_ptr = v_front_ptr + v_size;
+        tasks::shift_left(&*first, end_ptr, count);
+        tasks::destroy(end_ptr - count, end_ptr);
+        v_size -= count;
+        return first;
+    }
+
     ///Returns reference of the first element.
-    template <typename T>
-    T &Vector<T>::front()
+    template <typename T, typename Allocator, typename Growth>
+    T &Vector<T, Allocator, Growth>::front()
     {
         return *v_front_ptr;
     }
 
     ///Returns reference of the last element.
-    template <typename T>
-    T &Vector<T>::back()
+    template <typename T, typename Allocator, typename Growth>
+    T &Vector<T, Allocator, Growth>::back()
     {
         return *(v_front_ptr + v_size - 1);
     }
 
     ///Returns const reference of the first element.
-    template <typename T>
-    const T &Vector<T>::front() const
+    template <typename T, typename Allocator, typename Growth>
+    const T &Vector<T, Allocator, Growth>::front() const
     {
         return *v_front_ptr;
     }
 
     ///Returns const reference of the last element.
-    template <typename T>
-    const T &Vector<T>::back() const
+    template <typename T, typename Allocator, typename Growth>
+    const T &Vector<T, Allocator, Growth>::back() const
     {
         return *(v_front_ptr + v_size - 1);
     }
 
     ///Returns iterator to the first element.
-    template <typename T>
-    typename Vector<T>::iterator Vector<T>::begin()
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator Vector<T, Allocator, Growth>::begin()
     {
         return iterator(v_front_ptr);
     }
 
     ///Returns iterator to end of Vector.
-    template <typename T>
-    typename Vector<T>::iterator Vector<T>::end()
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator Vector<T, Allocator, Growth>::end()
     {
         return iterator(v_front_ptr + v_size);
     }
 
     ///Returns const iterator to the first element.
-    template <typename T>
-    typename Vector<T>::const_iterator Vector<T>::begin() const
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::const_iterator Vector<T, Allocator, Growth>::begin() const
     {
         return const_iterator(v_front_ptr);
     }
 
     ///Returns const iterator to end of Vector.
-    template <typename T>
-    typename Vector<T>::const_iterator Vector<T>::end() const
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::const_iterator Vector<T, Allocator, Growth>::end() const
     {
         return const_iterator(v_front_ptr + v_size);
     }
 
+    ///Returns pointer to the first element, null if no storage is allocated.
+    template <typename T, typename Allocator, typename Growth>
+    T *Vector<T, Allocator, Growth>::data()
+    {
+        return v_front_ptr;
+    }
+
+    ///Returns const pointer to the first element, null if no storage is allocated.
+    template <typename T, typename Allocator, typename Growth>
+    const T *Vector<T, Allocator, Growth>::data() const
+    {
+        return v_front_ptr;
+    }
+
+    ///Returns view of the elements for algorithms and kernels working on raw pointers.
+    template <typename T, typename Allocator, typename Growth>
+    Span<T> Vector<T, Allocator, Growth>::span()
+    {
+        return Span<T>(v_front_ptr, v_size);
+    }
+
+    ///Returns read-only view of the elements.
+    template <typename T, typename Allocator, typename Growth>
+    Span<const T> Vector<T, Allocator, Growth>::span() const
+    {
+        return Span<const T>(v_front_ptr, v_size);
+    }
+
     ///Returns reverse iterator to the first element.
-    template <typename T>
-    typename Vector<T>::reverse_iterator Vector<T>::rbegin()
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::reverse_iterator Vector<T, Allocator, Growth>::rbegin()
     {
         return reverse_iterator(v_front_ptr + v_size);
     }
 
     ///Returns reverse iterator to end of Vector.
-    template <typename T>
-    typename Vector<T>::reverse_iterator Vector<T>::rend()
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::reverse_iterator Vector<T, Allocator, Growth>::rend()
     {
         return reverse_iterator(v_front_ptr);
     }
 
     ///Returns const reverse iterator to the first element.
-    template <typename T>
-    typename Vector<T>::const_reverse_iterator Vector<T>::rbegin() const
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::const_reverse_iterator Vector<T, Allocator, Growth>::rbegin() const
     {
         return const_reverse_iterator(v_front_ptr + v_size);
     }
 
     ///Returns const reverse iterator to end of Vector.
-    template <typename T>
-    typename Vector<T>::const_reverse_iterator Vector<T>::rend() const
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::const_reverse_iterator Vector<T, Allocator, Growth>::rend() const
     {
         return const_reverse_iterator(v_front_ptr);
     }
 
     ///Checks if Vector object has no elements.
-    template <typename T>
-    bool Vector<T>::empty() const
+    template <typename T, typename Allocator, typename Growth>
+    bool Vector<T, Allocator, Growth>::empty() const
     {
         return 0 == v_size;
     }
 
     ///Returns the capacity of Vector object.
-    template <typename T>
-    typename Vector<T>::size_type Vector<T>::capacity() const
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::size_type Vector<T, Allocator, Growth>::capacity() const
     {
         return v_capacity;
     }
 
     ///Returns the size of Vector object.
-    template <typename T>
-    typename Vector<T>::size_type Vector<T>::size() const
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::size_type Vector<T, Allocator, Growth>::size() const
     {
         return v_size;
     }
@@ -569,18 +1377,14 @@ namespace tasks {
            Throws length_error if value is greater than maximum size.
     \param new_cap Capacity.
     */
-    template <typename T>
-    void Vector<T>::reserve(size_type new_cap)
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::reserve(size_type new_cap)
     {
         if (new_cap > max_size()) {
             throw std::length_error("Capacity cannot be greater than maximum size.");
         }
         if (new_cap > v_capacity) { 
-            v_capacity = new_cap; 
-            T *temp_ptr = v_front_ptr; 
-       	    v_front_ptr = service_dynamic(v_capacity); 
-            copy(v_front_ptr, temp_ptr, v_front_ptr + v_size); 
-           	delete [] temp_ptr; 
+            reallocate(new_cap);
         } 
     }
 
@@ -589,55 +1393,134 @@ namespace tasks {
     \param new_size Number of elements.
     \param value Value of appended elements if new_size is greater than the size.
     */
-    template <typename T>
-    void Vector<T>::resize(const size_type new_size, const T &value)
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::resize(const size_type new_size, const T &value)
     {
-	size_type old_size = v_size;
-	v_size = new_size;	
-
-        if (v_size <= old_size) {
+        if (new_size <= v_size) {
+            tasks::destroy(v_front_ptr + new_size, v_front_ptr + v_size);
+            v_size = new_size;
             return;
+        }
+        if (new_size > v_capacity) {
+            T value_copy(value);
+            reallocate(re_capacity(new_size));
+            tasks::uninitialized_fill(v_front_ptr + v_size, v_front_ptr + new_size, value_copy);
         } else {
-
-            if (v_size > v_capacity) {
-                T *temp_ptr = v_front_ptr;
-                v_front_ptr = service_dynamic(re_capacity()); 
-                copy(v_front_ptr, temp_ptr, v_front_ptr + old_size); 
-           	    delete [] temp_ptr; 
-            } 
-            for (size_type i = old_size; i < v_size; ++i) {
-       	        v_front_ptr[i] = value; 
-            }
+            tasks::uninitialized_fill(v_front_ptr + v_size, v_front_ptr + new_size, value);
         }
+        v_size = new_size;
     }
 
     /**
     \brief Swaps the contents of two vectors.
     \param other Vector to make swap with.
     */
-    template <typename T>
-    void Vector<T>::swap(Vector<T> &other)
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::swap(Vector<T, Allocator, Growth> &other) noexcept
     {
         T *temp_ptr = v_front_ptr;
 	size_type temp_size = v_size;
+	size_type temp_cap = v_capacity;
         v_front_ptr = other.v_front_ptr;
 	v_size = other.v_size;
+	v_capacity = other.v_capacity;
         other.v_front_ptr = temp_ptr;
 	other.v_size = temp_size;
+	other.v_capacity = temp_cap;
+
+        if (alloc_traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(v_alloc, other.v_alloc);
+        }
     }
 
-    ///Removed all elements.
-    template <typename T>
-    void Vector<T>::clear()
+    ///Removes all elements, keeps the capacity.
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::clear()
     {
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
         v_size = 0;
     }
 
     ///Returns the maximum allowed size of Vector.
-    template <typename T>
-    typename Vector<T>::size_type Vector<T>::max_size() const
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::size_type Vector<T, Allocator, Growth>::max_size() const
+    {
+        return alloc_traits::max_size(v_alloc);
+    }
+
+    ///Returns copy of the allocator.
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::allocator_type Vector<T, Allocator, Growth>::get_allocator() const
+    {
+        return v_alloc;
+    }
+
+    /**
+    \brief Writes the vector in the binary format of vector_io.hpp. Trivially copyable
+     elements are written with one bulk write, other types through Codec<T>.
+     Throws std::runtime_error if writing fails.
+    \param out Output stream opened in binary mode.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::save(std::ostream &out) const
+    {
+        typedef typename std::is_trivially_copyable<T>::type Trivial;
+        save_elements(out, Trivial());
+        if (!out) {
+            throw std::runtime_error("Writing Vector failed.");
+        }
+    }
+
+    /**
+    \brief Writes the vector to a file, replacing its contents.
+    \param path Path to the file.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::save(const std::string &path) const
     {
-        return std::numeric_limits<size_type>::max() / sizeof(T);
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+
+        if (!out) {
+            throw std::runtime_error("Can not open file " + path);
+        }
+        save(out);
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Writing Vector failed: " + path);
+        }
+    }
+
+    /**
+    \brief Replaces the contents with a vector written by save. Trivially copyable
+     elements are read with one bulk read into exactly sized storage.
+     Throws std::runtime_error if the data is not a vector of T, is truncated or
+     the checksum does not match, the vector is unchanged in that case.
+    \param in Input stream opened in binary mode.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::load(std::istream &in)
+    {
+        typedef typename std::is_trivially_copyable<T>::type Trivial;
+        Vector_file_header header;
+
+        header.read(in, sizeof(T), !Trivial::value);
+        load_elements(in, header, Trivial());
+    }
+
+    /**
+    \brief Replaces the contents with a vector saved to a file.
+    \param path Path to the file.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::load(const std::string &path)
+    {
+        std::ifstream in(path.c_str(), std::ios::binary);
+
+        if (!in) {
+            throw std::runtime_error("Can not open file " + path);
+        }
+        load(in);
     }
 
     /**
@@ -645,33 +1528,280 @@ namespace tasks {
     \param count Number of elements to be replaced.
     \param value Values to be copied.
     */
-    template <typename T>
-    void Vector<T>::assign(const size_type count, const T &value)
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::assign(const size_type count, const T &value)
     {
-        v_size = count; 
-        v_front_ptr = service_dynamic(re_capacity()); 
+        T value_copy(value);
+
+        clear();
+        if (count > v_capacity) {
+            size_type new_cap = count;
+            T *temp_ptr = service_dynamic(new_cap);
+            service_free(v_front_ptr, v_capacity);
+            v_front_ptr = temp_ptr;
+            v_capacity = new_cap;
+        }
+        tasks::uninitialized_fill(v_front_ptr, v_front_ptr + count, value_copy);
+        v_size = count;
+    }
 
-        for (size_type i = 0; i < v_size; ++i) {
-       	    v_front_ptr[i] = value; 
+    /**
+    \brief Replaces the contents with the elements of the range [first, last).
+     Reallocates at most once for forward iterators. The range must not refer to the vector.
+    \param first, last Iterators to the start and end of the range.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::assign(In first, In last)
+    {
+        typedef typename std::__is_integer<In>::__type Integral;
+        assign_dispatcher(first, last, Integral());
+    }
+
+    /**
+    \brief Overloaded function called by range assign for integral arguments, 
+     which mean count and value.
+    \param std::__true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename Int>
+    void Vector<T, Allocator, Growth>::assign_dispatcher(Int count, Int value, std::__true_type)
+    {
+        assign(static_cast<size_type>(count), static_cast<T>(value));
+    }
+
+    /**
+    \brief Overloaded function called by range assign for iterators.
+    \param std::__false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::assign_dispatcher(In first, In last, std::__false_type)
+    {
+        typedef typename std::iterator_traits<In>::iterator_category category;
+        assign_range(first, last, category());
+    }
+
+    /**
+    \brief Assigns range of single pass iterators element by element.
+    \param std::input_iterator_tag.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::assign_range(In first, In last, std::input_iterator_tag)
+    {
+        clear();
+        for (; first != last; ++first) {
+            emplace_back(*first);
         }
     }
 
     /**
-    \brief Allocates memory.
+    \brief Assigns range of forward iterators. Existing elements are assigned to, 
+     the storage is replaced only if the range does not fit.
+    \param std::forward_iterator_tag.
+    */
+    template <typename T, typename Allocator, typename Growth> template <typename In>
+    void Vector<T, Allocator, Growth>::assign_range(In first, In last, std::forward_iterator_tag)
+    {
+        size_type count = std::distance(first, last);
+
+        if (count > v_capacity) {
+            Vector<T, Allocator, Growth> temp(v_alloc);
+            temp.v_front_ptr = temp.service_dynamic(count);
+            temp.v_capacity = count;
+
+            for (; first != last; ++first, ++temp.v_size) {
+                ::new (static_cast<void *>(temp.v_front_ptr + temp.v_size)) T(*first);
+            }
+            take_storage(temp);
+        } else if (count > v_size) {
+            In mid = first;
+            std::advance(mid, v_size);
+            std::copy(first, mid, v_front_ptr);
+
+            for (; mid != last; ++mid, ++v_size) {
+                ::new (static_cast<void *>(v_front_ptr + v_size)) T(*mid);
+            }
+        } else {
+            std::copy(first, last, v_front_ptr);
+            tasks::destroy(v_front_ptr + count, v_front_ptr + v_size);
+            v_size = count;
+        }
+    }
+
+    /**
+    \brief Allocates raw memory for given number of elements from the allocator. 
+     No objects are constructed.
     \param new_cap Number of elements to allocate. 
-    \return Pointer to allocated memory.
+    \return Pointer to allocated memory, null if new_cap is 0.
     */
-    template <typename T>
-    T *Vector<T>::service_dynamic(const size_type new_cap)
+    template <typename T, typename Allocator, typename Growth>
+    T *Vector<T, Allocator, Growth>::service_dynamic(const size_type new_cap)
     {
-        return new T[new_cap]; 
+        if (!new_cap) {
+            return 0;
+        }
+        SMART_ARRAY_STAT(stats::on_allocate<T>(new_cap));
+        return alloc_traits::allocate(v_alloc, new_cap);
     }
 
-    ///Recalculating and changing the capacity value to be up to date.
-    template <typename T>
-    typename Vector<T>::size_type Vector<T>::re_capacity()
+    /**
+    \brief Returns memory allocated by service_dynamic to the allocator. 
+     Objects must be destroyed before.
+    \param ptr Pointer to memory, may be null.
+    \param cap Number of elements ptr was allocated for.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::service_free(T *ptr, const size_type cap)
+    {
+        if (ptr) {
+            alloc_traits::deallocate(v_alloc, ptr, cap);
+        }
+    }
+
+    /**
+    \brief Destroys own elements and takes over storage and allocator of other vector,
+     leaving it empty.
+    \param other Vector to take storage from.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::take_storage(Vector<T, Allocator, Growth> &other) noexcept
+    {
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        service_free(v_front_ptr, v_capacity);
+        v_size = other.v_size;
+        v_capacity = other.v_capacity;
+        v_front_ptr = other.v_front_ptr;
+        v_alloc = std::move(other.v_alloc);
+        other.v_size = 0;
+        other.v_capacity = 0;
+        other.v_front_ptr = 0;
+    }
+
+    /**
+    \brief Moves elements into newly allocated storage of given capacity.
+    \param new_cap New capacity, must not be less than size.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::reallocate(const size_type new_cap)
+    {
+        T *temp_ptr = service_dynamic(new_cap);
+
+        try {
+            tasks::uninitialized_move_if_noexcept(temp_ptr, v_front_ptr, temp_ptr + v_size);
+        } catch (...) {
+            service_free(temp_ptr, new_cap);
+            throw;
+        }
+        tasks::destroy(v_front_ptr, v_front_ptr + v_size);
+        service_free(v_front_ptr, v_capacity);
+        v_front_ptr = temp_ptr;
+        v_capacity = new_cap;
+    }
+
+    /**
+    \brief Writes header and elements encoded by Codec<T>. Elements are encoded twice,
+     first only to compute payload size and checksum for the header.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::save_elements(std::ostream &out, std::false_type) const
+    {
+        Binary_writer counter(0);
+
+        for (size_type i = 0; i < v_size; ++i) {
+            Codec<T>::encode(counter, v_front_ptr[i]);
+        }
+        Vector_file_header header = { Vector_file_header::current_version, Vector_file_header::byte_order_mark,
+                                      sizeof(T), Vector_file_header::codec_flag, v_size,
+                                      counter.bytes(), counter.checksum() };
+        header.write(out);
+        Binary_writer writer(&out);
+
+        for (size_type i = 0; i < v_size && out; ++i) {
+            Codec<T>::encode(writer, v_front_ptr[i]);
+        }
+    }
+
+    /**
+    \brief Writes header and elements as raw bytes, T is trivially copyable.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::save_elements(std::ostream &out, std::true_type) const
+    {
+        Checksum checksum;
+        checksum.update(v_front_ptr, v_size * sizeof(T));
+        Vector_file_header header = { Vector_file_header::current_version, Vector_file_header::byte_order_mark,
+                                      sizeof(T), 0, v_size, v_size * sizeof(T), checksum.value() };
+        header.write(out);
+        if (v_size) {
+            out.write(reinterpret_cast<const char *>(v_front_ptr), v_size * sizeof(T));
+        }
+    }
+
+    /**
+    \brief Decodes elements with Codec<T> into a new vector which replaces this one.
+    \param std::false_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::load_elements(std::istream &in, const Vector_file_header &header,
+                                                     std::false_type)
     {
-        return v_capacity = v_size + v_size / 2 + cap_modifier;
+        Vector temp(v_alloc);
+        Binary_reader reader(in, header.payload_bytes);
+
+        temp.reserve(std::min<uint64_t>(header.count, header.payload_bytes));
+        for (uint64_t i = 0; i < header.count; ++i) {
+            T value;
+            Codec<T>::decode(reader, value);
+            temp.push_back(std::move(value));
+        }
+        if (reader.bytes() != header.payload_bytes || reader.checksum() != header.checksum) {
+            throw std::runtime_error("Vector data is corrupted: checksum mismatch.");
+        }
+        *this = std::move(temp);
+    }
+
+    /**
+    \brief Reads elements with one bulk read into exactly sized storage, T is trivially copyable.
+    \param std::true_type is a struct that is used to decide 
+     which overloaded function will be called
+    */
+    template <typename T, typename Allocator, typename Growth>
+    void Vector<T, Allocator, Growth>::load_elements(std::istream &in, const Vector_file_header &header,
+                                                     std::true_type)
+    {
+        Vector temp(v_alloc);
+        Checksum checksum;
+
+        temp.v_front_ptr = temp.service_dynamic(header.count);
+        temp.v_capacity = header.count;
+        if (!in.read(reinterpret_cast<char *>(temp.v_front_ptr), header.payload_bytes)) {
+            throw std::runtime_error("Vector data is truncated.");
+        }
+        temp.v_size = header.count;
+        checksum.update(temp.v_front_ptr, header.payload_bytes);
+        if (checksum.value() != header.checksum) {
+            throw std::runtime_error("Vector data is corrupted: checksum mismatch.");
+        }
+        *this = std::move(temp);
+    }
+
+    /**
+    \brief Calculates the capacity for growing to given number of elements using the growth policy.
+    \param size Number of elements that must fit.
+    \return New capacity value.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::size_type Vector<T, Allocator, Growth>::re_capacity(const size_type size) const
+    {
+        size_type new_cap = Growth::grow(v_capacity, size, sizeof(T));
+
+        SMART_ARRAY_STAT(stats::on_grow<T>(size, new_cap));
+        return new_cap;
     }
 }
 
@@ -0,0 +1,529 @@
+/**
+\file
+\brief File contains definition of template Soa_vector class, a table of records
+ stored as one contiguous column per field.
+*/
+
+#ifndef _SOA_VECTOR_HPP_
+#define _SOA_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "smart_array.hpp"
+#include "span.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Structure of arrays: row i is the tuple of element i of every column.
+     All columns share size and capacity and grow together with Geometric_growth.
+     A loop reading one field touches only that column, see column<I>().
+     Rows are accessed through proxy references converting to and from std::tuple<Fields...>,
+     iterators over rows are random access and work with the standard algorithms.
+     Growing moves the columns if every field moves without throwing, otherwise copies them.
+    */
+    template <typename... Fields>
+    class Soa_vector
+    {
+        static_assert(sizeof...(Fields) > 0, "Soa_vector needs at least one field.");
+        typedef std::index_sequence_for<Fields...> Indices;
+        typedef std::tuple<Fields *...> Columns;
+        ///Whether growing may move the columns.
+        static constexpr bool nothrow_move = (std::is_nothrow_move_constructible<Fields>::value && ...);
+
+    public:
+        typedef std::tuple<Fields...> value_type;
+        typedef size_t size_type;
+        ///Type of field I.
+        template <size_t I>
+        using field_type = typename std::tuple_element<I, value_type>::type;
+
+        /**
+        \brief Proxy reference to a row. Assigning to it assigns the fields,
+         converting it gives the row as a tuple.
+        */
+        template <typename Owner>
+        class Basic_reference
+        {
+        public:
+            ///Constructor of reference to row index of the vector.
+            Basic_reference(Owner *owner_ptr, size_type index) : m_owner_ptr(owner_ptr), m_index(index) { }
+            Basic_reference(const Basic_reference &) = default;
+            ///Conversion to constant reference.
+            operator Basic_reference<const Soa_vector>() const
+            {
+                return Basic_reference<const Soa_vector>(m_owner_ptr, m_index);
+            }
+
+            ///Returns field I of the row.
+            template <size_t I>
+            auto &get() const { return m_owner_ptr->template data<I>()[m_index]; }
+            ///Returns copy of the row.
+            operator value_type() const { return load(Indices()); }
+
+            const Basic_reference &operator=(const value_type &row) const
+            {
+                assign(row, Indices());
+                return *this;
+            }
+            const Basic_reference &operator=(value_type &&row) const
+            {
+                assign(std::move(row), Indices());
+                return *this;
+            }
+            ///Copies fields of the referred row.
+            const Basic_reference &operator=(const Basic_reference &other) const
+            {
+                assign_from(other, Indices());
+                return *this;
+            }
+            ///Moves fields of the referred row.
+            const Basic_reference &operator=(Basic_reference &&other) const
+            {
+                move_from(other, Indices());
+                return *this;
+            }
+
+            ///Swaps fields of two rows.
+            friend void swap(Basic_reference left, Basic_reference right) { left.swap_with(right, Indices()); }
+
+            friend bool operator==(const Basic_reference &left, const Basic_reference &right)
+            {
+                return value_type(left) == value_type(right);
+            }
+            friend bool operator==(const Basic_reference &left, const value_type &right)
+            {
+                return value_type(left) == right;
+            }
+            friend bool operator==(const value_type &left, const Basic_reference &right)
+            {
+                return left == value_type(right);
+            }
+            friend bool operator!=(const Basic_reference &left, const Basic_reference &right)
+            {
+                return !(left == right);
+            }
+            friend bool operator!=(const Basic_reference &left, const value_type &right) { return !(left == right); }
+            friend bool operator!=(const value_type &left, const Basic_reference &right) { return !(left == right); }
+            friend bool operator<(const Basic_reference &left, const Basic_reference &right)
+            {
+                return value_type(left) < value_type(right);
+            }
+            friend bool operator<(const Basic_reference &left, const value_type &right)
+            {
+                return value_type(left) < right;
+            }
+            friend bool operator<(const value_type &left, const Basic_reference &right)
+            {
+                return left < value_type(right);
+            }
+
+        private:
+            template <size_t... I>
+            value_type load(std::index_sequence<I...>) const { return value_type(get<I>()...); }
+
+            template <typename Row, size_t... I>
+            void assign(Row &&row, std::index_sequence<I...>) const
+            {
+                ((get<I>() = std::get<I>(std::forward<Row>(row))), ...);
+            }
+
+            template <size_t... I>
+            void assign_from(const Basic_reference &other, std::index_sequence<I...>) const
+            {
+                ((get<I>() = other.template get<I>()), ...);
+            }
+
+            template <size_t... I>
+            void move_from(const Basic_reference &other, std::index_sequence<I...>) const
+            {
+                ((get<I>() = std::move(other.template get<I>())), ...);
+            }
+
+            template <size_t... I>
+            void swap_with(const Basic_reference &other, std::index_sequence<I...>) const
+            {
+                using std::swap;
+                (swap(get<I>(), other.template get<I>()), ...);
+            }
+
+            Owner *m_owner_ptr;
+            size_type m_index;
+        };
+
+        typedef Basic_reference<Soa_vector> reference;
+        typedef Basic_reference<const Soa_vector> const_reference;
+        typedef Indexed_iterator<Soa_vector, reference> iterator;
+        typedef Indexed_iterator<const Soa_vector, const_reference> const_iterator;
+
+        ///Default constructor.
+        Soa_vector() : v_size(0), v_capacity(0), v_columns() {}
+        Soa_vector(const Soa_vector &vec);
+        Soa_vector(Soa_vector &&vec) noexcept;
+        ~Soa_vector(void);
+
+        const Soa_vector &operator=(const Soa_vector &);
+        const Soa_vector &operator=(Soa_vector &&) noexcept;
+        bool operator==(const Soa_vector &) const;
+        bool operator!=(const Soa_vector &vec) const { return !(*this == vec); }
+
+        reference operator[](const size_type i) { return reference(this, i); }
+        const_reference operator[](const size_type i) const { return const_reference(this, i); }
+        reference at(size_type);
+        const_reference at(size_type) const;
+        reference front() { return (*this)[0]; }
+        reference back() { return (*this)[v_size - 1]; }
+        const_reference front() const { return (*this)[0]; }
+        const_reference back() const { return (*this)[v_size - 1]; }
+        ///Returns copy of row i.
+        value_type row(const size_type i) const { return (*this)[i]; }
+
+        ///Returns pointer to the column of field I.
+        template <size_t I>
+        field_type<I> *data() { return std::get<I>(v_columns); }
+        ///Returns pointer to the column of field I.
+        template <size_t I>
+        const field_type<I> *data() const { return std::get<I>(v_columns); }
+        ///Returns view of the column of field I.
+        template <size_t I>
+        Span<field_type<I> > column() { return Span<field_type<I> >(data<I>(), v_size); }
+        ///Returns view of the column of field I.
+        template <size_t I>
+        Span<const field_type<I> > column() const { return Span<const field_type<I> >(data<I>(), v_size); }
+
+        void push_back(const value_type &row) { emplace_row(row); }
+        void push_back(value_type &&row) { emplace_row(std::move(row)); }
+        ///Appends row constructing field I from argument I.
+        template <typename... Args>
+        void emplace_back(Args &&... args) { emplace_row(std::forward_as_tuple(std::forward<Args>(args)...)); }
+        void pop_back();
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, v_size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, v_size); }
+        bool empty() const { return 0 == v_size; }
+        size_type capacity() const { return v_capacity; }
+        size_type size() const { return v_size; }
+        void reserve(const size_type);
+        void resize(const size_type);
+        void swap(Soa_vector &) noexcept;
+        void clear();
+
+    private:
+        ///Number of rows.
+        size_type v_size;
+        ///Number of rows the columns can hold before reallocating.
+        size_type v_capacity;
+        ///Pointers to the columns.
+        Columns v_columns;
+
+        template <typename Row>
+        void emplace_row(Row &&);
+        template <typename Row, size_t... I>
+        void construct_row(Row &&, std::index_sequence<I...>);
+        template <size_t... I>
+        void destroy_row(const size_type, std::index_sequence<I...>);
+        template <size_t... I>
+        Columns allocate(const size_type, std::index_sequence<I...>);
+        template <size_t... I>
+        void deallocate(Columns &, const size_type, std::index_sequence<I...>);
+        template <size_t... I>
+        void copy_columns(Columns &, const Columns &, const size_type, std::index_sequence<I...>);
+        template <size_t... I>
+        void move_columns(Columns &, Columns &, const size_type, std::index_sequence<I...>);
+        void relocate(Columns &fresh, std::true_type) { move_columns(fresh, v_columns, v_size, Indices()); }
+        void relocate(Columns &fresh, std::false_type) { copy_columns(fresh, v_columns, v_size, Indices()); }
+        template <size_t... I>
+        void destroy_columns(Columns &, std::index_sequence<I...>);
+        template <size_t... I>
+        bool equal_columns(const Soa_vector &, std::index_sequence<I...>) const;
+        void reallocate(const size_type);
+    };
+
+    ///Copy constructor, copies the columns.
+    template <typename... Fields>
+    Soa_vector<Fields...>::Soa_vector(const Soa_vector &vec) : v_size(0), v_capacity(0), v_columns()
+    {
+        if (vec.v_size) {
+            v_columns = allocate(vec.v_size, Indices());
+            try {
+                copy_columns(v_columns, vec.v_columns, vec.v_size, Indices());
+            } catch (...) {
+                deallocate(v_columns, vec.v_size, Indices());
+                throw;
+            }
+            v_size = v_capacity = vec.v_size;
+        }
+    }
+
+    ///Move constructor, takes the columns of vec.
+    template <typename... Fields>
+    Soa_vector<Fields...>::Soa_vector(Soa_vector &&vec) noexcept
+        : v_size(vec.v_size), v_capacity(vec.v_capacity), v_columns(vec.v_columns)
+    {
+        vec.v_size = vec.v_capacity = 0;
+        vec.v_columns = Columns();
+    }
+
+    ///Destructor.
+    template <typename... Fields>
+    Soa_vector<Fields...>::~Soa_vector(void)
+    {
+        clear();
+        deallocate(v_columns, v_capacity, Indices());
+    }
+
+    ///Copy assignment, gives strong guarantee by copying first.
+    template <typename... Fields>
+    const Soa_vector<Fields...> &Soa_vector<Fields...>::operator=(const Soa_vector &vec)
+    {
+        if (this != &vec) {
+            Soa_vector temp(vec);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ///Move assignment, frees own rows and takes the columns of vec.
+    template <typename... Fields>
+    const Soa_vector<Fields...> &Soa_vector<Fields...>::operator=(Soa_vector &&vec) noexcept
+    {
+        if (this != &vec) {
+            Soa_vector temp(std::move(vec));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ///Compares sizes and columns of two vectors.
+    template <typename... Fields>
+    bool Soa_vector<Fields...>::operator==(const Soa_vector &vec) const
+    {
+        return v_size == vec.v_size && equal_columns(vec, Indices());
+    }
+
+    /**
+    \brief Returns row i. Throws std::out_of_range if i is not less than size.
+    */
+    template <typename... Fields>
+    typename Soa_vector<Fields...>::reference Soa_vector<Fields...>::at(size_type i)
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    /**
+    \brief Returns row i. Throws std::out_of_range if i is not less than size.
+    */
+    template <typename... Fields>
+    typename Soa_vector<Fields...>::const_reference Soa_vector<Fields...>::at(size_type i) const
+    {
+        if (i >= v_size) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return (*this)[i];
+    }
+
+    ///Removes the last row.
+    template <typename... Fields>
+    void Soa_vector<Fields...>::pop_back()
+    {
+        if (v_size) {
+            --v_size;
+            destroy_row(v_size, Indices());
+        }
+    }
+
+    /**
+    \brief Increases the capacity of every column if given value is greater than capacity.
+    \param new_cap Capacity.
+    */
+    template <typename... Fields>
+    void Soa_vector<Fields...>::reserve(const size_type new_cap)
+    {
+        if (new_cap > v_capacity) {
+            reallocate(new_cap);
+        }
+    }
+
+    /**
+    \brief Changes the number of rows, appended rows have value initialized fields.
+    \param new_size Number of rows.
+    */
+    template <typename... Fields>
+    void Soa_vector<Fields...>::resize(const size_type new_size)
+    {
+        reserve(new_size);
+        while (v_size > new_size) {
+            pop_back();
+        }
+        while (v_size < new_size) {
+            emplace_row(value_type());
+        }
+    }
+
+    ///Swaps the contents of two vectors.
+    template <typename... Fields>
+    void Soa_vector<Fields...>::swap(Soa_vector &other) noexcept
+    {
+        std::swap(v_size, other.v_size);
+        std::swap(v_capacity, other.v_capacity);
+        std::swap(v_columns, other.v_columns);
+    }
+
+    ///Removes all rows, keeps the capacity.
+    template <typename... Fields>
+    void Soa_vector<Fields...>::clear()
+    {
+        destroy_columns(v_columns, Indices());
+        v_size = 0;
+    }
+
+    /**
+    \brief Appends row given as a tuple, growing the columns if they are full.
+    */
+    template <typename... Fields>
+    template <typename Row>
+    void Soa_vector<Fields...>::emplace_row(Row &&row)
+    {
+        if (v_size == v_capacity) {
+            reallocate(Geometric_growth<>::grow(v_capacity, v_size + 1, sizeof(value_type)));
+        }
+        construct_row(std::forward<Row>(row), Indices());
+        ++v_size;
+    }
+
+    /**
+    \brief Constructs field I of row size from element I of row. Destroys the
+     constructed fields if a constructor throws.
+    */
+    template <typename... Fields>
+    template <typename Row, size_t... I>
+    void Soa_vector<Fields...>::construct_row(Row &&row, std::index_sequence<I...>)
+    {
+        size_t done = 0;
+
+        try {
+            ((::new (static_cast<void *>(std::get<I>(v_columns) + v_size))
+                  field_type<I>(std::get<I>(std::forward<Row>(row))), ++done), ...);
+        } catch (...) {
+            ((I < done ? std::get<I>(v_columns)[v_size].~field_type<I>() : void()), ...);
+            throw;
+        }
+    }
+
+    ///Destroys fields of row i.
+    template <typename... Fields>
+    template <size_t... I>
+    void Soa_vector<Fields...>::destroy_row(const size_type i, std::index_sequence<I...>)
+    {
+        (std::get<I>(v_columns)[i].~field_type<I>(), ...);
+    }
+
+    /**
+    \brief Allocates columns of given capacity, frees the allocated ones if one fails.
+    */
+    template <typename... Fields>
+    template <size_t... I>
+    typename Soa_vector<Fields...>::Columns Soa_vector<Fields...>::allocate(const size_type cap,
+                                                                            std::index_sequence<I...>)
+    {
+        Columns columns;
+
+        try {
+            ((std::get<I>(columns) = std::allocator<field_type<I> >().allocate(cap)), ...);
+        } catch (...) {
+            deallocate(columns, cap, Indices());
+            throw;
+        }
+        return columns;
+    }
+
+    ///Frees allocated columns of given capacity.
+    template <typename... Fields>
+    template <size_t... I>
+    void Soa_vector<Fields...>::deallocate(Columns &columns, const size_type cap, std::index_sequence<I...>)
+    {
+        ((std::get<I>(columns) ? std::allocator<field_type<I> >().deallocate(std::get<I>(columns), cap)
+                               : void()), ...);
+        columns = Columns();
+    }
+
+    /**
+    \brief Copies count rows of source columns into uninitialized target columns.
+     If a copy throws, rows copied into the target are destroyed.
+    */
+    template <typename... Fields>
+    template <size_t... I>
+    void Soa_vector<Fields...>::copy_columns(Columns &target, const Columns &source, const size_type count,
+                                             std::index_sequence<I...>)
+    {
+        size_t done = 0;
+
+        try {
+            ((tasks::uninitialized_copy(std::get<I>(target), static_cast<const field_type<I> *>(std::get<I>(source)),
+                                        std::get<I>(target) + count), ++done), ...);
+        } catch (...) {
+            ((I < done ? tasks::destroy(std::get<I>(target), std::get<I>(target) + count) : void()), ...);
+            throw;
+        }
+    }
+
+    ///Moves count rows of source columns into uninitialized target columns, moving cannot throw.
+    template <typename... Fields>
+    template <size_t... I>
+    void Soa_vector<Fields...>::move_columns(Columns &target, Columns &source, const size_type count,
+                                             std::index_sequence<I...>)
+    {
+        (tasks::uninitialized_move(std::get<I>(target), std::get<I>(source), std::get<I>(target) + count), ...);
+    }
+
+    ///Destroys size rows of given columns.
+    template <typename... Fields>
+    template <size_t... I>
+    void Soa_vector<Fields...>::destroy_columns(Columns &columns, std::index_sequence<I...>)
+    {
+        (tasks::destroy(std::get<I>(columns), std::get<I>(columns) + v_size), ...);
+    }
+
+    ///Compares columns of two vectors of the same size.
+    template <typename... Fields>
+    template <size_t... I>
+    bool Soa_vector<Fields...>::equal_columns(const Soa_vector &vec, std::index_sequence<I...>) const
+    {
+        return (std::equal(data<I>(), data<I>() + v_size, vec.template data<I>()) && ...);
+    }
+
+    /**
+    \brief Moves rows into newly allocated columns of given capacity.
+     Rows are copied instead if a field may throw when moved, the vector is unchanged if copying fails.
+    \param new_cap New capacity, not less than size.
+    */
+    template <typename... Fields>
+    void Soa_vector<Fields...>::reallocate(const size_type new_cap)
+    {
+        Columns fresh = allocate(new_cap, Indices());
+
+        try {
+            relocate(fresh, std::integral_constant<bool, nothrow_move>());
+        } catch (...) {
+            deallocate(fresh, new_cap, Indices());
+            throw;
+        }
+        destroy_columns(v_columns, Indices());
+        deallocate(v_columns, v_capacity, Indices());
+        v_columns = fresh;
+        v_capacity = new_cap;
+    }
+}
+
+#endif
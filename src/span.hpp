@@ -0,0 +1,59 @@
+/**
+\file
+\brief File contains definition of template Span class, a view of a contiguous range.
+*/
+
+#ifndef _SPAN_HPP_
+#define _SPAN_HPP_
+
+#include <cstddef>
+#include <type_traits>
+
+namespace tasks {
+
+    /**
+    \brief Non-owning view of count contiguous elements, iterated with raw pointers.
+     Span<const T> views elements read-only, Span<T> converts to it.
+    */
+    template <typename T>
+    class Span
+    {
+    public:
+        typedef T element_type;
+        typedef typename std::remove_cv<T>::type value_type;
+        typedef size_t size_type;
+        typedef T *iterator;
+
+        ///Default constructor of an empty span.
+        Span() : m_data_ptr(0), m_size(0) { }
+        ///Constructor of span of size elements starting at data_ptr.
+        Span(T *data_ptr, size_type size) : m_data_ptr(data_ptr), m_size(size) { }
+        ///Conversion from span of non-constant elements.
+        template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+        Span(const Span<U> &span) : m_data_ptr(span.data()), m_size(span.size()) { }
+
+        T *data() const { return m_data_ptr; }
+        size_type size() const { return m_size; }
+        bool empty() const { return 0 == m_size; }
+        T &operator[](size_type i) const { return m_data_ptr[i]; }
+        T &front() const { return *m_data_ptr; }
+        T &back() const { return m_data_ptr[m_size - 1]; }
+        iterator begin() const { return m_data_ptr; }
+        iterator end() const { return m_data_ptr + m_size; }
+
+        /**
+        \brief Returns view of count elements starting at offset, of the rest if count is past the end.
+        */
+        Span subspan(size_type offset, size_type count = size_type(-1)) const
+        {
+            offset = offset < m_size ? offset : m_size;
+            return Span(m_data_ptr + offset, count < m_size - offset ? count : m_size - offset);
+        }
+
+    private:
+        T *m_data_ptr;
+        size_type m_size;
+    };
+}
+
+#endif
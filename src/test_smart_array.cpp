@@ -7,9 +7,39 @@
 #include <string>
 #include <algorithm>
 #include <cassert>
+#include <sstream>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <functional>
+#include <vector>
+#include <set>
+#include <map>
+#include <deque>
+#include <cmath>
 
 #include "input.hpp"
 #include "smart_array.hpp"
+#include "arena_allocator.hpp"
+#include "pool_allocator.hpp"
+#include "small_vector.hpp"
+#include "vector_algorithms.hpp"
+#include "mmap_vector.hpp"
+#include "parallel.hpp"
+#include "work_stealing.hpp"
+#include "concurrent_vector.hpp"
+#include "segmented_vector.hpp"
+#include "soa_vector.hpp"
+#include "bit_vector.hpp"
+#include "packed_vector.hpp"
+#include "flat_map.hpp"
+#include "vector_expr.hpp"
+#include "cow_vector.hpp"
+#include "ring_vector.hpp"
 
 using tasks::Vector;
 
@@ -55,6 +85,1652 @@ void test_stl_algorithms_compatibility()
     std::advance(it, 4);
     assert(v.begin() + 4 == it);
     std::cout << "std::advance algorithm test successfully passed!\n";
+
+    typedef std::iterator_traits<Vector<int>::iterator> traits;
+    static_assert(std::is_same<traits::iterator_category, std::random_access_iterator_tag>::value, "category");
+    static_assert(std::is_signed<traits::difference_type>::value, "signed difference_type");
+    static_assert(std::is_same<std::iterator_traits<Vector<int>::const_iterator>::reference, const int &>::value,
+                  "const reference");
+    Vector<int> numbers;
+    for (int i = 0; i < 100; ++i) {
+        numbers.push_back((i * 37) % 100);
+    }
+    std::sort(numbers.begin(), numbers.end());
+    assert(std::is_sorted(numbers.begin(), numbers.end()) && 42 == *std::lower_bound(numbers.begin(), numbers.end(), 42));
+    Vector<int>::iterator last = numbers.end() - 1;
+    assert(99 == *last && 89 == last[-10] && 89 == *(last + -10) && 90 == *(-9 + last) && numbers.begin()[3] == 3);
+    last -= -1;
+    assert(last == numbers.end() && last > numbers.begin() && numbers.begin() <= last && last >= last);
+    const Vector<int> &const_numbers = numbers;
+    Vector<int>::const_iterator first = numbers.begin();
+    assert(first == const_numbers.begin() && numbers.end() - first == 100 && first < numbers.end());
+    assert(4950 == std::accumulate(const_numbers.begin(), const_numbers.end(), 0));
+    Vector<int> copy(100, 0);
+    std::copy(numbers.begin(), numbers.end(), copy.begin());
+    std::reverse(copy.begin(), copy.end());
+    assert(99 == copy[0] && std::equal(copy.begin(), copy.end(), numbers.rbegin()));
+    assert(numbers.data() == &numbers[0] && const_numbers.data() == &numbers[0] && 0 == Vector<int>().data());
+    tasks::Span<const int> view = const_numbers.span();
+    assert(100 == view.size() && view.begin() == numbers.data() && 50 == view[50]);
+    numbers.span().subspan(10, 5)[0] = -1;
+    assert(-1 == numbers[10]);
+    std::cout << "Contiguous iterator, data and span test successfully passed!\n";
+
+    Vector<int>::reverse_iterator r_first = numbers.rbegin();
+    Vector<int>::const_reverse_iterator r_last = const_numbers.rend();
+    assert(99 == *r_first && 97 == r_first[2] && 96 == *(r_first + 3) && 100 == r_last - r_first);
+    assert(r_first < r_last && r_last > r_first && r_first <= r_first && r_first != r_last);
+    assert(numbers.data() == Vector<int>::iterator(numbers.rend()).operator->() && r_first.base() == numbers.end());
+    assert(1 == *(r_last - 2) && 0 == *--r_last && 4950 - 1 - 10 == std::accumulate(r_first, numbers.rend() - 1, 0));
+    std::sort(numbers.rbegin(), numbers.rend());
+    assert(std::is_sorted(numbers.begin(), numbers.end(), std::greater<int>()) && 99 == numbers[0]);
+    Vector<int> empty;
+    assert(empty.rbegin() == empty.rend() && 0 == empty.rend() - empty.rbegin());
+    std::cout << "Reverse iterator adaptor test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Element type counting its live objects.
+*/
+struct Counted
+{
+    static int alive;
+    int value;
+
+    Counted(int v = 0) : value(v) { ++alive; }
+    Counted(const Counted &other) : value(other.value) { ++alive; }
+    Counted &operator=(const Counted &) = default;
+    ~Counted() { --alive; }
+};
+
+int Counted::alive = 0;
+
+/**
+\file 
+\brief Tests that Vector constructs only [0, size) and destroys removed elements.
+*/
+void test_element_lifetime()
+{
+    {
+        Vector<Counted> vec;
+        vec.reserve(100);
+        assert(0 == Counted::alive);
+        for (int i = 0; i < 10; ++i) {
+            vec.push_back(Counted(i));
+        }
+        assert(10 == Counted::alive);
+        vec.pop_back();
+        vec.erase(vec.begin());
+        assert(8 == Counted::alive && 1 == vec.front().value);
+        Vector<Counted>::iterator pos = vec.begin();
+        pos += 2;
+        vec.insert(pos, Counted(42));
+        assert(9 == Counted::alive && 42 == vec[2].value);
+        vec.resize(3);
+        assert(3 == Counted::alive);
+        vec.resize(200, Counted(7));
+        assert(200 == Counted::alive && 7 == vec.back().value);
+        Vector<Counted> copy(vec);
+        assert(400 == Counted::alive);
+        copy = Vector<Counted>(5);
+        assert(205 == Counted::alive);
+        copy.clear();
+        assert(200 == Counted::alive);
+        vec.assign(4, Counted(1));
+        assert(4 == Counted::alive);
+    }
+    assert(0 == Counted::alive);
+    std::cout << "Element lifetime test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests bulk memory paths of trivially copyable element types.
+*/
+void test_trivial_relocation()
+{
+    Vector<int> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+    Vector<int>::iterator pos = vec.begin();
+    pos += 10;
+    vec.insert(pos, -1);
+    assert(101 == vec.size() && 9 == vec[9] && -1 == vec[10] && 10 == vec[11] && 99 == vec[100]);
+    vec.erase(pos);
+    vec.erase(vec.begin());
+    assert(99 == vec.size() && 1 == vec[0] && 11 == vec[10] && 99 == vec.back());
+    Vector<int> copy(vec);
+    assert(copy == vec);
+    std::cout << "Trivially copyable relocation test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests move construction, move assignment and emplacing of Vector elements.
+*/
+void test_move_semantics()
+{
+    Vector<std::string> source(3, "payload");
+    const std::string *data_ptr = &source[0];
+    Vector<std::string> moved(std::move(source));
+    assert(&moved[0] == data_ptr && 3 == moved.size());
+    assert(source.empty() && 0 == source.capacity());
+    source = std::move(moved);
+    assert(&source[0] == data_ptr && moved.empty());
+    std::cout << "Move constructor and move assignment test successfully passed!\n";
+
+    Vector<std::unique_ptr<int> > owners;
+    for (int i = 0; i < 20; ++i) {
+        owners.push_back(std::unique_ptr<int>(new int(i)));
+    }
+    owners.emplace(owners.begin(), new int(-1));
+    owners.emplace_back(new int(20));
+    owners.erase(owners.begin());
+    assert(21 == owners.size() && 0 == *owners.front() && 20 == *owners.back());
+    std::cout << "Move-only element type test successfully passed!\n";
+
+    Vector<std::pair<int, std::string> > pairs;
+    pairs.emplace_back(1, "one");
+    pairs.emplace_back(pairs.front());
+    assert(2 == pairs.size() && "one" == pairs[1].second);
+    std::cout << "emplace_back test successfully passed!\n";
+}
+
+/**
+\brief Thread_local object using the pool in its destructor, after the thread's pool cache is gone.
+*/
+struct Late_release
+{
+    Vector<int, tasks::Pool_allocator<int> > items;
+    ///Block of the largest pool class the last destructor allocated and freed.
+    static void *freed_ptr;
+
+    ~Late_release()
+    {
+        items = Vector<int, tasks::Pool_allocator<int> >();
+        freed_ptr = tasks::Pool::allocate(tasks::Pool::max_block, alignof(int));
+        tasks::Pool::deallocate(freed_ptr, tasks::Pool::max_block, alignof(int));
+    }
+};
+
+void *Late_release::freed_ptr = 0;
+
+/**
+\file 
+\brief Tests Vector with arena and pool allocators.
+*/
+void test_allocators()
+{
+    tasks::Arena arena(256);
+    tasks::Arena_allocator<std::string> arena_alloc(arena);
+    {
+        Vector<std::string, tasks::Arena_allocator<std::string> > words(arena_alloc);
+        for (int i = 0; i < 100; ++i) {
+            words.push_back("word");
+        }
+        Vector<std::string, tasks::Arena_allocator<std::string> > copy(words);
+        assert(copy == words && copy.get_allocator() == arena_alloc);
+        assert(arena.capacity() > 0);
+    }
+    size_t arena_capacity = arena.capacity();
+    arena.reset();
+    assert(arena.capacity() <= arena_capacity);
+    bool rejected = false;
+    try {
+        arena_alloc.allocate(SIZE_MAX / sizeof(std::string) + 1);
+    } catch (const std::bad_array_new_length &) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::cout << "Arena allocator test successfully passed!\n";
+
+    Vector<Counted, tasks::Pool_allocator<Counted> > pooled;
+    for (int i = 0; i < 1000; ++i) {
+        pooled.push_back(Counted(i));
+    }
+    Vector<Counted, tasks::Pool_allocator<Counted> > other(10, Counted(1));
+    other = std::move(pooled);
+    assert(1000 == other.size() && 999 == other.back().value && pooled.empty());
+    other.clear();
+    assert(0 == Counted::alive);
+    rejected = false;
+    try {
+        other.get_allocator().allocate(SIZE_MAX / sizeof(Counted) + 1);
+    } catch (const std::bad_array_new_length &) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::cout << "Pool allocator test successfully passed!\n";
+
+    std::thread([] {
+        static thread_local Late_release holder;
+        for (int i = 0; i < 100; ++i) {
+            holder.items.push_back(i);
+        }
+    }).join();
+    void *reused_ptr = 0;
+    std::thread([&reused_ptr] { reused_ptr = tasks::Pool::allocate(tasks::Pool::max_block, alignof(int)); }).join();
+    assert(Late_release::freed_ptr && reused_ptr == Late_release::freed_ptr);
+    std::cout << "Pool allocator release after thread cache test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests exact sizing and growth policies of Vector.
+*/
+void test_growth_policies()
+{
+    Vector<int> sized(10, 1);
+    Vector<int> copy(sized);
+    assert(10 == sized.capacity() && 10 == copy.capacity());
+    sized.push_back(2);
+    assert(18 == sized.capacity());
+    Vector<int> grown;
+    std::vector<size_t> capacities;
+    for (int i = 0; i < 40; ++i) {
+        if (grown.size() == grown.capacity()) {
+            capacities.push_back(grown.capacity());
+        }
+        grown.push_back(i);
+    }
+    capacities.push_back(grown.capacity());
+    const size_t expected_capacities[] = { 0, 3, 7, 13, 22, 36, 57 };
+    assert(std::equal(capacities.begin(), capacities.end(), expected_capacities)
+           && 7 == capacities.size());
+    std::cout << "Exact sizing and default geometric growth test successfully passed!\n";
+
+    Vector<int, std::allocator<int>, tasks::Geometric_growth<2, 1, 0> > doubling(4, 0);
+    doubling.push_back(1);
+    assert(8 == doubling.capacity());
+
+    Vector<int, std::allocator<int>, tasks::Power_of_two_growth> pow2;
+    for (int i = 0; i < 100; ++i) {
+        pow2.push_back(i);
+        assert(0 == (pow2.capacity() & (pow2.capacity() - 1)));
+    }
+    assert(128 == pow2.capacity());
+
+    Vector<int, std::allocator<int>, tasks::Exact_growth> exact;
+    for (int i = 0; i < 5; ++i) {
+        exact.push_back(i);
+    }
+    assert(5 == exact.capacity());
+
+    Vector<int, std::allocator<int>, tasks::Capped_linear_growth<64> > capped(100, 0);
+    capped.push_back(1);
+    assert(116 == capped.capacity());
+    std::cout << "Growth policies test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests bulk insert, erase, append and assign of Vector.
+*/
+void test_bulk_operations()
+{
+    const int arr[] = { 1, 2, 3, 4, 5 };
+    Vector<int> ints(arr, arr + 5);
+    Vector<int>::iterator pos = ints.begin();
+    pos += 2;
+    ints.insert(pos, arr, arr + 5);
+    const int inserted[] = { 1, 2, 1, 2, 3, 4, 5, 3, 4, 5 };
+    assert(ints == Vector<int>(inserted, inserted + 10));
+    pos = ints.begin();
+    pos += 2;
+    Vector<int>::iterator last = pos;
+    last += 5;
+    ints.erase(pos, last);
+    assert(ints == Vector<int>(arr, arr + 5));
+    ints.insert(ints.begin(), 3, 0);
+    assert(8 == ints.size() && 0 == ints[2] && 1 == ints[3]);
+    ints.append(arr, arr + 5);
+    assert(13 == ints.size() && 5 == ints.back());
+    ints.assign(arr, arr + 2);
+    assert(2 == ints.size() && 2 == ints.back());
+    std::istringstream input("7 8 9");
+    ints.insert(ints.begin(), std::istream_iterator<int>(input), std::istream_iterator<int>());
+    assert(5 == ints.size() && 7 == ints[0] && 9 == ints[2] && 1 == ints[3]);
+    std::cout << "Bulk operations on trivially copyable elements test successfully passed!\n";
+
+    const std::string words[] = { "a", "b", "c", "d" };
+    {
+        Vector<std::string> strs(words, words + 4);
+        strs.reserve(20);
+        for (int offset = 0; offset <= 4; ++offset) {
+            Vector<std::string> copy(strs);
+            copy.reserve(20);
+            Vector<std::string>::iterator at = copy.begin();
+            at += offset;
+            copy.insert(at, words, words + 2);
+            assert(6 == copy.size() && "a" == copy[offset] && "b" == copy[offset + 1]);
+        }
+        strs.insert(strs.begin(), 2, strs[3]);
+        assert(6 == strs.size() && "d" == strs[0] && "d" == strs[1] && "a" == strs[2]);
+        Vector<std::string>::iterator from = strs.begin();
+        from += 1;
+        Vector<std::string>::iterator to = from;
+        to += 3;
+        strs.erase(from, to);
+        assert(3 == strs.size() && "d" == strs[0] && "c" == strs[1]);
+        strs.assign(words, words + 4);
+        assert(4 == strs.size() && "d" == strs[3]);
+    }
+    {
+        Vector<Counted> counted(3, Counted(1));
+        const Counted extra[] = { Counted(2), Counted(3) };
+        counted.insert(counted.begin(), extra, extra + 2);
+        counted.append(extra, extra + 2);
+        counted.erase(counted.begin(), counted.end());
+        counted.assign(extra, extra + 2);
+        assert(4 == Counted::alive);
+    }
+    assert(0 == Counted::alive);
+    std::cout << "Bulk operations on class elements test successfully passed!\n";
+}
+
+/**
+\brief Standard allocator with an identity, propagating on copy and move assignment and swap.
+*/
+template <typename T>
+struct Tagged_allocator : std::allocator<T>
+{
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+    template <typename U>
+    struct rebind { typedef Tagged_allocator<U> other; };
+
+    explicit Tagged_allocator(int tag_value = 0) : tag(tag_value) { }
+    template <typename U>
+    Tagged_allocator(const Tagged_allocator<U> &other) : tag(other.tag) { }
+
+    bool operator==(const Tagged_allocator &other) const { return tag == other.tag; }
+    bool operator!=(const Tagged_allocator &other) const { return tag != other.tag; }
+
+    int tag;
+};
+
+/**
+\file 
+\brief Tests Small_vector storing elements inline and on the heap.
+*/
+void test_small_vector()
+{
+    typedef tasks::Small_vector<int, 4> Small_ints;
+    Small_ints ints;
+    for (int i = 0; i < 4; ++i) {
+        ints.push_back(i);
+    }
+    assert(ints.is_inline() && 4 == ints.capacity());
+    ints.push_back(4);
+    assert(!ints.is_inline() && 5 == ints.size() && 4 == ints.back());
+    assert(std::count(ints.begin(), ints.end(), 2) == 1);
+    Small_ints::iterator pos = ints.begin();
+    pos += 1;
+    ints.erase(pos);
+    assert(0 == ints[0] && 2 == ints[1]);
+    std::cout << "Small_vector spilling to heap test successfully passed!\n";
+
+    {
+        typedef tasks::Small_vector<Counted, 3> Small_counted;
+        Small_counted inline_vec(2, Counted(1));
+        Small_counted heap_vec(6, Counted(2));
+        Small_counted copy(heap_vec);
+        assert(inline_vec.is_inline() && !heap_vec.is_inline() && 6 == copy.size() && 2 == copy[5].value);
+        inline_vec.swap(heap_vec);
+        assert(6 == inline_vec.size() && 2 == heap_vec.size() && heap_vec.is_inline());
+        Small_counted moved(std::move(inline_vec));
+        assert(6 == moved.size() && inline_vec.empty() && inline_vec.is_inline());
+        inline_vec = std::move(heap_vec);
+        assert(2 == inline_vec.size() && 1 == inline_vec[0].value && heap_vec.empty());
+        inline_vec.insert(inline_vec.begin(), 3, Counted(5));
+        assert(5 == inline_vec.size() && 5 == inline_vec.front().value);
+        inline_vec.resize(1);
+        assert(13 == Counted::alive);
+    }
+    assert(0 == Counted::alive);
+    std::cout << "Small_vector copy, move and swap test successfully passed!\n";
+
+    typedef tasks::Small_vector<int, 2, Tagged_allocator<int> > Tagged_ints;
+    static_assert(noexcept(std::declval<Small_ints &>().swap(std::declval<Small_ints &>())),
+                  "swap of Small_vector with std::allocator does not throw");
+    Tagged_ints first(5, 1, Tagged_allocator<int>(1));
+    Tagged_ints second(6, 2, Tagged_allocator<int>(2));
+    Tagged_ints rebound(first, Tagged_allocator<int>(3));
+    assert(3 == rebound.get_allocator().tag && 5 == rebound.size() && 1 == rebound.span()[4]);
+    first.swap(second);
+    assert(2 == first.get_allocator().tag && 6 == first.size() && 1 == second.get_allocator().tag);
+    rebound = first;
+    assert(2 == rebound.get_allocator().tag && 6 == rebound.size() && 2 == rebound.data()[5]);
+    const int *buffer_ptr = second.data();
+    rebound = std::move(second);
+    assert(1 == rebound.get_allocator().tag && buffer_ptr == rebound.data() && second.empty());
+    Tagged_ints small(1, 7, Tagged_allocator<int>(4));
+    rebound = std::move(small);
+    assert(4 == rebound.get_allocator().tag && rebound.is_inline() && 7 == rebound.front());
+    std::cout << "Small_vector allocator propagation test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests counters of statistics mode, built with make STATS=1.
+*/
+void test_statistics()
+{
+#ifdef SMART_ARRAY_STATS
+    {
+        tasks::Stats_scope scope("test_statistics");
+        Vector<int> ints;
+        for (int i = 0; i < 10; ++i) {
+            ints.push_back(i);
+        }
+        Vector<int> copy(ints);
+        copy.erase(copy.begin());
+    }
+    const tasks::stats::Record &record = tasks::stats::find("test_statistics");
+    // Geometric growth to 10 elements: capacities 3, 7, 13 then an exact copy.
+    assert(4 == record.allocations && 3 == record.growths && 13 == record.peak_capacity);
+    assert(10 * sizeof(int) == record.slack_bytes && 10 == record.elements_copied);
+    assert(3 + 7 + 9 == record.elements_moved);
+    std::cout << "Statistics counters test successfully passed!\n";
+#else
+    std::cout << "Statistics mode is off, statistics test skipped.\n";
+#endif
+}
+
+/**
+\file 
+\brief Checks SIMD kernels of active instruction set against std algorithms on
+ arrays of all lengths up to 80 starting at unaligned offsets. Values are small
+ integers, so floating point sums are exact.
+*/
+template <typename T>
+void check_simd_kernels()
+{
+    const size_t max_size = 80;
+    T data[max_size + 3];
+    T copy[max_size + 3];
+
+    for (size_t i = 0; i < max_size + 3; ++i) {
+        data[i] = static_cast<T>(std::rand() % 100);
+    }
+    for (size_t offset = 0; offset < 3; ++offset) {
+        for (size_t n = 0; n <= max_size; ++n) {
+            const T *ptr = data + offset;
+            T value = static_cast<T>(std::rand() % 100);
+            std::copy(ptr, ptr + n, copy);
+
+            assert(tasks::simd::equal(ptr, copy, n));
+            if (n) {
+                copy[std::rand() % n] = static_cast<T>(101);
+                assert(!tasks::simd::equal(ptr, copy, n));
+                assert(*std::min_element(ptr, ptr + n) == tasks::simd::min_value(ptr, n));
+                assert(*std::max_element(ptr, ptr + n) == tasks::simd::max_value(ptr, n));
+            }
+            assert(size_t(std::find(ptr, ptr + n, value) - ptr) == tasks::simd::find(ptr, n, value));
+            assert(size_t(std::count(ptr, ptr + n, value)) == tasks::simd::count(ptr, n, value));
+            typename tasks::simd::Sum<T>::type total = 0;
+            for (size_t i = 0; i < n; ++i) {
+                total += ptr[i];
+            }
+            assert(total == tasks::simd::sum(ptr, n));
+        }
+    }
+}
+
+/**
+\file 
+\brief Tests SIMD kernels on every supported instruction set and Vector functions using them.
+*/
+void test_simd_kernels()
+{
+    const char *names[] = { "scalar", "SSE2", "AVX2" };
+    tasks::simd::Isa detected = tasks::simd::detected_isa();
+
+    for (int isa = tasks::simd::scalar_isa; isa <= detected; ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        check_simd_kernels<int>();
+        check_simd_kernels<float>();
+        check_simd_kernels<double>();
+        check_simd_kernels<uint8_t>();
+        std::cout << names[isa] << " kernels test successfully passed!\n";
+    }
+    tasks::simd::set_isa(detected);
+
+    Vector<int> ints;
+    for (int i = -50; i < 50; ++i) {
+        ints.push_back(i);
+    }
+    Vector<int> same(ints);
+    assert(ints == same);
+    same[99] = 0;
+    assert(ints != same);
+    assert(*tasks::find(ints, 7) == 7 && tasks::find(ints, 100) == ints.end());
+    assert(2 == tasks::count(same, 0) && -50 == tasks::min_value(ints) && 49 == tasks::max_value(ints));
+    assert(-50 == tasks::sum(ints));
+    Vector<std::string> strings(3, "abc");
+    assert(3 == tasks::count(strings, std::string("abc")) && "abc" == tasks::max_value(strings));
+    bool thrown = false;
+    try {
+        tasks::min_value(Vector<double>());
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Vector search and reduction test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Record stored in the file of Mmap_vector test.
+*/
+struct Record
+{
+    int id;
+    double weight;
+};
+
+/**
+\file 
+\brief Tests Mmap_vector writing a file, reading it back read-only and editing it in place.
+*/
+void test_mmap_vector()
+{
+    typedef tasks::Mmap_vector<Record> Records;
+    const char *path = "mmap_vector_test.bin";
+    std::remove(path);
+    {
+        Records records(path, Records::read_write);
+        assert(records.empty() && !records.is_read_only());
+        for (int i = 0; i < 1000; ++i) {
+            Record record = { i, i * 0.5 };
+            records.push_back(record);
+        }
+        assert(1000 == records.size() && records.capacity() >= 1000 && 999 == records.back().id);
+    }
+    {
+        Records records(path);
+        const Records &view = records;
+        records.advise(Records::sequential);
+        assert(1000 == records.size() && 1000 == records.capacity() && records.is_read_only());
+        int ids = 0;
+        for (Records::const_iterator it = view.begin(); it != view.end(); ++it) {
+            ids += it->id;
+        }
+        assert(999 * 1000 / 2 == ids && 10.0 == view.at(20).weight);
+        bool thrown = false;
+        try {
+            records.push_back(view[0]);
+        } catch (const std::logic_error &) {
+            thrown = true;
+        }
+        assert(thrown);
+        records[0].id = -1;
+        records.back().id = -1;
+        (records.begin() + 1)->id = -1;
+        records.rbegin()[1].id = -1;
+        assert(-1 == view.front().id && -1 == view.back().id && -1 == view[1].id && -1 == view[998].id);
+    }
+    {
+        Records records(path, Records::read_write);
+        assert(0 == records[0].id && 1 == records[1].id && 998 == records[998].id && 999 == records[999].id);
+        Records::iterator pos = records.begin();
+        pos += 10;
+        records.erase(records.begin(), pos);
+        records.insert(records.begin(), 2, records[5]);
+        Record last = { -1, 0 };
+        records.resize(1500, last);
+        records.flush();
+        assert(1500 == records.size() && 15 == records[0].id && 15 == records[1].id && 10 == records[2].id);
+        assert(-1 == records.back().id);
+    }
+    {
+        Records records(path);
+        Records moved(std::move(records));
+        assert(records.empty() && 1500 == moved.size() && 1500 == moved.capacity() && 999 == moved[991].id);
+    }
+    std::remove(path);
+    std::cout << "Mmap_vector read-write and read-only test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests binary save and load of trivially copyable and string elements,
+ and rejection of corrupted or mismatching data.
+*/
+void test_serialization()
+{
+    Vector<Record> records;
+    for (int i = 0; i < 100; ++i) {
+        Record record = { i, i * 0.25 };
+        records.push_back(record);
+    }
+    std::stringstream stream;
+    records.save(stream);
+    Vector<Record> loaded(1, records[5]);
+    loaded.load(stream);
+    assert(100 == loaded.size() && 100 == loaded.capacity() && 99 == loaded.back().id);
+    assert(0.25 * 42 == loaded[42].weight);
+
+    Vector<std::string> strings;
+    strings.push_back("");
+    strings.push_back("first");
+    strings.push_back(std::string(1000, 'x'));
+    strings.save("vector_save_test.bin");
+    Vector<std::string> loaded_strings;
+    loaded_strings.load("vector_save_test.bin");
+    std::remove("vector_save_test.bin");
+    assert(loaded_strings == strings);
+
+    std::stringstream empty_stream;
+    Vector<int>().save(empty_stream);
+    Vector<int> empty(3, 1);
+    empty.load(empty_stream);
+    assert(empty.empty());
+    std::cout << "Save and load test successfully passed!\n";
+
+    std::string bytes = stream.str();
+    bytes[bytes.size() - 3] ^= 1;
+    const std::string bad_inputs[] = { bytes, bytes.substr(0, bytes.size() - 8), "not a vector" };
+    for (size_t i = 0; i < 3; ++i) {
+        std::istringstream in(bad_inputs[i]);
+        bool thrown = false;
+        try {
+            loaded.load(in);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        assert(thrown && 100 == loaded.size());
+    }
+    std::stringstream int_stream;
+    Vector<int>(4, 7).save(int_stream);
+    Vector<double> doubles;
+    bool thrown = false;
+    try {
+        doubles.load(int_stream);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::stringstream huge_stream;
+    Vector<uint64_t>(1, 5).save(huge_stream);
+    std::string huge_bytes = huge_stream.str();
+    const uint64_t huge_count = (uint64_t(1) << 61) + 1;
+    huge_bytes.replace(16, sizeof huge_count, reinterpret_cast<const char *>(&huge_count), sizeof huge_count);
+    std::istringstream huge_in(huge_bytes);
+    Vector<uint64_t, tasks::Pool_allocator<uint64_t> > huge;
+    thrown = false;
+    try {
+        huge.load(huge_in);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown && huge.empty());
+    std::cout << "Corrupted and mismatching data test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests parallel algorithms against sequential ones with a pool of four threads,
+ on sizes below and above the sequential threshold and on unaligned ranges.
+*/
+void test_parallel_algorithms()
+{
+    namespace parallel = tasks::parallel;
+    parallel::Thread_pool pool(4);
+    const size_t sizes[] = { 0, 1, 1000, 100003 };
+
+    for (size_t s = 0; s < 4; ++s) {
+        size_t n = sizes[s];
+        Vector<int> ints;
+        for (size_t i = 0; i < n + 1; ++i) {
+            ints.push_back(std::rand() % 1000 - 500);
+        }
+        Vector<int>::iterator first = ints.begin();
+        ++first;
+        Vector<int>::iterator last = ints.end();
+
+        Vector<long long> wide(n + 1);
+        long long *wide_ptr = &wide[0];
+        parallel::transform(first, last, wide.begin(), [](int v) { return 3LL * v; }, pool);
+        assert(3 * std::accumulate(first, last, 0LL) == std::accumulate(wide_ptr, wide_ptr + n, 0LL));
+        assert(std::accumulate(first, last, 5LL) == parallel::reduce(first, last, 5LL, pool));
+
+        Vector<long long> prefix(wide);
+        parallel::inclusive_scan(wide_ptr, wide_ptr + n, prefix.begin(), pool);
+        std::partial_sum(wide_ptr, wide_ptr + n, wide_ptr);
+        assert(std::equal(wide_ptr, wide_ptr + n, &prefix[0]));
+
+        Vector<int> sorted(ints);
+        Vector<int> expected(ints);
+        parallel::sort(sorted.begin(), sorted.end(), pool);
+        std::sort(&expected[0], &expected[0] + n + 1);
+        assert(sorted == expected);
+        parallel::sort(sorted.begin(), sorted.end(), std::greater<int>(), pool);
+        assert(std::is_sorted(&sorted[0], &sorted[0] + n + 1, std::greater<int>()));
+
+        parallel::for_each(first, last, [](int &v) { v *= 2; }, pool);
+        parallel::fill(expected.begin(), expected.end(), 7, pool);
+        assert(n + 1 == size_t(tasks::count(expected, 7)));
+        assert(0 == parallel::reduce(first, last, 0LL, [](long long a, long long b) { return a + (b & 1); }, pool));
+    }
+    std::cout << "Parallel algorithms test successfully passed!\n";
+
+    Vector<std::string> words;
+    for (int i = 0; i < 20000; ++i) {
+        words.push_back(std::to_string(std::rand()));
+    }
+    Vector<std::string> expected(words);
+    parallel::sort(words.begin(), words.end(), pool);
+    std::stable_sort(&expected[0], &expected[0] + expected.size());
+    assert(words == expected);
+    bool thrown = false;
+    try {
+        parallel::for_each(words.begin(), words.end(), [](std::string &w) {
+            if ("1000" == w) { throw std::runtime_error("stop"); }
+        }, pool);
+        words.push_back("1000");
+        parallel::for_each(words.begin(), words.end(), [](std::string &w) {
+            if ("1000" == w) { throw std::runtime_error("stop"); }
+        }, pool);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Parallel sort of strings and exception test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests the Chase-Lev deque alone and under concurrent stealing, then parallel_for
+ on even and skewed work, nested loops and exceptions.
+*/
+void test_work_stealing()
+{
+    namespace parallel = tasks::parallel;
+    const size_t items = 20000;
+    Vector<parallel::Index_range> ranges(items);
+    parallel::Chase_lev_deque deque(4);
+
+    for (size_t i = 0; i < 100; ++i) {
+        deque.push(&ranges[i]);
+    }
+    assert(&ranges[0] == deque.steal() && &ranges[99] == deque.take() && &ranges[98] == deque.take());
+    while (deque.take()) { }
+    assert(!deque.steal());
+    std::cout << "Chase-Lev deque test successfully passed!\n";
+
+    std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[items]());
+    std::atomic<bool> done(false);
+    auto thief = [&] {
+        while (!done.load()) {
+            if (parallel::Index_range *range_ptr = deque.steal()) {
+                ++seen[range_ptr - &ranges[0]];
+            }
+        }
+    };
+    std::thread thief1(thief);
+    std::thread thief2(thief);
+    for (size_t i = 0; i < items; ++i) {
+        deque.push(&ranges[i]);
+        if (i % 3 == 0) {
+            if (parallel::Index_range *range_ptr = deque.take()) {
+                ++seen[range_ptr - &ranges[0]];
+            }
+        }
+    }
+    while (parallel::Index_range *range_ptr = deque.take()) {
+        ++seen[range_ptr - &ranges[0]];
+    }
+    done = true;
+    thief1.join();
+    thief2.join();
+    for (size_t i = 0; i < items; ++i) {
+        assert(1 == seen[i]);
+    }
+    std::cout << "Concurrent stealing test successfully passed!\n";
+
+    parallel::Work_stealing_scheduler scheduler(4);
+    Vector<int> counts(100003, 0);
+    parallel::parallel_for(counts, 16, [](int &v) { ++v; }, scheduler);
+    assert(100003 == tasks::count(counts, 1));
+    parallel::parallel_for(counts, 0, [&](int &v) {
+        Vector<int> inner(100, 1);
+        parallel::parallel_for(inner, 8, [](int &w) { w += 1; }, scheduler);
+        v += tasks::sum(inner);
+    }, scheduler);
+    assert(100003 == tasks::count(counts, 201));
+    std::cout << "Parallel for test successfully passed!\n";
+
+    Vector<std::string> records;
+    for (int i = 0; i < 2000; ++i) {
+        records.push_back(std::string(i % 100 ? 10 : 5000, 'a' + i % 26));
+    }
+    Vector<size_t> lengths(records.size());
+    size_t *lengths_ptr = &lengths[0];
+    const std::string *records_ptr = &records[0];
+    scheduler.run(records.size(), 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            lengths_ptr[i] = std::count(records_ptr[i].begin(), records_ptr[i].end(), records_ptr[i][0]);
+        }
+    });
+    for (size_t i = 0; i < records.size(); ++i) {
+        assert(records[i].size() == lengths[i]);
+    }
+    bool thrown = false;
+    try {
+        parallel::parallel_for(records, 1, [](std::string &r) {
+            if (r.size() > 1000) { throw std::runtime_error("too long"); }
+        }, scheduler);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+    parallel::parallel_for(records, 1, [](std::string &r) { r.resize(1); }, scheduler);
+    for (size_t i = 0; i < records.size(); ++i) {
+        assert(std::string(1, char('a' + i % 26)) == records[i]);
+    }
+    std::cout << "Skewed work and exception test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Element copying throws when constructed from a negative value.
+*/
+struct Picky
+{
+    Picky(int init) : value(init) { }
+    Picky(const Picky &other) : value(other.value)
+    {
+        if (value < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+    int value;
+};
+
+/**
+\file 
+\brief Tests Concurrent_vector: segment layout, stable addresses, unpublished elements
+ after a throwing constructor, and a stress test of threads appending with push_back
+ and grow_by while a reader checks published elements.
+*/
+void test_concurrent_vector()
+{
+    tasks::Concurrent_vector<int> ints;
+    assert(ints.empty() && 0 == ints.capacity());
+    const int *first_ptr = &ints[ints.push_back(0)];
+    for (int i = 1; i < 1000; ++i) {
+        assert(size_t(i) == ints.push_back(i));
+    }
+    assert(first_ptr == &ints[0] && 1000 == ints.size() && 1016 == ints.capacity());
+    assert(1000 == ints.grow_by(3, 7) && 7 == ints.at(1002) && ints.published(1002) && !ints.published(1003));
+    Vector<int> compact = ints.to_vector();
+    assert(1003 == compact.size() && 999 == compact[999] && 7 == compact[1000]);
+    ints.clear();
+    assert(ints.empty() && 0 == ints.capacity());
+    ints.reserve(100);
+    assert(120 == ints.capacity());
+    ints.push_back(1);
+    bool too_long = false;
+    try {
+        ints.grow_by(size_t(-1));
+    } catch (const std::length_error &) {
+        too_long = true;
+    }
+    assert(too_long && 1 == ints.size() && 120 == ints.capacity() && 1 == ints.push_back(2));
+    std::cout << "Concurrent_vector basic test successfully passed!\n";
+
+    tasks::Concurrent_vector<Picky> pickies;
+    pickies.push_back(Picky(1));
+    bool thrown = false;
+    try {
+        pickies.push_back(Picky(-1));
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    pickies.push_back(Picky(3));
+    assert(thrown && 3 == pickies.size() && !pickies.published(1));
+    bool out_of_range = false;
+    try {
+        pickies.at(1);
+    } catch (const std::out_of_range &) {
+        out_of_range = true;
+    }
+    Vector<Picky> compact_pickies = pickies.to_vector();
+    assert(out_of_range && 2 == compact_pickies.size() && 3 == compact_pickies[1].value);
+    std::cout << "Concurrent_vector exception test successfully passed!\n";
+
+    const int threads = 4;
+    const int per_thread = 20000;
+    tasks::Concurrent_vector<std::pair<int, int> > pairs;
+    std::atomic<bool> done(false);
+    std::thread reader([&] {
+        while (!done.load()) {
+            size_t size = pairs.size();
+            for (size_t i = size > 64 ? size - 64 : 0; i < size; ++i) {
+                if (pairs.published(i)) {
+                    assert(pairs[i].second >= 0 && pairs[i].second < per_thread);
+                }
+            }
+        }
+    });
+    Vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&pairs, t] {
+            for (int i = 0; i < per_thread; i += 4) {
+                pairs.push_back(std::make_pair(t, i));
+                pairs.push_back(std::make_pair(t, i + 1));
+                pairs.grow_by(2, std::make_pair(t, i + 2));
+            }
+        });
+    }
+    for (int t = 0; t < threads; ++t) {
+        writers[t].join();
+    }
+    done = true;
+    reader.join();
+    Vector<std::pair<int, int> > all = pairs.to_vector();
+    assert(size_t(threads * per_thread) == all.size());
+    std::sort(&all[0], &all[0] + all.size());
+    for (int t = 0; t < threads; ++t) {
+        for (int i = 0; i < per_thread; ++i) {
+            assert(std::make_pair(t, i % 4 == 3 ? i - 1 : i) == all[t * per_thread + i]);
+        }
+    }
+    std::cout << "Concurrent_vector stress test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests Segmented_vector: element addresses kept across growth, block layout,
+ standard algorithms on its iterators, insert and erase against Vector, and element lifetime.
+*/
+void test_segmented_vector()
+{
+    typedef tasks::Segmented_vector<int, std::allocator<int>, 64> Small_blocks;
+    assert(16 == Small_blocks::block_size && 4 == Small_blocks::block_shift);
+
+    Small_blocks ints;
+    ints.push_back(0);
+    const int *first_ptr = &ints[0];
+    for (int i = 1; i < 1000; ++i) {
+        ints.push_back(i);
+    }
+    const int *middle_ptr = &ints[500];
+    ints.reserve(5000);
+    ints.resize(3000, -1);
+    assert(first_ptr == &ints[0] && middle_ptr == &ints[500] && 500 == *middle_ptr);
+    assert(3000 == ints.size() && 5008 == ints.capacity() && 313 == ints.block_count());
+    ints.resize(1000);
+    ints.shrink_to_fit();
+    assert(1008 == ints.capacity() && first_ptr == &ints[0] && 999 == ints.back());
+    bool thrown = false;
+    try {
+        ints.at(1000);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Segmented_vector stable address test successfully passed!\n";
+
+    Small_blocks::iterator it = ints.begin();
+    std::advance(it, 40);
+    assert(40 == *it && ints.begin() + 40 == it && 40 == it - ints.begin() && 41 == it[1]);
+    assert(1 == std::count(ints.begin(), ints.end(), 77) && 77 == *std::find(ints.begin(), ints.end(), 77));
+    std::reverse(ints.begin(), ints.end());
+    assert(999 == ints.front() && 0 == *ints.rbegin());
+    std::sort(ints.begin(), ints.end());
+    assert(std::is_sorted(ints.begin(), ints.end()) && 0 == ints.front());
+    const Small_blocks &view = ints;
+    assert(500 == *std::lower_bound(view.begin(), view.end(), 500));
+    assert(499500 == std::accumulate(view.begin(), view.end(), 0));
+    std::cout << "Segmented_vector algorithms test successfully passed!\n";
+
+    Vector<int> reference;
+    Small_blocks edited;
+    for (int i = 0; i < 100; ++i) {
+        reference.push_back(i);
+        edited.push_back(i);
+    }
+    for (int i = 0; i < 30; ++i) {
+        size_t pos = (i * 37) % reference.size();
+        Vector<int>::iterator ref_it = reference.begin();
+        ref_it += pos;
+        if (i % 3) {
+            reference.insert(ref_it, -i);
+            assert(-i == *edited.insert(edited.begin() + pos, -i));
+        } else {
+            reference.erase(ref_it);
+            edited.erase(edited.begin() + pos);
+        }
+    }
+    edited.erase(edited.begin() + 10, edited.begin() + 20);
+    Vector<int>::iterator from = reference.begin();
+    from += 10;
+    Vector<int>::iterator to = reference.begin();
+    to += 20;
+    reference.erase(from, to);
+    assert(reference.size() == edited.size() && std::equal(edited.begin(), edited.end(), reference.begin()));
+    Small_blocks copy(edited);
+    assert(copy == edited);
+    copy.back() = 1000;
+    assert(copy != edited);
+    Small_blocks moved(std::move(copy));
+    assert(copy.empty() && 1000 == moved.back());
+    copy = moved;
+    assert(copy == moved);
+    std::cout << "Segmented_vector insert, erase and copy test successfully passed!\n";
+
+    {
+        tasks::Segmented_vector<Counted> counted(10, Counted(1));
+        for (int i = 0; i < 3000; ++i) {
+            counted.emplace_back(i);
+        }
+        counted.pop_back();
+        counted.resize(2000);
+        tasks::Segmented_vector<Counted> other(counted.begin(), counted.end());
+        assert(4000 == Counted::alive);
+        other.clear();
+        assert(2000 == Counted::alive);
+    }
+    assert(0 == Counted::alive);
+    std::cout << "Segmented_vector element lifetime test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests Soa_vector: columns and rows, standard algorithms over row proxies,
+ copying, and rows left out when a field constructor throws.
+*/
+void test_soa_vector()
+{
+    typedef tasks::Soa_vector<int, double, std::string> Table;
+    Table table;
+    for (int i = 0; i < 100; ++i) {
+        table.push_back(std::make_tuple(99 - i, i * 0.5, std::to_string(i)));
+    }
+    table.emplace_back(-1, 1.5, "last");
+    assert(101 == table.size() && table.capacity() >= 101 && "last" == table.back().get<2>());
+    tasks::Span<double> weights = table.column<1>();
+    assert(101 == weights.size() && 2476.5 == std::accumulate(weights.begin(), weights.end(), 0.0));
+    weights[0] = 10.0;
+    assert(10.0 == table[0].get<1>() && std::make_tuple(99, 10.0, std::string("0")) == table.row(0));
+    table[1] = std::make_tuple(7, 7.0, std::string("seven"));
+    assert(table[1] == std::make_tuple(7, 7.0, std::string("seven")));
+    bool thrown = false;
+    try {
+        table.at(101);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Soa_vector columns and rows test successfully passed!\n";
+
+    Table::iterator it = table.begin();
+    std::advance(it, 5);
+    assert(table.begin() + 5 == it && 5 == it - table.begin() && 94 == it[0].get<0>());
+    assert(1 == std::count(table.begin(), table.end(), std::make_tuple(-1, 1.5, std::string("last"))));
+    Table copy(table);
+    std::sort(table.begin(), table.end());
+    assert(std::is_sorted(table.begin(), table.end()) && -1 == table.front().get<0>());
+    assert(copy != table);
+    std::reverse(table.begin(), table.end());
+    std::iter_swap(table.begin(), table.end() - 1);
+    assert(-1 == table.front().get<0>() && 99 == table.back().get<0>());
+    const Table &view = table;
+    tasks::Span<const int> ids = view.column<0>();
+    assert(std::find(ids.begin(), ids.end(), 42) != ids.end());
+    Table::const_iterator found = std::find_if(view.begin(), view.end(),
+                                               [](Table::const_reference row) { return 42 == row.get<0>(); });
+    assert(found != view.end() && "57" == (*found).get<2>());
+    copy = table;
+    assert(copy == table);
+    Table moved(std::move(copy));
+    assert(copy.empty() && moved == table);
+    moved.resize(10);
+    moved.pop_back();
+    assert(9 == moved.size() && -1 == moved.front().get<0>());
+    moved.resize(12);
+    assert(0 == moved.back().get<0>() && moved.back().get<2>().empty());
+    std::cout << "Soa_vector algorithms and copy test successfully passed!\n";
+
+    {
+        tasks::Soa_vector<Counted, Picky> pairs;
+        for (int i = 0; i < 50; ++i) {
+            pairs.emplace_back(i, Picky(i));
+        }
+        bool failed = false;
+        try {
+            pairs.emplace_back(50, Picky(-1));
+        } catch (const std::runtime_error &) {
+            failed = true;
+        }
+        assert(failed && 50 == pairs.size() && 50 == Counted::alive);
+        tasks::Soa_vector<Counted, Picky> other(pairs);
+        assert(100 == Counted::alive && 49 == other.back().get<1>().value);
+    }
+    assert(0 == Counted::alive);
+    std::cout << "Soa_vector exception test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests Bit_vector against std::vector<bool>: element access, growth and shrinking
+ across word boundaries, count, search and bitwise operators on every instruction set.
+*/
+void test_bit_vector()
+{
+    using tasks::Bit_vector;
+    Bit_vector flags;
+    std::vector<bool> expected;
+    for (int i = 0; i < 1000; ++i) {
+        bool value = 0 == std::rand() % 3;
+        flags.push_back(value);
+        expected.push_back(value);
+    }
+    flags[5] = true;
+    expected[5] = true;
+    flags[6] = flags[5];
+    expected[6] = true;
+    flags.flip(7);
+    expected[7] = !expected[7];
+    assert(1000 == flags.size() && 16 == flags.word_count() && flags.capacity() >= 1000);
+    assert(std::equal(flags.begin(), flags.end(), expected.begin()));
+    assert(size_t(std::count(expected.begin(), expected.end(), true)) == flags.count());
+    assert(flags.count() == size_t(std::count(flags.begin(), flags.end(), true)));
+    for (int i = 0; i < 100; ++i) {
+        flags.pop_back();
+        expected.pop_back();
+    }
+    flags.resize(1100, true);
+    expected.resize(1100, true);
+    flags.resize(1030);
+    expected.resize(1030);
+    assert(17 == flags.word_count() && std::equal(flags.begin(), flags.end(), expected.begin()));
+    bool thrown = false;
+    try {
+        flags.at(1030);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Bit_vector access and resize test successfully passed!\n";
+
+    Bit_vector sparse(300);
+    assert(sparse.none() && 300 == sparse.find_first());
+    sparse.set(70);
+    sparse.set(64);
+    sparse.set(299);
+    assert(64 == sparse.find_first() && 70 == sparse.find_next(64) && 299 == sparse.find_next(70));
+    assert(300 == sparse.find_next(299) && 3 == sparse.count() && !sparse.all());
+    assert(Bit_vector(130, true).all() && 130 == Bit_vector(130, true).count());
+    Bit_vector::iterator it = sparse.begin();
+    std::advance(it, 64);
+    assert(*it && sparse.begin() + 64 == it && 64 == it - sparse.begin() && it[6]);
+    std::reverse(sparse.begin(), sparse.end());
+    assert(0 == sparse.find_first() && 229 == sparse.find_next(0) && 235 == sparse.find_next(229));
+    std::cout << "Bit_vector search and iterator test successfully passed!\n";
+
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        Bit_vector left(1000);
+        Bit_vector right(1000);
+        std::vector<bool> left_expected(1000);
+        std::vector<bool> right_expected(1000);
+        for (int i = 0; i < 1000; ++i) {
+            left_expected[i] = 0 == i % 3;
+            right_expected[i] = 0 == i % 5;
+            left.set(i, left_expected[i]);
+            right.set(i, right_expected[i]);
+        }
+        Bit_vector both = left & right;
+        Bit_vector either = left | right;
+        Bit_vector one = left ^ right;
+        Bit_vector inverted = ~left;
+        for (int i = 0; i < 1000; ++i) {
+            assert(both[i] == (left_expected[i] && right_expected[i]));
+            assert(either[i] == (left_expected[i] || right_expected[i]));
+            assert(one[i] == (left_expected[i] != right_expected[i]));
+            assert(inverted[i] == !left_expected[i]);
+        }
+        assert(67 == both.count() && 467 == either.count() && 400 == one.count() && 666 == inverted.count());
+        assert(~inverted == left && inverted != left);
+        bool mismatch = false;
+        try {
+            left &= Bit_vector(999);
+        } catch (const std::invalid_argument &) {
+            mismatch = true;
+        }
+        assert(mismatch);
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+    std::cout << "Bit_vector bitwise operators test successfully passed!\n";
+}
+
+void test_packed_vector()
+{
+    using tasks::Packed_vector;
+    using tasks::Block_packed_vector;
+    for (unsigned bits = 1; bits <= 64; bits += 7) {
+        Packed_vector packed(bits);
+        std::vector<uint64_t> expected;
+        for (int i = 0; i < 500; ++i) {
+            uint64_t value = (uint64_t(std::rand()) << 33 ^ uint64_t(std::rand()) << 11 ^ i) & packed.max_value();
+            packed.push_back(value);
+            expected.push_back(value);
+        }
+        packed.set(3, packed.max_value());
+        expected[3] = packed.max_value();
+        packed.resize(520, 1);
+        expected.resize(520, 1);
+        packed.pop_back();
+        expected.pop_back();
+        assert(519 == packed.size() && (519 * bits + 63) / 64 == packed.word_count());
+        assert(std::equal(packed.begin(), packed.end(), expected.begin()));
+        bool thrown = false;
+        try {
+            packed.push_back(uint64_t(1) << bits % 64);
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        assert(thrown == (bits < 64) && packed.size() == (bits < 64 ? 519 : 520));
+    }
+    tasks::Vector<uint32_t> ids;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ids.push_back(i * 3 % 1000);
+    }
+    Packed_vector packed_ids(ids);
+    assert(10 == packed_ids.bits() && 157 == packed_ids.word_count() && 999 == packed_ids[333]);
+    assert(packed_ids.to_vector<uint32_t>() == ids && packed_ids == Packed_vector(ids, 10));
+    assert(Packed_vector(ids, 12) != packed_ids && Packed_vector::bits_for(0) == 1);
+    bool invalid = false;
+    try {
+        Packed_vector wide(65);
+    } catch (const std::invalid_argument &) {
+        invalid = true;
+    }
+    assert(invalid);
+    std::cout << "Packed_vector access and conversion test successfully passed!\n";
+
+    tasks::Vector<uint64_t> sorted;
+    tasks::Vector<uint32_t> clustered;
+    tasks::Vector<uint32_t> noise;
+    uint64_t id = 1000000;
+    for (int i = 0; i < 1000; ++i) {
+        id += std::rand() % 50;
+        sorted.push_back(id);
+        clustered.push_back(70000 + std::rand() % 300);
+        noise.push_back(uint32_t(std::rand()) << 16 ^ uint32_t(std::rand()) ^ (i % 2 ? 0x80000000u : 0));
+    }
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        Block_packed_vector deltas(sorted, Block_packed_vector::delta);
+        Block_packed_vector frames(clustered);
+        Block_packed_vector wide(noise, Block_packed_vector::delta);
+        assert(1000 == deltas.size() && 7 == deltas.block_count() && deltas.encoded_bytes() < 1500);
+        assert(frames.encoded_bytes() < 1600 && wide.encoded_bytes() > 4000);
+        assert(deltas.to_vector<uint64_t>() == sorted && frames.to_vector() == clustered && wide.to_vector() == noise);
+        for (size_t i = 0; i < 1000; i += 37) {
+            assert(deltas[i] == sorted[i] && frames[i] == clustered[i] && wide.at(i) == noise[i]);
+        }
+        uint64_t total = 0;
+        frames.scan([&total](const uint32_t *values_ptr, size_t count) {
+            total = std::accumulate(values_ptr, values_ptr + count, total);
+        });
+        assert(total == std::accumulate(&clustered[0], &clustered[0] + 1000, uint64_t(0)));
+        Block_packed_vector constant;
+        for (int i = 0; i < 300; ++i) {
+            constant.push_back(42);
+        }
+        assert(2 == constant.block_count() && 42 == constant[200] && constant.to_vector() == tasks::Vector<uint32_t>(300, 42));
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+    bool thrown = false;
+    try {
+        Block_packed_vector(tasks::Vector<uint64_t>(1, uint64_t(1) << 32));
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Block_packed_vector encoding and scan test successfully passed!\n";
+}
+
+void test_flat_map()
+{
+    using tasks::Flat_set;
+    using tasks::Flat_map;
+    Flat_set<int> numbers = { 5, 1, 9, 1, 3 };
+    assert(4 == numbers.size() && std::is_sorted(numbers.begin(), numbers.end()));
+    assert(numbers.insert(4).second && !numbers.insert(9).second && *numbers.insert(0).first == 0);
+    assert(numbers.contains(3) && !numbers.contains(2) && 1 == numbers.count(5) && numbers.end() == numbers.find(7));
+    assert(*numbers.lower_bound(6) == 9 && *numbers.upper_bound(4) == 5 && 1 == numbers.erase(4) && 0 == numbers.erase(4));
+    assert(numbers.begin() == numbers.erase(numbers.begin()) && 1 == *numbers.begin());
+
+    std::set<int> expected(numbers.begin(), numbers.end());
+    std::vector<int> batch;
+    for (int round = 0; round < 5; ++round) {
+        batch.clear();
+        for (int i = 0; i < 300; ++i) {
+            batch.push_back(std::rand() % 1000);
+        }
+        numbers.insert_unique(batch.begin(), batch.end());
+        expected.insert(batch.begin(), batch.end());
+        assert(numbers.size() == expected.size() && std::equal(numbers.begin(), numbers.end(), expected.begin()));
+    }
+    numbers.insert_unique(batch.begin(), batch.begin());
+    assert(numbers.size() == expected.size());
+    numbers.clear();
+    assert(numbers.insert(7).second && numbers.insert(2).second && 2 == numbers.size() && 2 == *numbers.begin());
+
+    Flat_set<std::string, std::less<> > names = { "delta", "alpha", "charlie" };
+    assert(names.contains("alpha") && names.find("charlie") == names.begin() + 1 && !names.contains("bravo"));
+    assert(names.lower_bound("b") == names.begin() + 1 && 1 == names.count(std::string("delta")));
+    std::cout << "Flat_set lookup and batch insert test successfully passed!\n";
+
+    Flat_map<std::string, int, std::less<> > ages;
+    ages["bob"] = 31;
+    ages["alice"] = 29;
+    assert(ages.insert(std::make_pair(std::string("carol"), 40)).second);
+    assert(!ages.try_emplace("bob", 99).second && 31 == ages.at("bob"));
+    assert(!ages.insert_or_assign("bob", 32).second && 32 == ages["bob"] && 3 == ages.size());
+    assert(ages.find("alice")->second == 29 && ages.begin()->first == "alice" && ages.find("dave") == ages.end());
+    ages.find("carol")->second = 41;
+    const Flat_map<std::string, int, std::less<> > &const_ages = ages;
+    assert(41 == const_ages.at("carol") && const_ages.contains("carol"));
+    bool thrown = false;
+    try {
+        ages.at("dave");
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown && 1 == ages.erase("alice") && 2 == ages.size());
+
+    Flat_map<int, int> counts;
+    std::map<int, int> expected_counts;
+    std::vector<std::pair<int, int> > pairs;
+    for (int i = 0; i < 2000; ++i) {
+        pairs.push_back(std::make_pair(std::rand() % 500, i));
+    }
+    counts.insert_unique(pairs.begin(), pairs.end());
+    expected_counts.insert(pairs.begin(), pairs.end());
+    assert(counts.size() == expected_counts.size());
+    assert(std::equal(counts.begin(), counts.end(), expected_counts.begin(),
+                      [](const std::pair<int, int> &left, const std::pair<const int, int> &right) {
+                          return left.first == right.first && left.second == right.second;
+                      }));
+    std::cout << "Flat_map access and batch insert test successfully passed!\n";
+}
+
+namespace tasks {
+    /**
+    \brief Calls scalar sqrt and abs unqualified inside namespace tasks,
+     which including vector_expr.hpp must not hide.
+    */
+    double scalar_math(double x, int n)
+    {
+        return sqrt(x) + abs(n);
+    }
+}
+
+/**
+\file 
+\brief Tests element-wise expressions and reductions on each instruction set.
+*/
+void test_vector_expressions()
+{
+    assert(5.0 == tasks::scalar_math(4.0, -3));
+    for (int isa = tasks::simd::scalar_isa; isa <= tasks::simd::detected_isa(); ++isa) {
+        tasks::simd::set_isa(tasks::simd::Isa(isa));
+        for (size_t size : { 0, 1, 15, 16, 37, 1000 }) {
+            Vector<double> b, c, d;
+            for (size_t i = 0; i < size; ++i) {
+                b.push_back(double(i % 17) - 8);
+                c.push_back(double(i % 5) + 1);
+                d.push_back(double(i % 3));
+            }
+            Vector<double> a = b * 2 + c - d;
+            assert(a.size() == size);
+            for (size_t i = 0; i < size; ++i) {
+                assert(a[i] == b[i] * 2 + c[i] - d[i]);
+            }
+            const double *a_ptr = a.data();
+            a = 1 - a / c + -d;
+            assert(a.data() == a_ptr);
+            for (size_t i = 0; i < size; ++i) {
+                assert(a[i] == 1 - (b[i] * 2 + c[i] - d[i]) / c[i] - d[i]);
+            }
+            a = tasks::expr::max(tasks::expr::min(b, c), -1.5) + tasks::expr::abs(b) * tasks::expr::sqrt(c * c);
+            for (size_t i = 0; i < size; ++i) {
+                assert(a[i] == std::max(std::min(b[i], c[i]), -1.5) + std::abs(b[i]) * c[i]);
+            }
+
+            double expected = 0;
+            for (size_t i = 0; i < size; ++i) {
+                expected += b[i] * c[i];
+            }
+            assert(tasks::expr::dot(b, c) == expected && sum(b * c) == expected);
+            if (size) {
+                double largest = c[0] * d[0];
+                for (size_t i = 1; i < size; ++i) {
+                    largest = std::max(largest, c[i] * d[i]);
+                }
+                assert(tasks::expr::min_value(b + 0.5) == *std::min_element(b.begin(), b.end()) + 0.5);
+                assert(tasks::expr::max_value(c * d) == largest);
+            }
+        }
+
+        Vector<int> x, y;
+        for (int i = 0; i < 100; ++i) {
+            x.push_back(i - 50);
+            y.push_back(i % 7 + 1);
+        }
+        Vector<int> z(3, 0);
+        z = tasks::expr::abs(x) / y - 3;
+        assert(100 == z.size() && z[0] == 50 / 1 - 3 && z[99] == 49 / 2 - 3);
+        assert(tasks::expr::sum(x * 2) == -100 && tasks::expr::dot(x, x) == 83350 && -50 == tasks::expr::min_value(tasks::expr::min(x, y)));
+    }
+    tasks::simd::set_isa(tasks::simd::detected_isa());
+    std::cout << "Fused expressions on every instruction set test successfully passed!\n";
+
+    Vector<double> left(4, 1.0), right(5, 2.0);
+    bool thrown = false;
+    try {
+        Vector<double> result = left + right;
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        tasks::expr::max_value(left - left + Vector<double>());
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Expression size mismatch test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests sharing, copy on first mutation and concurrent snapshots of Cow_vector.
+*/
+void test_cow_vector()
+{
+    using tasks::Cow_vector;
+    Cow_vector<int> empty;
+    assert(empty.empty() && 0 == empty.use_count() && empty.begin() == empty.end());
+
+    Cow_vector<int> original;
+    for (int i = 0; i < 100; ++i) {
+        original.push_back(i);
+    }
+    auto address = [](const Cow_vector<int> &vec) { return vec.data(); };
+    const int *shared_ptr = address(original);
+    Cow_vector<int> copy(original);
+    Cow_vector<int> snapshot = original.snapshot();
+    assert(3 == original.use_count() && address(copy) == shared_ptr && snapshot == original);
+
+    copy[5] = -5;
+    assert(address(copy) != shared_ptr && 1 == copy.use_count() && 2 == original.use_count());
+    assert(-5 == copy[5] && 5 == original.items()[5] && copy != original);
+    int *own_ptr = copy.data();
+    copy.push_back(100);
+    copy[0] = -1;
+    assert(copy.data() == own_ptr || copy.capacity() > 100);
+
+    original.insert(original.cbegin() + 1, 42);
+    original.erase(original.cbegin() + 50, original.cbegin() + 60);
+    assert(91 == original.size() && 42 == original.items()[1] && 1 == original.use_count());
+    assert(100 == snapshot.size() && address(snapshot) == shared_ptr && 59 == snapshot.items()[59]);
+
+    Cow_vector<int> moved(std::move(snapshot));
+    assert(snapshot.empty() && 0 == snapshot.use_count() && 1 == moved.use_count() && address(moved) == shared_ptr);
+    snapshot = moved;
+    snapshot.clear();
+    assert(snapshot.empty() && 1 == moved.use_count() && 100 == moved.size());
+    moved.clear();
+    assert(moved.empty() && 1 == moved.use_count());
+    std::cout << "Cow_vector sharing and copy on write test successfully passed!\n";
+
+    Cow_vector<int> leaked(3, 1);
+    int &first = leaked[0];
+    Cow_vector<int> leaked_snapshot = leaked.snapshot();
+    Cow_vector<int> leaked_copy(leaked);
+    Cow_vector<int> leaked_assigned;
+    leaked_assigned = leaked;
+    first = 9;
+    assert(1 == leaked.use_count() && 1 == leaked_snapshot.use_count() && 9 == leaked.items()[0]);
+    assert(1 == leaked_snapshot.items()[0] && 1 == leaked_copy.items()[0] && 1 == leaked_assigned.items()[0]);
+    leaked.clear();
+    leaked.push_back(2);
+    leaked_copy = leaked;
+    assert(2 == leaked.use_count() && address(leaked_copy) == address(leaked));
+    std::cout << "Cow_vector unshareable after mutable access test successfully passed!\n";
+
+    {
+        Cow_vector<Counted> counted(10, Counted(3));
+        Cow_vector<Counted> other = counted;
+        assert(10 == Counted::alive);
+        other.pop_back();
+        assert(19 == Counted::alive && 10 == counted.size() && 9 == other.size());
+    }
+    assert(0 == Counted::alive);
+
+    Cow_vector<std::string> config(1000, std::string("setting"));
+    Vector<std::thread> readers;
+    std::atomic<size_t> total(0);
+    for (int t = 0; t < 4; ++t) {
+        readers.push_back(std::thread([&config, &total] {
+            for (int round = 0; round < 200; ++round) {
+                Cow_vector<std::string> view = config;
+                total.fetch_add(view.items().back().size(), std::memory_order_relaxed);
+            }
+        }));
+    }
+    Cow_vector<std::string> writer = config;
+    for (int round = 0; round < 200; ++round) {
+        writer[round] = "changed";
+    }
+    for (size_t t = 0; t < readers.size(); ++t) {
+        readers[t].join();
+    }
+    assert(4 * 200 * 7 == total && 1 == config.use_count() && "setting" == config.items()[0] && "changed" == writer[0]);
+    std::cout << "Cow_vector concurrent snapshots test successfully passed!\n";
+}
+
+/**
+\file 
+\brief Tests double-ended operations, iterators and linearize of Ring_vector.
+*/
+void test_ring_vector()
+{
+    using tasks::Ring_vector;
+    Ring_vector<int> ring;
+    std::deque<int> expected;
+    for (int step = 0; step < 20000; ++step) {
+        int action = std::rand() % 6;
+        if (action < 2) {
+            ring.push_back(step);
+            expected.push_back(step);
+        } else if (action < 4) {
+            ring.push_front(step);
+            expected.push_front(step);
+        } else if (action == 4 && !expected.empty()) {
+            ring.pop_front();
+            expected.pop_front();
+        } else if (!expected.empty()) {
+            ring.pop_back();
+            expected.pop_back();
+        }
+        assert(ring.size() == expected.size());
+    }
+    assert(std::equal(ring.begin(), ring.end(), expected.begin(), expected.end()));
+    assert(std::equal(ring.rbegin(), ring.rend(), expected.rbegin()));
+    assert(0 == (ring.capacity() & (ring.capacity() - 1)) && ring.capacity() >= ring.size());
+    std::cout << "Ring_vector push and pop at both ends test successfully passed!\n";
+
+    Ring_vector<int> window;
+    for (int i = 0; i < 6; ++i) {
+        window.push_back(i);
+    }
+    for (int i = 6; i < 100; ++i) {
+        window.pop_front();
+        window.push_back(i);
+    }
+    assert(8 == window.capacity() && 94 == window.front() && 99 == window.back() && 97 == window[3]);
+    Ring_vector<int> copy(window);
+    assert(copy == window && 6 == copy.size());
+    window.push_front(window.back());
+    window.push_back(window.front());
+    window.push_front(window.front());
+    assert(9 == window.size() && 16 == window.capacity() && 99 == window.front() && 99 == window.back());
+    assert(copy != window && 94 == window[2] && 95 == window[3]);
+    std::sort(window.begin(), window.end());
+    assert(std::is_sorted(window.begin(), window.end()) && 94 == window.front());
+    assert(window.end() - window.begin() == 9 && window.begin()[2] == 96);
+    Ring_vector<int>::const_iterator first = copy.begin();
+    assert(*(first + 5) == 99 && *(5 + first) == 99 && first < copy.end());
+    static_assert(std::is_same<std::iterator_traits<Ring_vector<int>::const_iterator>::pointer, const int *>::value,
+                  "constant iterator points to constant elements");
+    assert(copy.end() - first == 6 && first == copy.begin() && copy.begin() == first && copy.begin()[1] == first[1]);
+
+    tasks::Vector<int> flat = copy.linearize();
+    assert(6 == flat.size() && 94 == flat[0] && 99 == flat[5] && 6 == copy.size());
+    Ring_vector<std::string> words;
+    for (int i = 0; i < 12; ++i) {
+        words.push_front(std::string(20, char('a' + i)));
+    }
+    tasks::Vector<std::string> moved = std::move(words).linearize();
+    assert(12 == moved.size() && moved[0][0] == 'l' && moved[11][0] == 'a' && words.empty());
+    bool thrown = false;
+    try {
+        copy.at(6);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Ring_vector iterators and linearize test successfully passed!\n";
+
+    {
+        Ring_vector<Counted> counted(5, Counted(1));
+        for (int i = 0; i < 50; ++i) {
+            counted.push_front(Counted(i));
+            counted.pop_back();
+            counted.push_back(Counted(i));
+        }
+        assert(55 == counted.size() && 55 == Counted::alive);
+        Ring_vector<Counted> other = counted;
+        other.clear();
+        assert(55 == Counted::alive && other.empty());
+    }
+    assert(0 == Counted::alive);
+    std::cout << "Ring_vector element lifetime test successfully passed!\n";
 }
 
 /**
@@ -138,8 +1814,11 @@ void test_element_access(const std::string* arr, unsigned arr_size)
               << "Uncomment the line 130 in code file to test it.\n";
     //const_str_vector[0] = "aaaa"; 
     std::cout << "\nAccessing element by index which is out of range does not raise exception.\n"
-              << "const_str_vector[const_str_vector.size()]: " 
-              << const_str_vector[const_str_vector.size()] << std::endl;
+              << "Slots past the size hold no object, so only the address is taken.\n"
+              << "&const_str_vector[const_str_vector.size()] == &*const_str_vector.end(): " 
+              << std::boolalpha 
+              << (&const_str_vector[const_str_vector.size()] == &*const_str_vector.end()) 
+              << std::noboolalpha << std::endl;
     std::cout << "\nIterating through str_vector, changing the elements using 'at' function.\n"; 
 
     for (int i = 0, size = str_vector.size(); i < size; ++i) {
@@ -313,6 +1992,70 @@ void test_vector()
     std::cout << "\n________________Testing compatibility with stl algorithms_________________\n";
     test_stl_algorithms_compatibility();
 
+    std::cout << "\n_____________________Testing lifetime of elements________________________\n";
+    test_element_lifetime();
+    test_trivial_relocation();
+
+    std::cout << "\n________________________Testing move semantics____________________________\n";
+    test_move_semantics();
+
+    std::cout << "\n__________________________Testing allocators______________________________\n";
+    test_allocators();
+
+    std::cout << "\n_______________________Testing growth policies____________________________\n";
+    test_growth_policies();
+
+    std::cout << "\n_______________________Testing bulk operations____________________________\n";
+    test_bulk_operations();
+
+    std::cout << "\n_________________________Testing Small_vector_____________________________\n";
+    test_small_vector();
+
+    std::cout << "\n__________________________Testing statistics______________________________\n";
+    test_statistics();
+
+    std::cout << "\n_________________________Testing SIMD kernels_____________________________\n";
+    test_simd_kernels();
+
+    std::cout << "\n_________________________Testing Mmap_vector______________________________\n";
+    test_mmap_vector();
+
+    std::cout << "\n_______________________Testing binary serialization_______________________\n";
+    test_serialization();
+
+    std::cout << "\n_______________________Testing parallel algorithms_________________________\n";
+    test_parallel_algorithms();
+
+    std::cout << "\n______________________Testing work-stealing scheduler_______________________\n";
+    test_work_stealing();
+
+    std::cout << "\n_______________________Testing concurrent vector__________________________\n";
+    test_concurrent_vector();
+
+    std::cout << "\n_______________________Testing segmented vector___________________________\n";
+    test_segmented_vector();
+
+    std::cout << "\n__________________________Testing SoA vector______________________________\n";
+    test_soa_vector();
+
+    std::cout << "\n__________________________Testing bit vector______________________________\n";
+    test_bit_vector();
+
+    std::cout << "\n________________________Testing packed vector_____________________________\n";
+    test_packed_vector();
+
+    std::cout << "\n__________________________Testing flat map________________________________\n";
+    test_flat_map();
+
+    std::cout << "\n_______________________Testing vector expressions_________________________\n";
+    test_vector_expressions();
+
+    std::cout << "\n__________________________Testing COW vector______________________________\n";
+    test_cow_vector();
+
+    std::cout << "\n__________________________Testing ring vector_____________________________\n";
+    test_ring_vector();
+
     std::cout << "\n________________________Testing constructors__________________________\n";
     int size;
     int *arr = input_arr(&size);
@@ -0,0 +1,102 @@
+/**
+\file
+\brief File contains search and reduction functions for Vector. Vectors of int, float,
+ double and uint8_t use the SIMD kernels of simd_kernels.hpp, other types a scalar loop.
+*/
+
+#ifndef _VECTOR_ALGORITHMS_HPP_
+#define _VECTOR_ALGORITHMS_HPP_
+
+#include <stdexcept>
+
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+
+namespace tasks {
+
+    /**
+    \brief Finds the first element equal to value.
+    \param vec Vector to search in.
+    \param value Value to search for.
+    \return Iterator to the element, end() if not found.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::iterator find(Vector<T, Allocator, Growth> &vec, const T &value)
+    {
+        typename Vector<T, Allocator, Growth>::iterator iter = vec.begin();
+
+        if (!vec.empty()) {
+            iter += simd::find(&vec[0], vec.size(), value);
+        }
+        return iter;
+    }
+
+    /**
+    \brief Finds the first element equal to value.
+    \param vec Vector to search in.
+    \param value Value to search for.
+    \return Iterator to the element, end() if not found.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename Vector<T, Allocator, Growth>::const_iterator find(const Vector<T, Allocator, Growth> &vec,
+                                                               const T &value)
+    {
+        typename Vector<T, Allocator, Growth>::const_iterator iter = vec.begin();
+
+        if (!vec.empty()) {
+            iter += simd::find(&vec[0], vec.size(), value);
+        }
+        return iter;
+    }
+
+    /**
+    \brief Counts elements equal to value.
+    \param vec Vector to search in.
+    \param value Value to count.
+    \return Number of equal elements.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    size_t count(const Vector<T, Allocator, Growth> &vec, const T &value)
+    {
+        return vec.empty() ? 0 : simd::count(&vec[0], vec.size(), value);
+    }
+
+    /**
+    \brief Returns the smallest element. Throws std::out_of_range if vector is empty.
+    \param vec Vector to search in.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    T min_value(const Vector<T, Allocator, Growth> &vec)
+    {
+        if (vec.empty()) {
+            throw std::out_of_range("Vector is empty.");
+        }
+        return simd::min_value(&vec[0], vec.size());
+    }
+
+    /**
+    \brief Returns the largest element. Throws std::out_of_range if vector is empty.
+    \param vec Vector to search in.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    T max_value(const Vector<T, Allocator, Growth> &vec)
+    {
+        if (vec.empty()) {
+            throw std::out_of_range("Vector is empty.");
+        }
+        return simd::max_value(&vec[0], vec.size());
+    }
+
+    /**
+    \brief Sums the elements, ints are summed in long long and uint8_t in unsigned long long.
+    \param vec Vector to sum.
+    \return Sum of elements, zero for empty vector.
+    */
+    template <typename T, typename Allocator, typename Growth>
+    typename simd::Sum<T>::type sum(const Vector<T, Allocator, Growth> &vec)
+    {
+        return vec.empty() ? typename simd::Sum<T>::type() : simd::sum(&vec[0], vec.size());
+    }
+}
+
+#endif
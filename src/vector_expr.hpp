@@ -0,0 +1,409 @@
+/**
+\file
+\brief File contains the opt-in numeric layer of Vector: element-wise expressions.
+ With this header included, + - * / on Vectors of arithmetic type, scalars broadcast
+ to every element, abs, sqrt, min and max build an expression object instead of a
+ temporary vector. Assigning the expression to a Vector, or constructing one from it,
+ evaluates all operations in one fused pass without intermediate allocations, and
+ sum, min_value, max_value and dot reduce an expression in one pass as well.
+
+ \code
+ tasks::Vector<double> a(n), b(n), c(n), d(n);
+ a = b * 2.0 + c - d;
+ a = tasks::expr::max(a, 0.0);
+ double total = tasks::expr::dot(a, b);
+ \endcode
+
+ The operators are brought into namespace tasks so they apply to Vectors. The named
+ functions stay in tasks::expr, where they do not hide std::sqrt, std::abs or std::min
+ from unqualified calls on scalars in namespace tasks. Call them qualified with
+ tasks::expr, argument dependent lookup finds them unqualified only for expression
+ arguments such as sum(b * c).
+
+ Expressions refer to the elements of their operands and are meant to be consumed in
+ the statement that builds them, keeping one past the lifetime of an operand or past a
+ reallocation of it leaves it dangling. All operands must have the same size and element
+ type, else std::invalid_argument is thrown. Operations are applied per element, so a
+ vector may appear on both sides of an assignment.
+
+ Evaluation runs a scalar, SSE2 or AVX2 build of the same blocked loop, selected by
+ simd::isa(). std::sqrt sets errno and stays scalar unless built with -fno-math-errno,
+ floating point sums may differ from sequential summation in rounding.
+*/
+
+#ifndef _VECTOR_EXPR_HPP_
+#define _VECTOR_EXPR_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "smart_array.hpp"
+#include "simd_kernels.hpp"
+
+namespace tasks {
+namespace expr {
+
+    ///Number of elements evaluated together by the SIMD kernels.
+    const size_t block_size = 16;
+
+    ///Element-wise addition.
+    struct Plus { template <typename T> static T apply(T a, T b) { return a + b; } };
+    ///Element-wise subtraction.
+    struct Minus { template <typename T> static T apply(T a, T b) { return a - b; } };
+    ///Element-wise multiplication.
+    struct Multiplies { template <typename T> static T apply(T a, T b) { return a * b; } };
+    ///Element-wise division.
+    struct Divides { template <typename T> static T apply(T a, T b) { return a / b; } };
+    ///Element-wise minimum, the left one of equal elements.
+    struct Min_op { template <typename T> static T apply(T a, T b) { return b < a ? b : a; } };
+    ///Element-wise maximum, the left one of equal elements.
+    struct Max_op { template <typename T> static T apply(T a, T b) { return a < b ? b : a; } };
+    ///Element-wise negation.
+    struct Negate { template <typename T> static T apply(T a) { return -a; } };
+
+    ///Element-wise absolute value.
+    struct Abs
+    {
+        static float apply(float a) { return std::fabs(a); }
+        static double apply(double a) { return std::fabs(a); }
+        template <typename T>
+        static T apply(T a) { return a < T() ? T(-a) : a; }
+    };
+
+    ///Element-wise square root.
+    struct Sqrt { template <typename T> static T apply(T a) { return T(std::sqrt(a)); } };
+
+    namespace scalar {
+
+        ///Writes the elements of an expression one by one.
+        template <typename Expr>
+        void evaluate(typename Expr::value_type *out_ptr, const Expr &expr, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i) {
+                out_ptr[i] = expr[i];
+            }
+        }
+
+        ///Sums the elements of an expression sequentially.
+        template <typename Expr>
+        typename simd::Sum<typename Expr::value_type>::type sum(const Expr &expr, size_t n)
+        {
+            typename simd::Sum<typename Expr::value_type>::type total = 0;
+
+            for (size_t i = 0; i < n; ++i) {
+                total += expr[i];
+            }
+            return total;
+        }
+
+        ///Reduces the nonempty expression sequentially with Pick.
+        template <typename Pick, typename Expr>
+        typename Expr::value_type reduce(const Expr &expr, size_t n)
+        {
+            typename Expr::value_type best = expr[0];
+
+            for (size_t i = 1; i < n; ++i) {
+                best = Pick::apply(best, expr[i]);
+            }
+            return best;
+        }
+    }
+
+#ifdef SMART_ARRAY_X86_SIMD
+    namespace sse2 {
+#include "vector_expr_bodies.hpp"
+    }
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+    namespace avx2 {
+#include "vector_expr_bodies.hpp"
+    }
+#pragma GCC pop_options
+#endif
+
+    /**
+    \brief Kernels of one instruction set for expression type Expr.
+    */
+    template <typename Expr>
+    struct Kernel_table
+    {
+        typedef typename Expr::value_type T;
+
+        void (*evaluate)(T *, const Expr &, size_t);
+        typename simd::Sum<T>::type (*sum)(const Expr &, size_t);
+        T (*min_value)(const Expr &, size_t);
+        T (*max_value)(const Expr &, size_t);
+    };
+
+    ///Returns the kernels of the active instruction set for Expr.
+    template <typename Expr>
+    const Kernel_table<Expr> &kernels()
+    {
+        static const Kernel_table<Expr> tables[] = {
+            { &scalar::evaluate<Expr>, &scalar::sum<Expr>,
+              &scalar::reduce<Min_op, Expr>, &scalar::reduce<Max_op, Expr> },
+#ifdef SMART_ARRAY_X86_SIMD
+            { &sse2::evaluate<Expr>, &sse2::sum<Expr>, &sse2::reduce<Min_op, Expr>, &sse2::reduce<Max_op, Expr> },
+            { &avx2::evaluate<Expr>, &avx2::sum<Expr>, &avx2::reduce<Min_op, Expr>, &avx2::reduce<Max_op, Expr> }
+#endif
+        };
+        return tables[simd::isa()];
+    }
+
+    /**
+    \brief Base of expression nodes. Derived is the node class, T its element type.
+     The is_vector_expression tag lets Vector construct and assign from the node.
+    */
+    template <typename Derived, typename T>
+    class Expression
+    {
+    public:
+        typedef T value_type;
+        typedef void is_vector_expression;
+
+        ///Writes all elements to out_ptr, an array of size() elements.
+        void evaluate(T *out_ptr) const
+        {
+            const Derived &self = static_cast<const Derived &>(*this);
+
+            kernels<Derived>().evaluate(out_ptr, self, self.size());
+        }
+    };
+
+    /**
+    \brief Operand referring to the elements of a vector.
+    */
+    template <typename T>
+    class Leaf
+    {
+    public:
+        typedef T value_type;
+
+        Leaf(const T *ptr, size_t size) : m_ptr(ptr), m_size(size) { }
+
+        T operator[](size_t i) const { return m_ptr[i]; }
+        size_t size() const { return m_size; }
+
+    private:
+        const T *m_ptr;
+        size_t m_size;
+    };
+
+    /**
+    \brief Operand broadcasting one value to every element, has no size of its own.
+    */
+    template <typename T>
+    class Scalar
+    {
+    public:
+        typedef T value_type;
+
+        explicit Scalar(const T &value) : m_value(value) { }
+
+        T operator[](size_t) const { return m_value; }
+
+    private:
+        T m_value;
+    };
+
+    ///Returns the common size of two operands, throws std::invalid_argument if they differ.
+    template <typename L, typename R>
+    size_t common_size(const L &left, const R &right)
+    {
+        if (left.size() != right.size()) {
+            throw std::invalid_argument("Vector sizes differ.");
+        }
+        return left.size();
+    }
+
+    ///Returns the size of left operand, right one is broadcast.
+    template <typename L, typename T>
+    size_t common_size(const L &left, const Scalar<T> &)
+    {
+        return left.size();
+    }
+
+    ///Returns the size of right operand, left one is broadcast.
+    template <typename T, typename R>
+    size_t common_size(const Scalar<T> &, const R &right)
+    {
+        return right.size();
+    }
+
+    /**
+    \brief Node applying Op to the elements of one operand.
+    */
+    template <typename Op, typename E>
+    class Unary : public Expression<Unary<Op, E>, typename E::value_type>
+    {
+    public:
+        explicit Unary(const E &operand) : m_operand(operand) { }
+
+        typename E::value_type operator[](size_t i) const { return Op::apply(m_operand[i]); }
+        size_t size() const { return m_operand.size(); }
+
+    private:
+        E m_operand;
+    };
+
+    /**
+    \brief Node applying Op to the elements of two operands at equal positions.
+    */
+    template <typename Op, typename L, typename R>
+    class Binary : public Expression<Binary<Op, L, R>, typename L::value_type>
+    {
+        static_assert(std::is_same<typename L::value_type, typename R::value_type>::value,
+                      "Operands of a vector expression must have the same element type.");
+
+    public:
+        Binary(const L &left, const R &right) : m_left(left), m_right(right), m_size(common_size(left, right)) { }
+
+        typename L::value_type operator[](size_t i) const { return Op::apply(m_left[i], m_right[i]); }
+        size_t size() const { return m_size; }
+
+    private:
+        L m_left;
+        R m_right;
+        size_t m_size;
+    };
+
+    /**
+    \brief Maps the type of an argument to the operand stored in expressions.
+     Defined for Vectors of arithmetic type and for expressions, other types
+     have no nested type, which removes the operators from overload resolution.
+    */
+    template <typename X, typename = void>
+    struct Operand { };
+
+    template <typename T, typename Allocator, typename Growth>
+    struct Operand<Vector<T, Allocator, Growth>, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+        typedef Leaf<T> type;
+
+        static type make(const Vector<T, Allocator, Growth> &vec) { return type(vec.data(), vec.size()); }
+    };
+
+    template <typename E>
+    struct Operand<E, typename E::is_vector_expression>
+    {
+        typedef E type;
+
+        static const type &make(const E &expr) { return expr; }
+    };
+
+/**
+\brief Defines function name applying Op to two operands, or to an operand
+ and a scalar broadcast to every element.
+*/
+#define SMART_ARRAY_EXPR_BINARY(name, Op) \
+    template <typename L, typename R> \
+    Binary<Op, typename Operand<L>::type, typename Operand<R>::type> name(const L &left, const R &right) \
+    { \
+        return Binary<Op, typename Operand<L>::type, typename Operand<R>::type>(Operand<L>::make(left), \
+                                                                              Operand<R>::make(right)); \
+    } \
+    template <typename L> \
+    Binary<Op, typename Operand<L>::type, Scalar<typename Operand<L>::type::value_type> > \
+    name(const L &left, const typename Operand<L>::type::value_type &right) \
+    { \
+        typedef Scalar<typename Operand<L>::type::value_type> S; \
+        return Binary<Op, typename Operand<L>::type, S>(Operand<L>::make(left), S(right)); \
+    } \
+    template <typename R> \
+    Binary<Op, Scalar<typename Operand<R>::type::value_type>, typename Operand<R>::type> \
+    name(const typename Operand<R>::type::value_type &left, const R &right) \
+    { \
+        typedef Scalar<typename Operand<R>::type::value_type> S; \
+        return Binary<Op, S, typename Operand<R>::type>(S(left), Operand<R>::make(right)); \
+    }
+
+    SMART_ARRAY_EXPR_BINARY(operator+, Plus)
+    SMART_ARRAY_EXPR_BINARY(operator-, Minus)
+    SMART_ARRAY_EXPR_BINARY(operator*, Multiplies)
+    SMART_ARRAY_EXPR_BINARY(operator/, Divides)
+    SMART_ARRAY_EXPR_BINARY(min, Min_op)
+    SMART_ARRAY_EXPR_BINARY(max, Max_op)
+
+#undef SMART_ARRAY_EXPR_BINARY
+
+    ///Returns the element-wise negation of an operand.
+    template <typename E>
+    Unary<Negate, typename Operand<E>::type> operator-(const E &operand)
+    {
+        return Unary<Negate, typename Operand<E>::type>(Operand<E>::make(operand));
+    }
+
+    ///Returns the element-wise absolute value of an operand.
+    template <typename E>
+    Unary<Abs, typename Operand<E>::type> abs(const E &operand)
+    {
+        return Unary<Abs, typename Operand<E>::type>(Operand<E>::make(operand));
+    }
+
+    ///Returns the element-wise square root of an operand.
+    template <typename E>
+    Unary<Sqrt, typename Operand<E>::type> sqrt(const E &operand)
+    {
+        return Unary<Sqrt, typename Operand<E>::type>(Operand<E>::make(operand));
+    }
+
+    /**
+    \brief Sums the elements of an expression in one pass.
+    \param expr Expression.
+    \return Sum, of type long long for int elements.
+    */
+    template <typename E, typename = typename E::is_vector_expression>
+    typename simd::Sum<typename E::value_type>::type sum(const E &expr)
+    {
+        return kernels<E>().sum(expr, expr.size());
+    }
+
+    /**
+    \brief Returns the smallest element of an expression.
+     Throws std::out_of_range if the expression is empty.
+    \param expr Expression.
+    */
+    template <typename E, typename = typename E::is_vector_expression>
+    typename E::value_type min_value(const E &expr)
+    {
+        if (!expr.size()) {
+            throw std::out_of_range("Vector is empty.");
+        }
+        return kernels<E>().min_value(expr, expr.size());
+    }
+
+    /**
+    \brief Returns the largest element of an expression.
+     Throws std::out_of_range if the expression is empty.
+    \param expr Expression.
+    */
+    template <typename E, typename = typename E::is_vector_expression>
+    typename E::value_type max_value(const E &expr)
+    {
+        if (!expr.size()) {
+            throw std::out_of_range("Vector is empty.");
+        }
+        return kernels<E>().max_value(expr, expr.size());
+    }
+
+    /**
+    \brief Returns the sum of products of elements at equal positions.
+    \param left, right Vectors or expressions of equal size.
+    */
+    template <typename L, typename R>
+    typename simd::Sum<typename Operand<L>::type::value_type>::type dot(const L &left, const R &right)
+    {
+        return expr::sum(left * right);
+    }
+}
+
+    using expr::operator+;
+    using expr::operator-;
+    using expr::operator*;
+    using expr::operator/;
+}
+
+#endif
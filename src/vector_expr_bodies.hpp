@@ -0,0 +1,98 @@
+/**
+\file
+\brief Blocked evaluation kernels of vector_expr.hpp.
+ Deliberately without include guard: vector_expr.hpp includes this file once per
+ instruction set inside its namespace, so every copy is compiled for that target.
+
+ An expression is evaluated block_size elements at a time into a local array first,
+ the store of the block cannot alias the operands, so the compiler vectorizes the
+ fused loop without runtime overlap checks.
+*/
+
+    /**
+    \brief Writes the elements of an expression.
+    \param out_ptr Array of n elements, may be an operand of the expression.
+    \param expr Expression of n elements.
+    \param n Number of elements.
+    */
+    template <typename Expr>
+    void evaluate(typename Expr::value_type *out_ptr, const Expr &expr, size_t n)
+    {
+        typedef typename Expr::value_type T;
+        size_t i = 0;
+
+        for (; i + block_size <= n; i += block_size) {
+            T block[block_size];
+
+            for (size_t j = 0; j < block_size; ++j) {
+                block[j] = expr[i + j];
+            }
+            for (size_t j = 0; j < block_size; ++j) {
+                out_ptr[i + j] = block[j];
+            }
+        }
+        for (; i < n; ++i) {
+            out_ptr[i] = expr[i];
+        }
+    }
+
+    /**
+    \brief Sums the elements of an expression in block_size partial sums.
+    \param expr Expression of n elements.
+    \param n Number of elements.
+    */
+    template <typename Expr>
+    typename simd::Sum<typename Expr::value_type>::type sum(const Expr &expr, size_t n)
+    {
+        typedef typename simd::Sum<typename Expr::value_type>::type S;
+        S partial[block_size] = { };
+        size_t i = 0;
+
+        for (; i + block_size <= n; i += block_size) {
+            for (size_t j = 0; j < block_size; ++j) {
+                partial[j] += expr[i + j];
+            }
+        }
+        for (size_t j = 0; i < n; ++i, ++j) {
+            partial[j] += expr[i];
+        }
+        for (size_t width = block_size / 2; width; width /= 2) {
+            for (size_t j = 0; j < width; ++j) {
+                partial[j] += partial[j + width];
+            }
+        }
+        return partial[0];
+    }
+
+    /**
+    \brief Reduces the elements of an expression with Pick, Min_op or Max_op.
+    \param expr Expression of n elements, n is not 0.
+    \param n Number of elements.
+    */
+    template <typename Pick, typename Expr>
+    typename Expr::value_type reduce(const Expr &expr, size_t n)
+    {
+        typedef typename Expr::value_type T;
+        T best = expr[0];
+        size_t i = 0;
+
+        if (n >= block_size) {
+            T partial[block_size];
+
+            for (size_t j = 0; j < block_size; ++j) {
+                partial[j] = expr[j];
+            }
+            for (i = block_size; i + block_size <= n; i += block_size) {
+                for (size_t j = 0; j < block_size; ++j) {
+                    partial[j] = Pick::apply(partial[j], expr[i + j]);
+                }
+            }
+            for (size_t j = 0; j < block_size; ++j) {
+                best = Pick::apply(best, partial[j]);
+            }
+        }
+        for (; i < n; ++i) {
+            best = Pick::apply(best, expr[i]);
+        }
+        return best;
+    }
@@ -0,0 +1,279 @@
+/**
+\file
+\brief File contains the binary format used by Vector::save and Vector::load.
+ A file is a header followed by the payload. Trivially copyable elements are stored
+ as raw bytes, other types through a Codec specialization writing each element.
+ Header fields are stored in native byte order, the byte order mark lets a reader
+ on a different platform detect the mismatch.
+
+ | Field        | Size | Contents                                    |
+ |--------------|------|---------------------------------------------|
+ | magic        | 4    | "TVEC"                                      |
+ | version      | 2    | format version, 1                           |
+ | byte order   | 2    | 0x0102 written natively                     |
+ | element size | 4    | sizeof(T)                                   |
+ | flags        | 4    | bit 0 set if payload is written by a Codec  |
+ | count        | 8    | number of elements                          |
+ | payload size | 8    | number of payload bytes                     |
+ | checksum     | 8    | Checksum of the payload                     |
+*/
+
+#ifndef _VECTOR_IO_HPP_
+#define _VECTOR_IO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace tasks {
+
+    /**
+    \brief 64-bit FNV-1a checksum computed over 8-byte words, bytes of an
+     incomplete word wait for the next update. Equal byte sequences give equal
+     checksums however they are split between updates.
+    */
+    class Checksum
+    {
+    public:
+        Checksum() : m_hash(14695981039346656037ULL), m_pending(0) { }
+
+        /**
+        \brief Adds bytes to the checksum.
+        \param data Pointer to the bytes.
+        \param bytes Number of bytes.
+        */
+        void update(const void *data, size_t bytes)
+        {
+            const unsigned char *ptr = static_cast<const unsigned char *>(data);
+
+            while (m_pending && bytes) {
+                m_word[m_pending++] = *ptr++;
+                --bytes;
+                if (sizeof(m_word) == m_pending) {
+                    add_word(m_word);
+                    m_pending = 0;
+                }
+            }
+            for (; bytes >= sizeof(m_word); ptr += sizeof(m_word), bytes -= sizeof(m_word)) {
+                add_word(ptr);
+            }
+            if (bytes) {
+                std::memcpy(m_word + m_pending, ptr, bytes);
+                m_pending += bytes;
+            }
+        }
+
+        ///Returns the checksum of all bytes added so far.
+        uint64_t value() const
+        {
+            uint64_t hash = m_hash;
+
+            for (size_t i = 0; i < m_pending; ++i) {
+                hash = (hash ^ m_word[i]) * 1099511628211ULL;
+            }
+            return hash;
+        }
+
+    private:
+        void add_word(const unsigned char *ptr)
+        {
+            uint64_t word;
+            std::memcpy(&word, ptr, sizeof(word));
+            m_hash = (m_hash ^ word) * 1099511628211ULL;
+        }
+
+        uint64_t m_hash;
+        unsigned char m_word[8];
+        size_t m_pending;
+    };
+
+    /**
+    \brief Output of a Codec. Counts and checksums written bytes,
+     without stream it only counts, which lets save compute the header first.
+    */
+    class Binary_writer
+    {
+    public:
+        explicit Binary_writer(std::ostream *out_ptr) : m_out_ptr(out_ptr), m_bytes(0) { }
+
+        ///Writes given bytes.
+        void write(const void *data, size_t bytes)
+        {
+            m_checksum.update(data, bytes);
+            m_bytes += bytes;
+            if (m_out_ptr) {
+                m_out_ptr->write(static_cast<const char *>(data), bytes);
+            }
+        }
+
+        ///Writes trivially copyable value as raw bytes.
+        template <typename U>
+        void write_value(const U &value) { write(&value, sizeof(U)); }
+
+        uint64_t bytes() const { return m_bytes; }
+        uint64_t checksum() const { return m_checksum.value(); }
+
+    private:
+        std::ostream *m_out_ptr;
+        uint64_t m_bytes;
+        Checksum m_checksum;
+    };
+
+    /**
+    \brief Input of a Codec. Counts and checksums read bytes,
+     throws std::runtime_error if the stream ends or reads past the payload.
+    */
+    class Binary_reader
+    {
+    public:
+        Binary_reader(std::istream &in, uint64_t limit) : m_in(in), m_bytes(0), m_limit(limit) { }
+
+        ///Reads given number of bytes.
+        void read(void *data, size_t bytes)
+        {
+            if (bytes > m_limit - m_bytes) {
+                throw std::runtime_error("Vector data is corrupted: element exceeds payload.");
+            }
+            if (!m_in.read(static_cast<char *>(data), bytes)) {
+                throw std::runtime_error("Vector data is truncated.");
+            }
+            m_checksum.update(data, bytes);
+            m_bytes += bytes;
+        }
+
+        ///Reads trivially copyable value from raw bytes.
+        template <typename U>
+        void read_value(U &value) { read(&value, sizeof(U)); }
+
+        uint64_t bytes() const { return m_bytes; }
+        ///Returns number of payload bytes not read yet.
+        uint64_t remaining() const { return m_limit - m_bytes; }
+        uint64_t checksum() const { return m_checksum.value(); }
+
+    private:
+        std::istream &m_in;
+        uint64_t m_bytes;
+        uint64_t m_limit;
+        Checksum m_checksum;
+    };
+
+    /**
+    \brief Per-element serialization of types that are not trivially copyable.
+     Specializations provide static encode(Binary_writer &, const T &) and
+     decode(Binary_reader &, T &).
+    */
+    template <typename T>
+    struct Codec;
+
+    /**
+    \brief Codec of std::string: 64-bit length followed by the characters.
+    */
+    template <>
+    struct Codec<std::string>
+    {
+        static void encode(Binary_writer &writer, const std::string &value)
+        {
+            writer.write_value(uint64_t(value.size()));
+            writer.write(value.data(), value.size());
+        }
+
+        static void decode(Binary_reader &reader, std::string &value)
+        {
+            uint64_t size;
+            reader.read_value(size);
+            if (size > reader.remaining()) {
+                throw std::runtime_error("Vector data is corrupted: string exceeds payload.");
+            }
+            value.resize(size);
+            reader.read(&value[0], size);
+        }
+    };
+
+    /**
+    \brief Header of saved Vector.
+    */
+    struct Vector_file_header
+    {
+        static const uint16_t current_version = 1;
+        static const uint16_t byte_order_mark = 0x0102;
+        static const uint32_t codec_flag = 1;
+
+        uint16_t version;
+        uint16_t byte_order;
+        uint32_t element_size;
+        uint32_t flags;
+        uint64_t count;
+        uint64_t payload_bytes;
+        uint64_t checksum;
+
+        ///Writes the header field by field.
+        void write(std::ostream &out) const
+        {
+            out.write("TVEC", 4);
+            write_field(out, version);
+            write_field(out, byte_order);
+            write_field(out, element_size);
+            write_field(out, flags);
+            write_field(out, count);
+            write_field(out, payload_bytes);
+            write_field(out, checksum);
+        }
+
+        /**
+        \brief Reads and validates the header. Throws std::runtime_error if the stream
+         does not start with a supported header for elements of given size and kind.
+        \param in Input stream.
+        \param element Expected element size.
+        \param encoded Whether elements are expected to be written by a Codec.
+        */
+        void read(std::istream &in, uint32_t element, bool encoded)
+        {
+            char magic[4];
+
+            if (!in.read(magic, 4) || std::memcmp(magic, "TVEC", 4)) {
+                throw std::runtime_error("Not a saved Vector.");
+            }
+            read_field(in, version);
+            read_field(in, byte_order);
+            read_field(in, element_size);
+            read_field(in, flags);
+            read_field(in, count);
+            read_field(in, payload_bytes);
+            read_field(in, checksum);
+            if (!in) {
+                throw std::runtime_error("Vector header is truncated.");
+            }
+            if (byte_order_mark != byte_order) {
+                throw std::runtime_error("Vector was saved with a different byte order.");
+            }
+            if (current_version != version) {
+                throw std::runtime_error("Unsupported Vector format version.");
+            }
+            if (element != element_size || encoded != bool(flags & codec_flag)) {
+                throw std::runtime_error("Saved Vector has a different element type.");
+            }
+            if (!encoded && (payload_bytes % element_size || payload_bytes / element_size != count)) {
+                throw std::runtime_error("Vector header is corrupted.");
+            }
+        }
+
+    private:
+        template <typename U>
+        static void write_field(std::ostream &out, const U &field)
+        {
+            out.write(reinterpret_cast<const char *>(&field), sizeof(U));
+        }
+
+        template <typename U>
+        static void read_field(std::istream &in, U &field)
+        {
+            in.read(reinterpret_cast<char *>(&field), sizeof(U));
+        }
+    };
+}
+
+#endif
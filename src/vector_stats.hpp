@@ -0,0 +1,274 @@
+/**
+\file
+\brief File contains the optional statistics mode of Vector and Small_vector.
+ Compiled in when SMART_ARRAY_STATS is defined (make STATS=1), otherwise every hook
+ expands to nothing. Counters are grouped by tag: the element type by default, or the
+ name of the innermost Stats_scope of the calling thread. A report of all tags is
+ written to stderr at exit and can be requested with stats::report.
+*/
+
+#ifndef _VECTOR_STATS_HPP_
+#define _VECTOR_STATS_HPP_
+
+#ifdef SMART_ARRAY_STATS
+
+#include <cstddef>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <deque>
+#include <iostream>
+#include <iomanip>
+#include <typeinfo>
+#include <cxxabi.h>
+
+///Evaluates the statement only in statistics mode.
+#define SMART_ARRAY_STAT(statement) statement
+
+namespace tasks {
+namespace stats {
+
+    /**
+    \brief Counters of one tag. Updated with relaxed atomics,
+     so vectors of different threads may share a tag.
+    */
+    struct Record
+    {
+        explicit Record(const std::string &tag_name)
+            : name(tag_name), allocations(0), bytes_allocated(0), growths(0),
+              elements_copied(0), elements_moved(0), peak_capacity(0), slack_bytes(0) { }
+
+        const std::string name;
+        ///Number of buffers allocated.
+        std::atomic<size_t> allocations;
+        ///Total bytes of allocated buffers.
+        std::atomic<size_t> bytes_allocated;
+        ///Number of reallocations caused by growth.
+        std::atomic<size_t> growths;
+        ///Number of elements copy constructed or copy assigned.
+        std::atomic<size_t> elements_copied;
+        ///Number of elements move constructed, move assigned or relocated.
+        std::atomic<size_t> elements_moved;
+        ///Largest capacity allocated, in elements.
+        std::atomic<size_t> peak_capacity;
+        ///Bytes allocated on growth beyond the required size.
+        std::atomic<size_t> slack_bytes;
+    };
+
+    /**
+    \brief Owner of all records. Never destroyed, so vectors destroyed
+     after the exit report can still update their counters.
+    */
+    class Registry
+    {
+    public:
+        static Registry &instance()
+        {
+            static Registry *registry = create();
+            return *registry;
+        }
+
+        /**
+        \brief Returns the record of given tag, creates it on first use.
+        \param name Tag name.
+        \return Record with address stable for the program lifetime.
+        */
+        Record &find(const std::string &name)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (size_t i = 0; i < m_records.size(); ++i) {
+                if (m_records[i].name == name) {
+                    return m_records[i];
+                }
+            }
+            m_records.emplace_back(name);
+            return m_records.back();
+        }
+
+        /**
+        \brief Writes the counters of all tags which allocated or copied anything.
+        \param out Output stream.
+        */
+        void report(std::ostream &out)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            out << "smart_array statistics\n"
+                << std::setw(10) << "allocs" << std::setw(14) << "bytes" << std::setw(10) << "growths"
+                << std::setw(12) << "copied" << std::setw(12) << "moved"
+                << std::setw(12) << "peak cap" << std::setw(14) << "slack bytes" << "  tag\n";
+            for (size_t i = 0; i < m_records.size(); ++i) {
+                const Record &r = m_records[i];
+
+                if (0 == r.allocations && 0 == r.elements_copied && 0 == r.elements_moved) {
+                    continue;
+                }
+                out << std::setw(10) << r.allocations << std::setw(14) << r.bytes_allocated
+                    << std::setw(10) << r.growths << std::setw(12) << r.elements_copied
+                    << std::setw(12) << r.elements_moved << std::setw(12) << r.peak_capacity
+                    << std::setw(14) << r.slack_bytes << "  " << r.name << "\n";
+            }
+            out.flush();
+        }
+
+        ///Sets all counters to zero.
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (size_t i = 0; i < m_records.size(); ++i) {
+                Record &r = m_records[i];
+                r.allocations = 0;
+                r.bytes_allocated = 0;
+                r.growths = 0;
+                r.elements_copied = 0;
+                r.elements_moved = 0;
+                r.peak_capacity = 0;
+                r.slack_bytes = 0;
+            }
+        }
+
+    private:
+        Registry() { }
+
+        static Registry *create()
+        {
+            std::atexit(&report_at_exit);
+            return new Registry;
+        }
+
+        static void report_at_exit() { instance().report(std::cerr); }
+
+        std::mutex m_mutex;
+        std::deque<Record> m_records;
+    };
+
+    ///Record of the innermost Stats_scope of the thread, null outside scopes.
+    inline Record *&current_scope()
+    {
+        thread_local Record *record = 0;
+        return record;
+    }
+
+    /**
+    \brief Returns the readable name of type T.
+    */
+    template <typename T>
+    std::string type_name()
+    {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(typeid(T).name(), 0, 0, &status);
+        std::string name = 0 == status ? demangled : typeid(T).name();
+
+        std::free(demangled);
+        return name;
+    }
+
+    ///Returns the record of element type T.
+    template <typename T>
+    Record &type_record()
+    {
+        static Record &record = Registry::instance().find(type_name<T>());
+        return record;
+    }
+
+    ///Returns the record events of element type T are counted in.
+    template <typename T>
+    Record &record()
+    {
+        Record *scope = current_scope();
+        return scope ? *scope : type_record<T>();
+    }
+
+    /**
+    \brief Counts a buffer allocated for cap elements.
+    */
+    template <typename T>
+    void on_allocate(size_t cap)
+    {
+        Record &r = record<T>();
+        size_t peak = r.peak_capacity.load(std::memory_order_relaxed);
+
+        r.allocations.fetch_add(1, std::memory_order_relaxed);
+        r.bytes_allocated.fetch_add(cap * sizeof(T), std::memory_order_relaxed);
+        while (peak < cap && !r.peak_capacity.compare_exchange_weak(peak, cap, std::memory_order_relaxed)) { }
+    }
+
+    /**
+    \brief Counts a growth to cap elements when required elements must fit.
+    */
+    template <typename T>
+    void on_grow(size_t required, size_t cap)
+    {
+        Record &r = record<T>();
+        r.growths.fetch_add(1, std::memory_order_relaxed);
+        r.slack_bytes.fetch_add((cap - required) * sizeof(T), std::memory_order_relaxed);
+    }
+
+    ///Counts count elements copied.
+    template <typename T>
+    void on_copy(size_t count)
+    {
+        record<T>().elements_copied.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    ///Counts count elements moved.
+    template <typename T>
+    void on_move(size_t count)
+    {
+        record<T>().elements_moved.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    ///Writes the report of all tags.
+    inline void report(std::ostream &out) { Registry::instance().report(out); }
+
+    ///Returns counters of given tag.
+    inline const Record &find(const std::string &tag) { return Registry::instance().find(tag); }
+
+    ///Sets all counters to zero.
+    inline void reset() { Registry::instance().reset(); }
+}
+
+    /**
+    \brief Counts events of vectors used by the current thread under given tag
+     while the object lives, so call sites can be told apart. Scopes nest.
+    */
+    class Stats_scope
+    {
+    public:
+        explicit Stats_scope(const std::string &tag) : m_previous(stats::current_scope())
+        {
+            stats::current_scope() = &stats::Registry::instance().find(tag);
+        }
+
+        ~Stats_scope() { stats::current_scope() = m_previous; }
+
+    private:
+        Stats_scope(const Stats_scope &);
+        Stats_scope &operator=(const Stats_scope &);
+
+        stats::Record *m_previous;
+    };
+}
+
+#else
+
+///Evaluates the statement only in statistics mode.
+#define SMART_ARRAY_STAT(statement)
+
+namespace tasks {
+
+    ///Does nothing outside statistics mode.
+    class Stats_scope
+    {
+    public:
+        template <typename Tag>
+        explicit Stats_scope(const Tag &) { }
+    };
+}
+
+#endif
+
+#endif
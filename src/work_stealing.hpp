@@ -0,0 +1,321 @@
+/**
+\file
+\brief File contains a work-stealing scheduler for parallel loops whose per element
+ cost varies. Every worker owns a Chase-Lev deque of ranges: it splits its range in
+ halves, pushes the upper halves to the bottom of its deque and runs the lower half,
+ idle workers steal the largest pending ranges from the top of other deques.
+ The deque follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+ by Le, Pop, Cohen and Zappa Nardelli.
+*/
+
+#ifndef _WORK_STEALING_HPP_
+#define _WORK_STEALING_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "smart_array.hpp"
+#include "parallel.hpp"
+
+namespace tasks {
+namespace parallel {
+
+    /**
+    \brief Half-open range of loop indices.
+    */
+    struct Index_range
+    {
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+    \brief Chase-Lev deque of range pointers. The owner pushes and takes at the bottom,
+     other threads steal at the top. Full rings are replaced by rings of twice the size,
+     replaced rings are kept until the deque is destroyed as thieves may still read them.
+    */
+    class Chase_lev_deque
+    {
+    public:
+        ///Constructor, capacity is rounded up to a power of two.
+        explicit Chase_lev_deque(size_t capacity = 64) : m_top(0), m_bottom(0)
+        {
+            size_t size = 1;
+            while (size < capacity) {
+                size *= 2;
+            }
+            m_rings.push_back(new Ring(size));
+            m_ring.store(m_rings.back(), std::memory_order_relaxed);
+        }
+
+        ~Chase_lev_deque()
+        {
+            for (size_t i = 0; i < m_rings.size(); ++i) {
+                delete m_rings[i];
+            }
+        }
+
+        ///Pushes range to the bottom, called by the owner only.
+        void push(Index_range *range_ptr)
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            Ring *ring_ptr = m_ring.load(std::memory_order_relaxed);
+
+            if (bottom - top > int64_t(ring_ptr->mask)) {
+                ring_ptr = grow(ring_ptr, top, bottom);
+            }
+            ring_ptr->put(bottom, range_ptr);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        ///Takes the range at the bottom, called by the owner only. Returns null if empty.
+        Index_range *take()
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            Ring *ring_ptr = m_ring.load(std::memory_order_relaxed);
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return 0;
+            }
+            Index_range *range_ptr = ring_ptr->get(bottom);
+            if (top == bottom) {
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed)) {
+                    range_ptr = 0;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return range_ptr;
+        }
+
+        ///Steals the range at the top, returns null if empty or lost a race.
+        Index_range *steal()
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) {
+                return 0;
+            }
+            Index_range *range_ptr = m_ring.load(std::memory_order_acquire)->get(top);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+                return 0;
+            }
+            return range_ptr;
+        }
+
+    private:
+        Chase_lev_deque(const Chase_lev_deque &);
+        Chase_lev_deque &operator=(const Chase_lev_deque &);
+
+        ///Circular array of slots.
+        struct Ring
+        {
+            explicit Ring(size_t size) : mask(size - 1), slots(new std::atomic<Index_range *>[size]) { }
+
+            Index_range *get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+            void put(int64_t i, Index_range *range_ptr) { slots[i & mask].store(range_ptr, std::memory_order_relaxed); }
+
+            size_t mask;
+            std::unique_ptr<std::atomic<Index_range *>[]> slots;
+        };
+
+        ///Copies [top, bottom) into a ring of twice the size and publishes it.
+        Ring *grow(Ring *ring_ptr, int64_t top, int64_t bottom)
+        {
+            Ring *bigger_ptr = new Ring(2 * (ring_ptr->mask + 1));
+
+            for (int64_t i = top; i < bottom; ++i) {
+                bigger_ptr->put(i, ring_ptr->get(i));
+            }
+            m_rings.push_back(bigger_ptr);
+            m_ring.store(bigger_ptr, std::memory_order_release);
+            return bigger_ptr;
+        }
+
+        alignas(cache_line) std::atomic<int64_t> m_top;
+        alignas(cache_line) std::atomic<int64_t> m_bottom;
+        std::atomic<Ring *> m_ring;
+        ///Every ring allocated, the last one is current.
+        Vector<Ring *> m_rings;
+    };
+
+    /**
+    \brief Scheduler running loops over [0, count) on a Thread_pool. Ranges are split
+     recursively down to the grain and balanced by stealing, which suits loops whose
+     iterations differ in cost. The first exception thrown by the loop body is rethrown,
+     iterations not started yet are skipped. Loops started from a pool task run sequentially.
+    */
+    class Work_stealing_scheduler
+    {
+    public:
+        /**
+        \brief Constructor.
+        \param threads Number of threads including the caller, hardware concurrency if 0.
+        */
+        explicit Work_stealing_scheduler(size_t threads = 0)
+            : m_pool(threads), m_workers(new Worker[m_pool.size()]), m_remaining(0), m_failed(false) { }
+
+        ///Returns number of threads running a loop, including the caller.
+        size_t size() const { return m_pool.size(); }
+
+        /**
+        \brief Calls fn(begin, end) for disjoint ranges covering [0, count) and waits for completion.
+        \param count Number of iterations.
+        \param grain Ranges of at most this many iterations are not split further, 1 if 0.
+        \param fn Function taking the bounds of a range.
+        */
+        template <typename Fn>
+        void run(size_t count, size_t grain, Fn fn)
+        {
+            if (!count) {
+                return;
+            }
+            if (Thread_pool::in_task() || inside_loop()) {
+                fn(size_t(0), count);
+                return;
+            }
+            grain = std::max<size_t>(1, grain);
+            std::lock_guard<std::mutex> run_lock(m_run_mutex);
+            for (size_t w = 0; w < size(); ++w) {
+                m_workers[w].ranges.clear();
+            }
+            m_workers[0].ranges.push_back(Index_range{0, count});
+            m_workers[0].deque.push(&m_workers[0].ranges.back());
+            m_remaining.store(count, std::memory_order_release);
+            m_failed.store(false, std::memory_order_relaxed);
+            m_error = std::exception_ptr();
+
+            m_pool.run(size(), [&](size_t w) {
+                inside_loop() = true;
+                work(w, grain, fn);
+                inside_loop() = false;
+            });
+            if (m_error) {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+    private:
+        Work_stealing_scheduler(const Work_stealing_scheduler &);
+        Work_stealing_scheduler &operator=(const Work_stealing_scheduler &);
+
+        ///Flag of threads currently running a loop of some scheduler.
+        static bool &inside_loop()
+        {
+            thread_local bool inside = false;
+            return inside;
+        }
+
+        ///Deque of a worker and storage of the ranges it pushes.
+        struct alignas(cache_line) Worker
+        {
+            Chase_lev_deque deque;
+            ///Ranges pushed during the current loop, std::deque keeps their addresses.
+            std::deque<Index_range> ranges;
+        };
+
+        ///Runs ranges of worker w and steals others until every iteration is done.
+        template <typename Fn>
+        void work(size_t w, size_t grain, Fn &fn)
+        {
+            Worker &self = m_workers[w];
+            uint32_t seed = uint32_t(w) * 2654435761u + 1;
+
+            while (m_remaining.load(std::memory_order_acquire)) {
+                Index_range *range_ptr = self.deque.take();
+                for (size_t i = 1; !range_ptr && i < size(); ++i) {
+                    seed ^= seed << 13;
+                    seed ^= seed >> 17;
+                    seed ^= seed << 5;
+                    size_t victim = (w + 1 + seed % (size() - 1)) % size();
+                    range_ptr = m_workers[victim].deque.steal();
+                }
+                if (!range_ptr) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                execute(self, *range_ptr, grain, fn);
+            }
+        }
+
+        ///Splits range down to the grain pushing upper halves, then runs what is left.
+        template <typename Fn>
+        void execute(Worker &self, Index_range range, size_t grain, Fn &fn)
+        {
+            while (range.end - range.begin > grain) {
+                size_t middle = range.begin + (range.end - range.begin) / 2;
+                self.ranges.push_back(Index_range{middle, range.end});
+                self.deque.push(&self.ranges.back());
+                range.end = middle;
+            }
+            if (!m_failed.load(std::memory_order_relaxed)) {
+                try {
+                    fn(range.begin, range.end);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m_error_mutex);
+                    if (!m_error) {
+                        m_error = std::current_exception();
+                    }
+                    m_failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            m_remaining.fetch_sub(range.end - range.begin, std::memory_order_acq_rel);
+        }
+
+        Thread_pool m_pool;
+        std::unique_ptr<Worker[]> m_workers;
+        ///Number of iterations not finished yet.
+        std::atomic<size_t> m_remaining;
+        std::atomic<bool> m_failed;
+        ///Serializes loops submitted by different threads.
+        std::mutex m_run_mutex;
+        std::mutex m_error_mutex;
+        std::exception_ptr m_error;
+    };
+
+    ///Returns the scheduler shared by parallel_for calls made without one.
+    inline Work_stealing_scheduler &default_scheduler()
+    {
+        static Work_stealing_scheduler scheduler;
+        return scheduler;
+    }
+
+    /**
+    \brief Calls fn for every element of vec, balancing uneven work by stealing.
+    \param vec Vector to process.
+    \param grain Number of elements below which ranges are not split, 1 if 0.
+    \param fn Function taking an element reference.
+    \param scheduler Optional scheduler.
+    */
+    template <typename T, typename Allocator, typename Growth, typename Fn>
+    void parallel_for(Vector<T, Allocator, Growth> &vec, size_t grain, Fn fn,
+                      Work_stealing_scheduler &scheduler = default_scheduler())
+    {
+        if (vec.empty()) {
+            return;
+        }
+        T *first_ptr = &vec[0];
+        scheduler.run(vec.size(), grain, [first_ptr, &fn](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                fn(first_ptr[i]);
+            }
+        });
+    }
+}
+}
+
+#endif